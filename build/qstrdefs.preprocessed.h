@@ -0,0 +1,1342 @@
+# 0 "<stdin>"
+# 0 "<built-in>"
+# 0 "<command-line>"
+# 1 "/usr/include/stdc-predef.h" 1 3 4
+# 0 "<command-line>" 2
+# 1 "<stdin>"
+# 27 "<stdin>"
+# 1 "inc/py/mpconfig.h" 1
+# 45 "inc/py/mpconfig.h"
+# 1 "inc/microbit/mpconfigport.h" 1
+# 1 "/usr/lib/gcc/x86_64-linux-gnu/12/include/stdint.h" 1 3 4
+# 9 "/usr/lib/gcc/x86_64-linux-gnu/12/include/stdint.h" 3 4
+# 1 "/usr/include/stdint.h" 1 3 4
+# 26 "/usr/include/stdint.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/libc-header-start.h" 1 3 4
+# 33 "/usr/include/x86_64-linux-gnu/bits/libc-header-start.h" 3 4
+# 1 "/usr/include/features.h" 1 3 4
+# 392 "/usr/include/features.h" 3 4
+# 1 "/usr/include/features-time64.h" 1 3 4
+# 20 "/usr/include/features-time64.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/wordsize.h" 1 3 4
+# 21 "/usr/include/features-time64.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/timesize.h" 1 3 4
+# 19 "/usr/include/x86_64-linux-gnu/bits/timesize.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/wordsize.h" 1 3 4
+# 20 "/usr/include/x86_64-linux-gnu/bits/timesize.h" 2 3 4
+# 22 "/usr/include/features-time64.h" 2 3 4
+# 393 "/usr/include/features.h" 2 3 4
+# 489 "/usr/include/features.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/sys/cdefs.h" 1 3 4
+# 561 "/usr/include/x86_64-linux-gnu/sys/cdefs.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/wordsize.h" 1 3 4
+# 562 "/usr/include/x86_64-linux-gnu/sys/cdefs.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/long-double.h" 1 3 4
+# 563 "/usr/include/x86_64-linux-gnu/sys/cdefs.h" 2 3 4
+# 490 "/usr/include/features.h" 2 3 4
+# 513 "/usr/include/features.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/gnu/stubs.h" 1 3 4
+# 10 "/usr/include/x86_64-linux-gnu/gnu/stubs.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/gnu/stubs-64.h" 1 3 4
+# 11 "/usr/include/x86_64-linux-gnu/gnu/stubs.h" 2 3 4
+# 514 "/usr/include/features.h" 2 3 4
+# 34 "/usr/include/x86_64-linux-gnu/bits/libc-header-start.h" 2 3 4
+# 27 "/usr/include/stdint.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/types.h" 1 3 4
+# 27 "/usr/include/x86_64-linux-gnu/bits/types.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/wordsize.h" 1 3 4
+# 28 "/usr/include/x86_64-linux-gnu/bits/types.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/timesize.h" 1 3 4
+# 19 "/usr/include/x86_64-linux-gnu/bits/timesize.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/wordsize.h" 1 3 4
+# 20 "/usr/include/x86_64-linux-gnu/bits/timesize.h" 2 3 4
+# 29 "/usr/include/x86_64-linux-gnu/bits/types.h" 2 3 4
+
+
+
+# 31 "/usr/include/x86_64-linux-gnu/bits/types.h" 3 4
+typedef unsigned char __u_char;
+typedef unsigned short int __u_short;
+typedef unsigned int __u_int;
+typedef unsigned long int __u_long;
+
+
+typedef signed char __int8_t;
+typedef unsigned char __uint8_t;
+typedef signed short int __int16_t;
+typedef unsigned short int __uint16_t;
+typedef signed int __int32_t;
+typedef unsigned int __uint32_t;
+
+typedef signed long int __int64_t;
+typedef unsigned long int __uint64_t;
+
+
+
+
+
+
+typedef __int8_t __int_least8_t;
+typedef __uint8_t __uint_least8_t;
+typedef __int16_t __int_least16_t;
+typedef __uint16_t __uint_least16_t;
+typedef __int32_t __int_least32_t;
+typedef __uint32_t __uint_least32_t;
+typedef __int64_t __int_least64_t;
+typedef __uint64_t __uint_least64_t;
+
+
+
+typedef long int __quad_t;
+typedef unsigned long int __u_quad_t;
+
+
+
+
+
+
+
+typedef long int __intmax_t;
+typedef unsigned long int __uintmax_t;
+# 141 "/usr/include/x86_64-linux-gnu/bits/types.h" 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/typesizes.h" 1 3 4
+# 142 "/usr/include/x86_64-linux-gnu/bits/types.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/time64.h" 1 3 4
+# 143 "/usr/include/x86_64-linux-gnu/bits/types.h" 2 3 4
+
+
+typedef unsigned long int __dev_t;
+typedef unsigned int __uid_t;
+typedef unsigned int __gid_t;
+typedef unsigned long int __ino_t;
+typedef unsigned long int __ino64_t;
+typedef unsigned int __mode_t;
+typedef unsigned long int __nlink_t;
+typedef long int __off_t;
+typedef long int __off64_t;
+typedef int __pid_t;
+typedef struct { int __val[2]; } __fsid_t;
+typedef long int __clock_t;
+typedef unsigned long int __rlim_t;
+typedef unsigned long int __rlim64_t;
+typedef unsigned int __id_t;
+typedef long int __time_t;
+typedef unsigned int __useconds_t;
+typedef long int __suseconds_t;
+typedef long int __suseconds64_t;
+
+typedef int __daddr_t;
+typedef int __key_t;
+
+
+typedef int __clockid_t;
+
+
+typedef void * __timer_t;
+
+
+typedef long int __blksize_t;
+
+
+
+
+typedef long int __blkcnt_t;
+typedef long int __blkcnt64_t;
+
+
+typedef unsigned long int __fsblkcnt_t;
+typedef unsigned long int __fsblkcnt64_t;
+
+
+typedef unsigned long int __fsfilcnt_t;
+typedef unsigned long int __fsfilcnt64_t;
+
+
+typedef long int __fsword_t;
+
+typedef long int __ssize_t;
+
+
+typedef long int __syscall_slong_t;
+
+typedef unsigned long int __syscall_ulong_t;
+
+
+
+typedef __off64_t __loff_t;
+typedef char *__caddr_t;
+
+
+typedef long int __intptr_t;
+
+
+typedef unsigned int __socklen_t;
+
+
+
+
+typedef int __sig_atomic_t;
+# 28 "/usr/include/stdint.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/wchar.h" 1 3 4
+# 29 "/usr/include/stdint.h" 2 3 4
+# 1 "/usr/include/x86_64-linux-gnu/bits/wordsize.h" 1 3 4
+# 30 "/usr/include/stdint.h" 2 3 4
+
+
+
+
+# 1 "/usr/include/x86_64-linux-gnu/bits/stdint-intn.h" 1 3 4
+# 24 "/usr/include/x86_64-linux-gnu/bits/stdint-intn.h" 3 4
+typedef __int8_t int8_t;
+typedef __int16_t int16_t;
+typedef __int32_t int32_t;
+typedef __int64_t int64_t;
+# 35 "/usr/include/stdint.h" 2 3 4
+
+
+# 1 "/usr/include/x86_64-linux-gnu/bits/stdint-uintn.h" 1 3 4
+# 24 "/usr/include/x86_64-linux-gnu/bits/stdint-uintn.h" 3 4
+typedef __uint8_t uint8_t;
+typedef __uint16_t uint16_t;
+typedef __uint32_t uint32_t;
+typedef __uint64_t uint64_t;
+# 38 "/usr/include/stdint.h" 2 3 4
+
+
+
+
+
+typedef __int_least8_t int_least8_t;
+typedef __int_least16_t int_least16_t;
+typedef __int_least32_t int_least32_t;
+typedef __int_least64_t int_least64_t;
+
+
+typedef __uint_least8_t uint_least8_t;
+typedef __uint_least16_t uint_least16_t;
+typedef __uint_least32_t uint_least32_t;
+typedef __uint_least64_t uint_least64_t;
+
+
+
+
+
+typedef signed char int_fast8_t;
+
+typedef long int int_fast16_t;
+typedef long int int_fast32_t;
+typedef long int int_fast64_t;
+# 71 "/usr/include/stdint.h" 3 4
+typedef unsigned char uint_fast8_t;
+
+typedef unsigned long int uint_fast16_t;
+typedef unsigned long int uint_fast32_t;
+typedef unsigned long int uint_fast64_t;
+# 87 "/usr/include/stdint.h" 3 4
+typedef long int intptr_t;
+
+
+typedef unsigned long int uintptr_t;
+# 101 "/usr/include/stdint.h" 3 4
+typedef __intmax_t intmax_t;
+typedef __uintmax_t uintmax_t;
+# 10 "/usr/lib/gcc/x86_64-linux-gnu/12/include/stdint.h" 2 3 4
+# 2 "inc/microbit/mpconfigport.h" 2
+# 71 "inc/microbit/mpconfigport.h"
+
+# 71 "inc/microbit/mpconfigport.h"
+typedef int mp_int_t;
+typedef unsigned mp_uint_t;
+
+typedef void *machine_ptr_t;
+typedef const void *machine_const_ptr_t;
+typedef long mp_off_t;
+
+void mp_hal_stdout_tx_strn_cooked(const char *str, mp_uint_t len);
+
+
+
+extern const struct _mp_obj_fun_builtin_t mp_builtin_help_obj;
+extern const struct _mp_obj_fun_builtin_t mp_builtin_input_obj;
+extern const struct _mp_obj_fun_builtin_t mp_builtin_open_obj;
+
+
+
+
+
+
+extern const struct _mp_obj_module_t microbit_module;
+extern const struct _mp_obj_module_t music_module;
+extern const struct _mp_obj_module_t this_module;
+extern const struct _mp_obj_module_t antigravity_module;
+extern const struct _mp_obj_module_t love_module;
+extern const struct _mp_obj_module_t neopixel_module;
+extern const struct _mp_obj_module_t random_module;
+extern const struct _mp_obj_module_t os_module;
+extern const struct _mp_obj_module_t radio_module;
+extern const struct _mp_obj_module_t audio_module;
+extern const struct _mp_obj_module_t speech_module;
+# 142 "inc/microbit/mpconfigport.h"
+# 1 "/usr/include/alloca.h" 1 3 4
+# 24 "/usr/include/alloca.h" 3 4
+# 1 "/usr/lib/gcc/x86_64-linux-gnu/12/include/stddef.h" 1 3 4
+# 214 "/usr/lib/gcc/x86_64-linux-gnu/12/include/stddef.h" 3 4
+
+# 214 "/usr/lib/gcc/x86_64-linux-gnu/12/include/stddef.h" 3 4
+typedef long unsigned int size_t;
+# 25 "/usr/include/alloca.h" 2 3 4
+
+
+
+
+
+
+
+extern void *alloca (size_t __size) __attribute__ ((__nothrow__ , __leaf__));
+
+
+
+
+
+
+# 143 "inc/microbit/mpconfigport.h" 2
+# 154 "inc/microbit/mpconfigport.h"
+
+# 154 "inc/microbit/mpconfigport.h"
+extern void microbit_ticker(void);
+# 46 "inc/py/mpconfig.h" 2
+# 493 "inc/py/mpconfig.h"
+typedef float mp_float_t;
+# 28 "<stdin>" 2
+
+
+
+
+
+QCFG(BYTES_IN_LEN, (1))
+QCFG(BYTES_IN_HASH, (1))
+
+Q()
+Q(*)
+Q(_)
+Q(__build_class__)
+Q(__class__)
+Q(__doc__)
+Q(__import__)
+Q(__init__)
+Q(__new__)
+Q(__locals__)
+Q(__main__)
+Q(__module__)
+Q(__name__)
+Q(__dict__)
+Q(__hash__)
+Q(__next__)
+Q(__qualname__)
+Q(__path__)
+Q(__repl_print__)
+
+
+
+
+Q(__bool__)
+Q(__contains__)
+Q(__enter__)
+Q(__exit__)
+Q(__len__)
+Q(__iter__)
+Q(__getitem__)
+Q(__setitem__)
+Q(__delitem__)
+Q(__add__)
+Q(__sub__)
+Q(__repr__)
+Q(__str__)
+
+
+
+
+
+Q(__getattr__)
+Q(__del__)
+Q(__call__)
+Q(__lt__)
+Q(__gt__)
+Q(__eq__)
+Q(__le__)
+Q(__ge__)
+Q(__reversed__)
+# 97 "<stdin>"
+Q(micropython)
+Q(bytecode)
+Q(const)
+# 112 "<stdin>"
+Q(asm_thumb)
+Q(label)
+Q(align)
+Q(data)
+Q(uint)
+Q(nop)
+Q(mov)
+Q(and_)
+Q(cmp)
+Q(add)
+Q(sub)
+Q(lsl)
+Q(lsr)
+Q(asr)
+Q(ldr)
+Q(ldrb)
+Q(ldrh)
+Q(str)
+Q(strb)
+Q(strh)
+Q(b)
+Q(bl)
+Q(bx)
+Q(push)
+Q(pop)
+Q(cpsid)
+Q(cpsie)
+Q(wfi)
+Q(clz)
+Q(rbit)
+Q(movw)
+Q(movt)
+Q(movwt)
+Q(mrs)
+Q(sdiv)
+Q(udiv)
+Q(ldrex)
+Q(strex)
+# 163 "<stdin>"
+Q(builtins)
+
+Q(Ellipsis)
+Q(StopIteration)
+
+
+
+
+Q(BaseException)
+Q(ArithmeticError)
+Q(AssertionError)
+Q(AttributeError)
+Q(BufferError)
+Q(EOFError)
+Q(Exception)
+Q(FileExistsError)
+Q(FileNotFoundError)
+Q(FloatingPointError)
+Q(GeneratorExit)
+Q(ImportError)
+Q(IndentationError)
+Q(IndexError)
+Q(KeyboardInterrupt)
+Q(KeyError)
+Q(LookupError)
+Q(MemoryError)
+Q(NameError)
+Q(NotImplementedError)
+Q(OSError)
+
+
+
+Q(OverflowError)
+Q(RuntimeError)
+Q(SyntaxError)
+Q(SystemExit)
+Q(TypeError)
+Q(UnboundLocalError)
+Q(ValueError)
+
+
+
+Q(ZeroDivisionError)
+
+Q(UnicodeError)
+
+
+Q(None)
+Q(False)
+Q(True)
+Q(object)
+
+Q(NoneType)
+
+
+Q(OrderedDict)
+
+
+Q(abs)
+Q(all)
+Q(any)
+Q(args)
+
+Q(array)
+
+Q(bin)
+Q({:#b})
+Q(bool)
+
+Q(bytearray)
+
+
+
+
+Q(bytes)
+Q(callable)
+Q(chr)
+Q(classmethod)
+Q(_collections)
+
+
+
+
+
+Q(dict)
+Q(dir)
+Q(divmod)
+
+Q(enumerate)
+
+Q(eval)
+Q(exec)
+
+
+
+
+Q(filter)
+
+
+Q(float)
+
+Q(from_bytes)
+Q(getattr)
+Q(setattr)
+Q(globals)
+Q(hasattr)
+Q(hash)
+Q(hex)
+Q(%#x)
+Q(id)
+Q(int)
+Q(isinstance)
+Q(issubclass)
+Q(iter)
+Q(len)
+Q(list)
+Q(locals)
+Q(map)
+
+Q(max)
+Q(min)
+Q(default)
+
+Q(namedtuple)
+Q(next)
+Q(oct)
+Q(%#o)
+Q(open)
+Q(ord)
+Q(path)
+Q(pow)
+Q(print)
+Q(range)
+Q(read)
+Q(repr)
+Q(reversed)
+Q(round)
+Q(sorted)
+Q(staticmethod)
+Q(sum)
+Q(super)
+Q(str)
+Q(sys)
+Q(to_bytes)
+Q(tuple)
+Q(type)
+Q(value)
+Q(write)
+Q(zip)
+
+
+
+
+
+
+
+Q(sep)
+Q(end)
+
+
+Q(step)
+Q(stop)
+
+
+Q(clear)
+Q(copy)
+Q(fromkeys)
+Q(get)
+Q(items)
+Q(keys)
+Q(pop)
+Q(popitem)
+Q(setdefault)
+Q(update)
+Q(values)
+Q(append)
+Q(close)
+Q(send)
+Q(throw)
+Q(count)
+Q(extend)
+Q(index)
+Q(remove)
+Q(insert)
+Q(pop)
+Q(sort)
+Q(join)
+Q(strip)
+Q(lstrip)
+Q(rstrip)
+Q(format)
+Q(key)
+Q(reverse)
+Q(add)
+Q(clear)
+Q(copy)
+Q(pop)
+Q(remove)
+Q(find)
+Q(rfind)
+Q(rindex)
+Q(split)
+
+
+
+
+
+Q(rsplit)
+Q(startswith)
+Q(endswith)
+Q(replace)
+Q(partition)
+Q(rpartition)
+Q(lower)
+Q(upper)
+Q(isspace)
+Q(isalpha)
+Q(isdigit)
+Q(isupper)
+Q(islower)
+Q(iterable)
+Q(start)
+
+Q(bound_method)
+Q(closure)
+Q(dict_view)
+Q(function)
+Q(generator)
+Q(iterator)
+Q(module)
+Q(slice)
+
+
+Q(discard)
+Q(difference)
+Q(difference_update)
+Q(intersection)
+Q(intersection_update)
+Q(isdisjoint)
+Q(issubset)
+Q(issuperset)
+Q(set)
+Q(symmetric_difference)
+Q(symmetric_difference_update)
+Q(union)
+Q(update)
+
+
+
+Q(frozenset)
+
+
+
+Q(math)
+Q(e)
+Q(pi)
+Q(sqrt)
+Q(pow)
+Q(exp)
+
+
+
+Q(log)
+# 436 "<stdin>"
+Q(cos)
+Q(sin)
+Q(tan)
+Q(acos)
+Q(asin)
+Q(atan)
+Q(atan2)
+Q(ceil)
+Q(copysign)
+Q(fabs)
+Q(fmod)
+Q(floor)
+Q(isfinite)
+Q(isinf)
+Q(isnan)
+Q(trunc)
+Q(modf)
+Q(frexp)
+Q(ldexp)
+Q(degrees)
+Q(radians)
+# 478 "<stdin>"
+Q(mem_info)
+Q(qstr_info)
+
+Q(stack_use)
+
+
+
+Q(heap_lock)
+Q(heap_unlock)
+
+
+
+
+
+Q(maximum recursion depth exceeded)
+
+Q(<module>)
+Q(<lambda>)
+Q(<listcomp>)
+Q(<dictcomp>)
+Q(<setcomp>)
+Q(<genexpr>)
+Q(<string>)
+Q(<stdin>)
+# 510 "<stdin>"
+Q(argv)
+Q(byteorder)
+Q(big)
+Q(exit)
+Q(little)
+
+Q(platform)
+
+Q(stdin)
+Q(stdout)
+Q(stderr)
+
+
+
+Q(version)
+Q(version_info)
+
+Q(name)
+
+Q(implementation)
+# 539 "<stdin>"
+Q(print_exception)
+
+
+
+Q(struct)
+Q(ustruct)
+Q(pack)
+Q(pack_into)
+Q(unpack)
+Q(unpack_from)
+Q(calcsize)
+# 616 "<stdin>"
+Q(gc)
+Q(collect)
+Q(disable)
+Q(enable)
+Q(isenabled)
+Q(mem_free)
+Q(mem_alloc)
+# 766 "<stdin>"
+Q(help)
+Q(input)
+Q(collections)
+Q(struct)
+
+Q(microbit)
+Q(reset)
+Q(sleep)
+Q(running_time)
+Q(panic)
+Q(temperature)
+Q(read_sensors)
+Q(orientation)
+Q(into)
+
+Q(this)
+Q(authors)
+
+Q(antigravity)
+
+Q(love)
+Q(badaboom)
+
+Q(MicroBitDigitalPin)
+Q(MicroBitAnalogDigitalPin)
+Q(MicroBitTouchPin)
+Q(read_digital)
+Q(write_digital)
+Q(read_analog)
+Q(write_analog)
+Q(set_analog_period)
+Q(set_analog_period_microseconds)
+Q(get_analog_period_microseconds)
+Q(is_touched)
+Q(unused)
+Q(audio_play)
+Q(button)
+Q(touch)
+Q(3v)
+Q(get_mode)
+
+Q(MicroBitIO)
+Q(pin0)
+Q(pin1)
+Q(pin2)
+Q(pin3)
+Q(pin4)
+Q(pin5)
+Q(pin6)
+Q(pin7)
+Q(pin8)
+Q(pin9)
+Q(pin10)
+Q(pin11)
+Q(pin12)
+Q(pin13)
+Q(pin14)
+Q(pin15)
+Q(pin16)
+Q(pin19)
+Q(pin20)
+Q(get_pull)
+Q(set_pull)
+Q(PULL_UP)
+Q(PULL_DOWN)
+Q(NO_PULL)
+Q(RISING)
+Q(FALLING)
+Q(BOTH)
+Q(start_counting)
+Q(stop_counting)
+Q(edge_count)
+Q(read_edges)
+Q(edges)
+Q(handler)
+Q(time_pulse_us)
+Q(time_period_us)
+Q(level)
+Q(timeout_us)
+Q(read_analog_into)
+Q(read_analog_frames)
+Q(analog_overruns)
+Q(underruns)
+Q(rate)
+
+Q(MicroBitImage)
+Q(Image)
+Q(image)
+Q(width)
+Q(height)
+Q(invert)
+Q(fill)
+Q(set_pixel)
+Q(get_pixel)
+Q(shift_left)
+Q(shift_right)
+Q(shift_up)
+Q(shift_down)
+Q(monospace)
+Q(blit)
+Q(HEART)
+Q(HEART_SMALL)
+Q(HAPPY)
+Q(SAD)
+Q(SMILE)
+Q(CONFUSED)
+Q(ANGRY)
+Q(ASLEEP)
+Q(SURPRISED)
+Q(SILLY)
+Q(FABULOUS)
+Q(MEH)
+Q(YES)
+Q(NO)
+Q(CLOCK12)
+Q(CLOCK1)
+Q(CLOCK2)
+Q(CLOCK3)
+Q(CLOCK4)
+Q(CLOCK5)
+Q(CLOCK6)
+Q(CLOCK7)
+Q(CLOCK8)
+Q(CLOCK9)
+Q(CLOCK10)
+Q(CLOCK11)
+Q(ARROW_N)
+Q(ARROW_NE)
+Q(ARROW_E)
+Q(ARROW_SE)
+Q(ARROW_S)
+Q(ARROW_SW)
+Q(ARROW_W)
+Q(ARROW_NW)
+Q(TRIANGLE)
+Q(TRIANGLE_LEFT)
+Q(CHESSBOARD)
+Q(DIAMOND)
+Q(DIAMOND_SMALL)
+Q(SQUARE)
+Q(SQUARE_SMALL)
+Q(RABBIT)
+Q(COW)
+Q(MUSIC_CROTCHET)
+Q(MUSIC_QUAVER)
+Q(MUSIC_QUAVERS)
+Q(PITCHFORK)
+Q(XMAS)
+Q(PACMAN)
+Q(TARGET)
+Q(TSHIRT)
+Q(ROLLERSKATE)
+Q(DUCK)
+Q(HOUSE)
+Q(TORTOISE)
+Q(BUTTERFLY)
+Q(STICKFIGURE)
+Q(GHOST)
+Q(SWORD)
+Q(GIRAFFE)
+Q(SKULL)
+Q(UMBRELLA)
+Q(SNAKE)
+
+Q(ALL_ARROWS)
+Q(ALL_CLOCKS)
+
+Q(MicroBitDisplay)
+Q(set_brightness)
+Q(set_display_mode)
+Q(display)
+Q(show)
+Q(scroll)
+Q(delay)
+Q(stride)
+Q(start)
+Q(wait)
+Q(loop)
+Q(copy)
+Q(crop)
+Q(slice)
+Q(text)
+Q(SlicedImage)
+Q(ScrollingString)
+Q(on)
+Q(off)
+Q(is_on)
+Q(Facade)
+
+Q(MicroBitButton)
+Q(button_a)
+Q(button_b)
+Q(is_pressed)
+Q(was_pressed)
+Q(get_presses)
+
+Q(MicroBitAccelerometer)
+Q(accelerometer)
+Q(get_x)
+Q(get_y)
+Q(get_z)
+Q(get_values)
+Q(current_gesture)
+Q(is_gesture)
+Q(was_gesture)
+Q(get_gestures)
+Q(up)
+Q(down)
+Q(left)
+Q(right)
+Q(face up)
+Q(face down)
+Q(freefall)
+Q(3g)
+Q(6g)
+Q(8g)
+Q(shake)
+Q(start_sampling)
+Q(stop_sampling)
+Q(read_samples)
+Q(overruns)
+Q(period)
+Q(start_tracking)
+Q(stop_tracking)
+Q(window)
+Q(threshold)
+Q(get_magnitude)
+Q(get_mean)
+Q(get_variance)
+Q(get_crossing_rate)
+Q(get_peak)
+Q(get_peaks)
+Q(get_steps)
+
+Q(MicroBitCompass)
+Q(compass)
+Q(heading)
+Q(is_calibrated)
+Q(calibrate)
+Q(clear_calibration)
+Q(get_x)
+Q(get_y)
+Q(get_z)
+Q(get_field_strength)
+Q(get_calibration)
+Q(set_calibration)
+Q(get_values)
+Q(start_calibrating)
+Q(stop_calibrating)
+Q(auto_calibrate)
+
+Q(MicroBitI2C)
+Q(i2c)
+Q(read)
+Q(write)
+Q(addr)
+Q(n)
+Q(buf)
+Q(repeat)
+Q(freq)
+Q(sda)
+Q(scl)
+
+Q(music)
+Q(frequency)
+Q(duration)
+Q(pitch)
+Q(pin)
+Q(play)
+Q(set_tempo)
+Q(get_tempo)
+Q(compile)
+Q(Tune)
+Q(Synth)
+Q(set_voice)
+Q(voice)
+Q(waveform)
+Q(volume)
+Q(SQUARE)
+Q(SINE)
+Q(TRIANGLE)
+Q(SAWTOOTH)
+Q(bpm)
+Q(ticks)
+Q(BADDY)
+Q(BA_DING)
+Q(BIRTHDAY)
+Q(BLUES)
+Q(CHASE)
+Q(DADADADUM)
+Q(ENTERTAINER)
+Q(FUNERAL)
+Q(FUNK)
+Q(JUMP_DOWN)
+Q(JUMP_UP)
+Q(NYAN)
+Q(ODE)
+Q(POWER_DOWN)
+Q(POWER_UP)
+Q(PRELUDE)
+Q(PUNCHLINE)
+Q(PYTHON)
+Q(RINGTONE)
+Q(WAWAWAWAA)
+Q(WEDDING)
+Q(a)
+Q(a#)
+Q(a#:1)
+Q(a#:3)
+Q(a2)
+Q(a4)
+Q(a4:1)
+Q(a4:3)
+Q(a:1)
+Q(a:2)
+Q(a:4)
+Q(a:5)
+Q(b)
+Q(b2:1)
+Q(b3)
+Q(b4)
+Q(b4:1)
+Q(b4:2)
+Q(b5)
+Q(b5:1)
+Q(b:1)
+Q(b:2)
+Q(c)
+Q(c#)
+Q(c#5)
+Q(c#5:1)
+Q(c#5:2)
+Q(c#:1)
+Q(c#:8)
+Q(c2:2)
+Q(c3)
+Q(c3:3)
+Q(c3:4)
+Q(c4)
+Q(c4:1)
+Q(c4:3)
+Q(c4:4)
+Q(c5)
+Q(c5:1)
+Q(c5:2)
+Q(c5:3)
+Q(c5:4)
+Q(c:1)
+Q(c:2)
+Q(c:3)
+Q(c:4)
+Q(c:8)
+Q(d)
+Q(d#)
+Q(d#5:2)
+Q(d#:2)
+Q(d#:3)
+Q(d3)
+Q(d4)
+Q(d4:1)
+Q(d5)
+Q(d5:1)
+Q(d5:2)
+Q(d:1)
+Q(d:2)
+Q(d:3)
+Q(d:4)
+Q(d:5)
+Q(d:6)
+Q(d:8)
+Q(e)
+Q(e3:3)
+Q(e4)
+Q(e4:1)
+Q(e5)
+Q(e6:3)
+Q(e:1)
+Q(e:2)
+Q(e:3)
+Q(e:4)
+Q(e:5)
+Q(e:6)
+Q(e:8)
+Q(eb:8)
+Q(f)
+Q(f#)
+Q(f#5)
+Q(f#5:2)
+Q(f#:1)
+Q(f#:2)
+Q(f#:8)
+Q(f2)
+Q(f:1)
+Q(f:2)
+Q(f:3)
+Q(f:4)
+Q(f:8)
+Q(g)
+Q(g#)
+Q(g#:1)
+Q(g#:3)
+Q(g3:1)
+Q(g4)
+Q(g4:1)
+Q(g4:2)
+Q(g5)
+Q(g5:1)
+Q(g:1)
+Q(g:2)
+Q(g:3)
+Q(g:8)
+Q(r)
+Q(r4:2)
+Q(r:1)
+Q(r:2)
+Q(r:3)
+
+Q(MicroBitUART)
+Q(uart)
+Q(init)
+Q(baudrate)
+Q(bits)
+Q(parity)
+Q(stop)
+Q(pins)
+Q(tx)
+Q(rx)
+Q(any)
+Q(read)
+Q(readall)
+Q(readline)
+Q(readinto)
+Q(write)
+Q(ODD)
+Q(EVEN)
+
+Q(MicroBitSPI)
+Q(spi)
+Q(init)
+Q(baudrate)
+Q(bits)
+Q(mode)
+Q(sclk)
+Q(mosi)
+Q(miso)
+Q(write)
+Q(write_readinto)
+
+Q(neopixel)
+Q(NeoPixel)
+Q(clear)
+Q(show)
+Q(gradient)
+Q(hsv)
+Q(rotate)
+Q(shift)
+Q(scale)
+Q(from)
+Q(to)
+Q(hue)
+Q(end_hue)
+Q(saturation)
+Q(get_brightness)
+Q(set_gamma)
+
+Q(random)
+Q(getrandbits)
+Q(seed)
+Q(randrange)
+Q(randint)
+Q(choice)
+Q(uniform)
+
+Q(audio)
+Q(play)
+Q(AudioFrame)
+Q(pin)
+Q(return_pin)
+Q(source)
+Q(copyfrom)
+Q(ADPCM)
+
+Q(name)
+
+Q(os)
+Q(uname)
+Q(micropython)
+Q(sysname)
+Q(nodename)
+Q(release)
+Q(version)
+Q(BytesIO)
+Q(TextIO)
+Q(read)
+Q(write)
+Q(writable)
+Q(readall)
+Q(name)
+Q(listdir)
+Q(machine)
+Q(size)
+
+Q(is_playing)
+
+Q(speech)
+Q(say)
+Q(pronounce)
+Q(sing)
+Q(pitch)
+Q(throat)
+Q(mouth)
+Q(speed)
+Q(debug)
+Q(translate)
+Q(render)
+Q(samples)
+Q(stats)
+Q(cache)
+Q(save_cache)
+Q(load_cache)
+
+Q(radio)
+Q(reset)
+Q(config)
+Q(on)
+Q(off)
+Q(send_bytes)
+Q(receive_bytes)
+Q(send)
+Q(receive)
+Q(receive_bytes_into)
+Q(receive_full)
+Q(receive_many)
+Q(tx_queue)
+Q(sent)
+Q(tx_dropped)
+Q(rx_lost)
+Q(received)
+Q(crc_errors)
+Q(rx_dropped)
+Q(tx_time)
+Q(rssi)
+Q(benchmark)
+Q(timeout)
+Q(packets)
+Q(lost)
+Q(time)
+Q(pps)
+Q(latency)
+Q(FLOOD)
+Q(SINK)
+Q(PING)
+Q(ECHO)
+Q(send_large)
+Q(receive_large)
+Q(large_length)
+Q(send_reliable)
+Q(node_id)
+Q(reliable)
+Q(tx_retries)
+Q(tx_failed)
+Q(tdma)
+Q(slot)
+Q(slot_time)
+Q(hops)
+Q(beacons)
+Q(synced)
+Q(length)
+Q(queue)
+Q(channel)
+Q(power)
+Q(data_rate)
+Q(address)
+Q(group)
+Q(addresses)
+Q(RATE_250KBIT)
+Q(RATE_1MBIT)
+Q(RATE_2MBIT)
@@ -0,0 +1,115 @@
+// This file was automatically generated by makemusictunes.py
+
+MUSIC_TUNE(dadadadum,
+    {0, 2}, {2551, 2}, {2551, 2}, {2551, 2}, {3214, 8}, {0, 2}, {2863, 2},
+    {2863, 2}, {2863, 2}, {3405, 8})
+MUSIC_TUNE(entertainer,
+    {3405, 1}, {3214, 1}, {3034, 1}, {1911, 2}, {3034, 1}, {1911, 2},
+    {3034, 1}, {1911, 3}, {1911, 1}, {1702, 1}, {1607, 1}, {1517, 1},
+    {1911, 1}, {1702, 1}, {1517, 2}, {2025, 1}, {1702, 2}, {1911, 4})
+MUSIC_TUNE(prelude,
+    {3822, 1}, {3034, 1}, {2551, 1}, {1911, 1}, {1517, 1}, {2551, 1},
+    {1911, 1}, {1517, 1}, {3822, 1}, {3034, 1}, {2551, 1}, {1911, 1},
+    {1517, 1}, {2551, 1}, {1911, 1}, {1517, 1}, {3822, 1}, {3405, 1},
+    {2551, 1}, {1702, 1}, {1431, 1}, {2551, 1}, {1702, 1}, {1431, 1},
+    {3822, 1}, {3405, 1}, {2551, 1}, {1702, 1}, {1431, 1}, {2551, 1},
+    {1702, 1}, {1431, 1}, {4050, 1}, {3405, 1}, {2551, 1}, {1702, 1},
+    {1431, 1}, {2551, 1}, {1702, 1}, {1431, 1}, {4050, 1}, {3405, 1},
+    {2551, 1}, {1702, 1}, {1431, 1}, {2551, 1}, {1702, 1}, {1431, 1},
+    {3822, 1}, {3034, 1}, {2551, 1}, {1911, 1}, {1517, 1}, {2551, 1},
+    {1911, 1}, {1517, 1}, {3822, 1}, {3034, 1}, {2551, 1}, {1911, 1},
+    {1517, 1}, {2551, 1}, {1911, 1}, {1517, 1})
+MUSIC_TUNE(ode,
+    {3034, 4}, {3034, 4}, {2863, 4}, {2551, 4}, {2551, 4}, {2863, 4},
+    {3034, 4}, {3405, 4}, {3822, 4}, {3822, 4}, {3405, 4}, {3034, 4},
+    {3034, 6}, {3405, 2}, {3405, 8}, {3034, 4}, {3034, 4}, {2863, 4},
+    {2551, 4}, {2551, 4}, {2863, 4}, {3034, 4}, {3405, 4}, {3822, 4},
+    {3822, 4}, {3405, 4}, {3034, 4}, {3405, 6}, {3822, 2}, {3822, 8})
+MUSIC_TUNE(nyan,
+    {1351, 2}, {1204, 2}, {1804, 1}, {1607, 2}, {2025, 1}, {1702, 1},
+    {1804, 1}, {2025, 2}, {2025, 2}, {1804, 2}, {1702, 2}, {1702, 1},
+    {1804, 1}, {2025, 1}, {1804, 1}, {1607, 1}, {1351, 1}, {1204, 1},
+    {1607, 1}, {1351, 1}, {1804, 1}, {1702, 1}, {2025, 1}, {1804, 1},
+    {2025, 1}, {1607, 2}, {1351, 2}, {1204, 1}, {1607, 1}, {1351, 1},
+    {1804, 1}, {1607, 1}, {2025, 1}, {1702, 1}, {1607, 1}, {1702, 1},
+    {1804, 1}, {2025, 1}, {1804, 1}, {1702, 2}, {2025, 1}, {1804, 1},
+    {1607, 1}, {1351, 1}, {1804, 1}, {1702, 1}, {1804, 1}, {2025, 1},
+    {1804, 2}, {2025, 2}, {1804, 2}, {2025, 2}, {2703, 1}, {2408, 1},
+    {2025, 2}, {2703, 1}, {2408, 1}, {2025, 1}, {1804, 1}, {1607, 1},
+    {2025, 1}, {1517, 1}, {1607, 1}, {1517, 1}, {1351, 1}, {2025, 2},
+    {2025, 2}, {2703, 1}, {2408, 1}, {2025, 1}, {2703, 1}, {1517, 1},
+    {1607, 1}, {1804, 1}, {2025, 1}, {2703, 1}, {3214, 1}, {3034, 1},
+    {2703, 1}, {2025, 2}, {2703, 1}, {2408, 1}, {2025, 2}, {2703, 1},
+    {2408, 1}, {2025, 1}, {2025, 1}, {1804, 1}, {1607, 1}, {2025, 1},
+    {2703, 1}, {2408, 1}, {2703, 1}, {2025, 2}, {2025, 1}, {2145, 1},
+    {2025, 1}, {2703, 1}, {2408, 1}, {2025, 1}, {1517, 1}, {1607, 1},
+    {1517, 1}, {1351, 1}, {2025, 2}, {1804, 2})
+MUSIC_TUNE(ringtone,
+    {3822, 1}, {3405, 1}, {3034, 2}, {2551, 2}, {3405, 1}, {3034, 1},
+    {2863, 2}, {2273, 2}, {3034, 1}, {2863, 1}, {2551, 2}, {2025, 2},
+    {1911, 4})
+MUSIC_TUNE(funk,
+    {15288, 2}, {15288, 2}, {12856, 2}, {15288, 1}, {11452, 2}, {15288, 1},
+    {11452, 2}, {10812, 2}, {10204, 2}, {15288, 2}, {15288, 2}, {10204, 2},
+    {15288, 1}, {10812, 2}, {15288, 1}, {10812, 2}, {11452, 2}, {12856, 2})
+MUSIC_TUNE(blues,
+    {15288, 2}, {12136, 2}, {10204, 2}, {9092, 2}, {8580, 2}, {9092, 2},
+    {10204, 2}, {12136, 2}, {15288, 2}, {12136, 2}, {10204, 2}, {9092, 2},
+    {8580, 2}, {9092, 2}, {10204, 2}, {12136, 2}, {11452, 2}, {9092, 2},
+    {7644, 2}, {6810, 2}, {6428, 2}, {6810, 2}, {7644, 2}, {9092, 2},
+    {15288, 2}, {12136, 2}, {10204, 2}, {9092, 2}, {8580, 2}, {9092, 2},
+    {10204, 2}, {12136, 2}, {10204, 2}, {8100, 2}, {6810, 2}, {5726, 2},
+    {11452, 2}, {9092, 2}, {7644, 2}, {6428, 2}, {15288, 2}, {12136, 2},
+    {10204, 2}, {12136, 2}, {10204, 2}, {11452, 2}, {12136, 2}, {13620, 2})
+MUSIC_TUNE(birthday,
+    {3822, 3}, {3822, 1}, {3405, 4}, {3822, 4}, {2863, 4}, {3034, 8},
+    {3822, 3}, {3822, 1}, {3405, 4}, {3822, 4}, {2551, 4}, {2863, 8},
+    {3822, 3}, {3822, 1}, {1911, 4}, {2273, 4}, {2863, 4}, {3034, 4},
+    {3405, 4}, {2145, 3}, {2145, 1}, {2273, 4}, {2863, 4}, {2551, 4},
+    {2863, 8})
+MUSIC_TUNE(wedding,
+    {3822, 4}, {2863, 3}, {2863, 1}, {2863, 8}, {3822, 4}, {2551, 3},
+    {3034, 1}, {2863, 8}, {3822, 4}, {2863, 3}, {2273, 1}, {1911, 4},
+    {2273, 3}, {2863, 1}, {2863, 4}, {3034, 3}, {2863, 1}, {2551, 8})
+MUSIC_TUNE(funeral,
+    {7644, 4}, {7644, 3}, {7644, 1}, {7644, 4}, {6428, 3}, {6810, 1},
+    {6810, 3}, {7644, 1}, {7644, 3}, {8100, 1}, {7644, 4})
+MUSIC_TUNE(punchline,
+    {3822, 3}, {5102, 1}, {5406, 1}, {5102, 1}, {4816, 3}, {5102, 3},
+    {0, 3}, {4050, 3}, {3822, 3})
+MUSIC_TUNE(python,
+    {1702, 1}, {2025, 1}, {0, 1}, {2025, 1}, {2025, 1}, {2145, 1},
+    {2025, 1}, {1275, 1}, {0, 1}, {1702, 1}, {1702, 1}, {0, 1}, {2025, 1},
+    {1911, 1}, {0, 1}, {1911, 1}, {1911, 1}, {0, 1}, {1702, 1}, {1517, 5},
+    {1911, 1}, {2273, 1}, {0, 1}, {2273, 1}, {2273, 1}, {2408, 1},
+    {2273, 1}, {1351, 1}, {0, 1}, {1517, 1}, {1517, 1}, {0, 1}, {1911, 1},
+    {2025, 1}, {0, 1}, {2025, 1}, {2025, 1}, {0, 1}, {1911, 1}, {1702, 5},
+    {1702, 1}, {2025, 1}, {0, 1}, {2025, 1}, {2025, 1}, {2145, 1},
+    {2025, 1}, {1012, 1}, {0, 1}, {1275, 1}, {1275, 1}, {0, 1}, {1702, 1},
+    {1804, 1}, {0, 1}, {1136, 1}, {1136, 1}, {0, 1}, {1136, 1}, {1136, 5},
+    {1275, 1}, {1351, 2}, {1136, 1}, {1136, 1}, {1204, 1}, {1136, 1},
+    {1517, 2}, {1136, 1}, {1136, 1}, {1204, 1}, {1136, 1}, {1702, 1},
+    {0, 1}, {1804, 1}, {1702, 1}, {0, 1}, {1804, 1}, {1702, 2}, {0, 3})
+MUSIC_TUNE(baddy,
+    {7644, 3}, {0, 3}, {6810, 2}, {6428, 2}, {0, 2}, {7644, 2}, {0, 2},
+    {5406, 8})
+MUSIC_TUNE(chase,
+    {2273, 1}, {2025, 1}, {1911, 1}, {2025, 1}, {2273, 2}, {0, 2},
+    {2273, 1}, {2025, 1}, {1911, 1}, {2025, 1}, {2273, 2}, {0, 2},
+    {2273, 2}, {1517, 2}, {1607, 2}, {1517, 2}, {1431, 2}, {1517, 2},
+    {1607, 2}, {1517, 2}, {2025, 1}, {1911, 1}, {1702, 1}, {1911, 1},
+    {2025, 2}, {0, 2}, {2025, 1}, {1911, 1}, {1702, 1}, {1911, 1},
+    {2025, 2}, {0, 2}, {2025, 2}, {1517, 2}, {1607, 2}, {1517, 2},
+    {1431, 2}, {1517, 2}, {1607, 2}, {1517, 2})
+MUSIC_TUNE(ba_ding,
+    {1012, 1}, {758, 3})
+MUSIC_TUNE(wawawawaa,
+    {6068, 3}, {0, 1}, {6428, 3}, {0, 1}, {6810, 4}, {0, 1}, {7216, 8})
+MUSIC_TUNE(jump_up,
+    {1911, 1}, {1702, 1}, {1517, 1}, {1431, 1}, {1275, 1})
+MUSIC_TUNE(jump_down,
+    {1275, 1}, {1431, 1}, {1517, 1}, {1702, 1}, {1911, 1})
+MUSIC_TUNE(power_up,
+    {2551, 1}, {1911, 1}, {1517, 1}, {1275, 2}, {1517, 1}, {1275, 3})
+MUSIC_TUNE(power_down,
+    {1275, 1}, {1607, 1}, {1911, 1}, {2551, 2}, {2025, 1}, {1911, 3})
@@ -338,6 +338,9 @@ QDEF(MP_QSTR_sleep, (const byte*)"\xea\x05" "sleep")
 QDEF(MP_QSTR_running_time, (const byte*)"\xc8\x0c" "running_time")
 QDEF(MP_QSTR_panic, (const byte*)"\xd0\x05" "panic")
 QDEF(MP_QSTR_temperature, (const byte*)"\xe9\x0b" "temperature")
+QDEF(MP_QSTR_read_sensors, (const byte*)"\xad\x0c" "read_sensors")
+QDEF(MP_QSTR_orientation, (const byte*)"\x53\x0b" "orientation")
+QDEF(MP_QSTR_into, (const byte*)"\xb9\x04" "into")
 QDEF(MP_QSTR_this, (const byte*)"\xa3\x04" "this")
 QDEF(MP_QSTR_authors, (const byte*)"\x63\x07" "authors")
 QDEF(MP_QSTR_antigravity, (const byte*)"\xf1\x0b" "antigravity")
@@ -385,6 +388,24 @@ QDEF(MP_QSTR_set_pull, (const byte*)"\xdd\x08" "set_pull")
 QDEF(MP_QSTR_PULL_UP, (const byte*)"\xba\x07" "PULL_UP")
 QDEF(MP_QSTR_PULL_DOWN, (const byte*)"\xad\x09" "PULL_DOWN")
 QDEF(MP_QSTR_NO_PULL, (const byte*)"\x1e\x07" "NO_PULL")
+QDEF(MP_QSTR_RISING, (const byte*)"\x2d\x06" "RISING")
+QDEF(MP_QSTR_FALLING, (const byte*)"\x02\x07" "FALLING")
+QDEF(MP_QSTR_BOTH, (const byte*)"\x14\x04" "BOTH")
+QDEF(MP_QSTR_start_counting, (const byte*)"\xb9\x0e" "start_counting")
+QDEF(MP_QSTR_stop_counting, (const byte*)"\xa1\x0d" "stop_counting")
+QDEF(MP_QSTR_edge_count, (const byte*)"\x7a\x0a" "edge_count")
+QDEF(MP_QSTR_read_edges, (const byte*)"\x98\x0a" "read_edges")
+QDEF(MP_QSTR_edges, (const byte*)"\xf5\x05" "edges")
+QDEF(MP_QSTR_handler, (const byte*)"\xdd\x07" "handler")
+QDEF(MP_QSTR_time_pulse_us, (const byte*)"\x89\x0d" "time_pulse_us")
+QDEF(MP_QSTR_time_period_us, (const byte*)"\x73\x0e" "time_period_us")
+QDEF(MP_QSTR_level, (const byte*)"\xd3\x05" "level")
+QDEF(MP_QSTR_timeout_us, (const byte*)"\x47\x0a" "timeout_us")
+QDEF(MP_QSTR_read_analog_into, (const byte*)"\x81\x10" "read_analog_into")
+QDEF(MP_QSTR_read_analog_frames, (const byte*)"\xf3\x12" "read_analog_frames")
+QDEF(MP_QSTR_analog_overruns, (const byte*)"\xc4\x0f" "analog_overruns")
+QDEF(MP_QSTR_underruns, (const byte*)"\xf7\x09" "underruns")
+QDEF(MP_QSTR_rate, (const byte*)"\x47\x04" "rate")
 QDEF(MP_QSTR_MicroBitImage, (const byte*)"\x87\x0d" "MicroBitImage")
 QDEF(MP_QSTR_Image, (const byte*)"\x62\x05" "Image")
 QDEF(MP_QSTR_image, (const byte*)"\x42\x05" "image")
@@ -510,6 +531,22 @@ QDEF(MP_QSTR_3g, (const byte*)"\x31\x02" "3g")
 QDEF(MP_QSTR_6g, (const byte*)"\x94\x02" "6g")
 QDEF(MP_QSTR_8g, (const byte*)"\x5a\x02" "8g")
 QDEF(MP_QSTR_shake, (const byte*)"\x31\x05" "shake")
+QDEF(MP_QSTR_start_sampling, (const byte*)"\xb9\x0e" "start_sampling")
+QDEF(MP_QSTR_stop_sampling, (const byte*)"\xa1\x0d" "stop_sampling")
+QDEF(MP_QSTR_read_samples, (const byte*)"\x7d\x0c" "read_samples")
+QDEF(MP_QSTR_overruns, (const byte*)"\x51\x08" "overruns")
+QDEF(MP_QSTR_period, (const byte*)"\xa0\x06" "period")
+QDEF(MP_QSTR_start_tracking, (const byte*)"\x35\x0e" "start_tracking")
+QDEF(MP_QSTR_stop_tracking, (const byte*)"\x2d\x0d" "stop_tracking")
+QDEF(MP_QSTR_window, (const byte*)"\x89\x06" "window")
+QDEF(MP_QSTR_threshold, (const byte*)"\xf2\x09" "threshold")
+QDEF(MP_QSTR_get_magnitude, (const byte*)"\x01\x0d" "get_magnitude")
+QDEF(MP_QSTR_get_mean, (const byte*)"\x0b\x08" "get_mean")
+QDEF(MP_QSTR_get_variance, (const byte*)"\x89\x0c" "get_variance")
+QDEF(MP_QSTR_get_crossing_rate, (const byte*)"\x2f\x11" "get_crossing_rate")
+QDEF(MP_QSTR_get_peak, (const byte*)"\xf3\x08" "get_peak")
+QDEF(MP_QSTR_get_peaks, (const byte*)"\x20\x09" "get_peaks")
+QDEF(MP_QSTR_get_steps, (const byte*)"\xad\x09" "get_steps")
 QDEF(MP_QSTR_MicroBitCompass, (const byte*)"\x10\x0f" "MicroBitCompass")
 QDEF(MP_QSTR_compass, (const byte*)"\x55\x07" "compass")
 QDEF(MP_QSTR_heading, (const byte*)"\x2d\x07" "heading")
@@ -521,6 +558,7 @@ QDEF(MP_QSTR_get_calibration, (const byte*)"\x46\x0f" "get_calibration")
 QDEF(MP_QSTR_set_calibration, (const byte*)"\x52\x0f" "set_calibration")
 QDEF(MP_QSTR_start_calibrating, (const byte*)"\xd8\x11" "start_calibrating")
 QDEF(MP_QSTR_stop_calibrating, (const byte*)"\xc0\x10" "stop_calibrating")
+QDEF(MP_QSTR_auto_calibrate, (const byte*)"\x72\x0e" "auto_calibrate")
 QDEF(MP_QSTR_MicroBitI2C, (const byte*)"\xb8\x0b" "MicroBitI2C")
 QDEF(MP_QSTR_i2c, (const byte*)"\x5d\x03" "i2c")
 QDEF(MP_QSTR_addr, (const byte*)"\xb6\x04" "addr")
@@ -538,6 +576,15 @@ QDEF(MP_QSTR_pin, (const byte*)"\xf2\x03" "pin")
 QDEF(MP_QSTR_play, (const byte*)"\x21\x04" "play")
 QDEF(MP_QSTR_set_tempo, (const byte*)"\x9b\x09" "set_tempo")
 QDEF(MP_QSTR_get_tempo, (const byte*)"\x8f\x09" "get_tempo")
+QDEF(MP_QSTR_compile, (const byte*)"\xf4\x07" "compile")
+QDEF(MP_QSTR_Tune, (const byte*)"\xaf\x04" "Tune")
+QDEF(MP_QSTR_Synth, (const byte*)"\x5d\x05" "Synth")
+QDEF(MP_QSTR_set_voice, (const byte*)"\x6e\x09" "set_voice")
+QDEF(MP_QSTR_voice, (const byte*)"\x93\x05" "voice")
+QDEF(MP_QSTR_waveform, (const byte*)"\x36\x08" "waveform")
+QDEF(MP_QSTR_volume, (const byte*)"\x6d\x06" "volume")
+QDEF(MP_QSTR_SINE, (const byte*)"\xf4\x04" "SINE")
+QDEF(MP_QSTR_SAWTOOTH, (const byte*)"\xa8\x08" "SAWTOOTH")
 QDEF(MP_QSTR_bpm, (const byte*)"\xda\x03" "bpm")
 QDEF(MP_QSTR_ticks, (const byte*)"\x43\x05" "ticks")
 QDEF(MP_QSTR_BADDY, (const byte*)"\x9f\x05" "BADDY")
@@ -693,6 +740,18 @@ QDEF(MP_QSTR_miso, (const byte*)"\x9d\x04" "miso")
 QDEF(MP_QSTR_write_readinto, (const byte*)"\x89\x0e" "write_readinto")
 QDEF(MP_QSTR_neopixel, (const byte*)"\x69\x08" "neopixel")
 QDEF(MP_QSTR_NeoPixel, (const byte*)"\x69\x08" "NeoPixel")
+QDEF(MP_QSTR_gradient, (const byte*)"\xa3\x08" "gradient")
+QDEF(MP_QSTR_hsv, (const byte*)"\xa8\x03" "hsv")
+QDEF(MP_QSTR_rotate, (const byte*)"\xdc\x06" "rotate")
+QDEF(MP_QSTR_shift, (const byte*)"\x85\x05" "shift")
+QDEF(MP_QSTR_scale, (const byte*)"\x7d\x05" "scale")
+QDEF(MP_QSTR_from, (const byte*)"\xb3\x04" "from")
+QDEF(MP_QSTR_to, (const byte*)"\x9e\x02" "to")
+QDEF(MP_QSTR_hue, (const byte*)"\x7d\x03" "hue")
+QDEF(MP_QSTR_end_hue, (const byte*)"\x6d\x07" "end_hue")
+QDEF(MP_QSTR_saturation, (const byte*)"\x59\x0a" "saturation")
+QDEF(MP_QSTR_get_brightness, (const byte*)"\x05\x0e" "get_brightness")
+QDEF(MP_QSTR_set_gamma, (const byte*)"\xff\x09" "set_gamma")
 QDEF(MP_QSTR_random, (const byte*)"\xbe\x06" "random")
 QDEF(MP_QSTR_getrandbits, (const byte*)"\x66\x0b" "getrandbits")
 QDEF(MP_QSTR_seed, (const byte*)"\x92\x04" "seed")
@@ -705,6 +764,7 @@ QDEF(MP_QSTR_AudioFrame, (const byte*)"\xae\x0a" "AudioFrame")
 QDEF(MP_QSTR_return_pin, (const byte*)"\x27\x0a" "return_pin")
 QDEF(MP_QSTR_source, (const byte*)"\xb8\x06" "source")
 QDEF(MP_QSTR_copyfrom, (const byte*)"\x56\x08" "copyfrom")
+QDEF(MP_QSTR_ADPCM, (const byte*)"\xde\x05" "ADPCM")
 QDEF(MP_QSTR_os, (const byte*)"\x79\x02" "os")
 QDEF(MP_QSTR_uname, (const byte*)"\xb7\x05" "uname")
 QDEF(MP_QSTR_sysname, (const byte*)"\x9b\x07" "sysname")
@@ -726,12 +786,54 @@ QDEF(MP_QSTR_mouth, (const byte*)"\x6e\x05" "mouth")
 QDEF(MP_QSTR_speed, (const byte*)"\x62\x05" "speed")
 QDEF(MP_QSTR_debug, (const byte*)"\xd4\x05" "debug")
 QDEF(MP_QSTR_translate, (const byte*)"\x43\x09" "translate")
+QDEF(MP_QSTR_render, (const byte*)"\xef\x06" "render")
+QDEF(MP_QSTR_samples, (const byte*)"\x10\x07" "samples")
+QDEF(MP_QSTR_stats, (const byte*)"\xc4\x05" "stats")
+QDEF(MP_QSTR_cache, (const byte*)"\xa9\x05" "cache")
+QDEF(MP_QSTR_save_cache, (const byte*)"\x97\x0a" "save_cache")
+QDEF(MP_QSTR_load_cache, (const byte*)"\x90\x0a" "load_cache")
 QDEF(MP_QSTR_radio, (const byte*)"\xd4\x05" "radio")
 QDEF(MP_QSTR_config, (const byte*)"\x4f\x06" "config")
 QDEF(MP_QSTR_send_bytes, (const byte*)"\xbf\x0a" "send_bytes")
 QDEF(MP_QSTR_receive_bytes, (const byte*)"\x88\x0d" "receive_bytes")
 QDEF(MP_QSTR_receive, (const byte*)"\x4e\x07" "receive")
 QDEF(MP_QSTR_receive_bytes_into, (const byte*)"\x6b\x12" "receive_bytes_into")
+QDEF(MP_QSTR_receive_full, (const byte*)"\x02\x0c" "receive_full")
+QDEF(MP_QSTR_receive_many, (const byte*)"\x2a\x0c" "receive_many")
+QDEF(MP_QSTR_tx_queue, (const byte*)"\x07\x08" "tx_queue")
+QDEF(MP_QSTR_sent, (const byte*)"\xa9\x04" "sent")
+QDEF(MP_QSTR_tx_dropped, (const byte*)"\xae\x0a" "tx_dropped")
+QDEF(MP_QSTR_rx_lost, (const byte*)"\xd4\x07" "rx_lost")
+QDEF(MP_QSTR_received, (const byte*)"\x6a\x08" "received")
+QDEF(MP_QSTR_crc_errors, (const byte*)"\x83\x0a" "crc_errors")
+QDEF(MP_QSTR_rx_dropped, (const byte*)"\xe8\x0a" "rx_dropped")
+QDEF(MP_QSTR_tx_time, (const byte*)"\x03\x07" "tx_time")
+QDEF(MP_QSTR_rssi, (const byte*)"\x7e\x04" "rssi")
+QDEF(MP_QSTR_benchmark, (const byte*)"\xf2\x09" "benchmark")
+QDEF(MP_QSTR_timeout, (const byte*)"\x3e\x07" "timeout")
+QDEF(MP_QSTR_packets, (const byte*)"\xde\x07" "packets")
+QDEF(MP_QSTR_lost, (const byte*)"\xa1\x04" "lost")
+QDEF(MP_QSTR_time, (const byte*)"\xf0\x04" "time")
+QDEF(MP_QSTR_pps, (const byte*)"\xd6\x03" "pps")
+QDEF(MP_QSTR_latency, (const byte*)"\xad\x07" "latency")
+QDEF(MP_QSTR_FLOOD, (const byte*)"\x8b\x05" "FLOOD")
+QDEF(MP_QSTR_SINK, (const byte*)"\xfa\x04" "SINK")
+QDEF(MP_QSTR_PING, (const byte*)"\x15\x04" "PING")
+QDEF(MP_QSTR_ECHO, (const byte*)"\xe4\x04" "ECHO")
+QDEF(MP_QSTR_send_large, (const byte*)"\x7b\x0a" "send_large")
+QDEF(MP_QSTR_receive_large, (const byte*)"\xcc\x0d" "receive_large")
+QDEF(MP_QSTR_large_length, (const byte*)"\x9b\x0c" "large_length")
+QDEF(MP_QSTR_send_reliable, (const byte*)"\xbe\x0d" "send_reliable")
+QDEF(MP_QSTR_node_id, (const byte*)"\x17\x07" "node_id")
+QDEF(MP_QSTR_reliable, (const byte*)"\xfd\x08" "reliable")
+QDEF(MP_QSTR_tx_retries, (const byte*)"\x58\x0a" "tx_retries")
+QDEF(MP_QSTR_tx_failed, (const byte*)"\x35\x09" "tx_failed")
+QDEF(MP_QSTR_tdma, (const byte*)"\x39\x04" "tdma")
+QDEF(MP_QSTR_slot, (const byte*)"\x81\x04" "slot")
+QDEF(MP_QSTR_slot_time, (const byte*)"\x0b\x09" "slot_time")
+QDEF(MP_QSTR_hops, (const byte*)"\x01\x04" "hops")
+QDEF(MP_QSTR_beacons, (const byte*)"\x92\x07" "beacons")
+QDEF(MP_QSTR_synced, (const byte*)"\x03\x06" "synced")
 QDEF(MP_QSTR_length, (const byte*)"\x59\x06" "length")
 QDEF(MP_QSTR_queue, (const byte*)"\x94\x05" "queue")
 QDEF(MP_QSTR_channel, (const byte*)"\x26\x07" "channel")
@@ -739,6 +841,7 @@ QDEF(MP_QSTR_power, (const byte*)"\xda\x05" "power")
 QDEF(MP_QSTR_data_rate, (const byte*)"\xa8\x09" "data_rate")
 QDEF(MP_QSTR_address, (const byte*)"\x73\x07" "address")
 QDEF(MP_QSTR_group, (const byte*)"\xba\x05" "group")
+QDEF(MP_QSTR_addresses, (const byte*)"\x05\x09" "addresses")
 QDEF(MP_QSTR_RATE_250KBIT, (const byte*)"\x7b\x0c" "RATE_250KBIT")
 QDEF(MP_QSTR_RATE_1MBIT, (const byte*)"\xdb\x0a" "RATE_1MBIT")
 QDEF(MP_QSTR_RATE_2MBIT, (const byte*)"\x58\x0a" "RATE_2MBIT")
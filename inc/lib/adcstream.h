@@ -0,0 +1,67 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_ADCSTREAM_H__
+#define __MICROPY_INCLUDED_LIB_ADCSTREAM_H__
+
+/*************************************
+ * Continuous sampling of one analog pin at a steady rate.
+ *
+ * The microsecond clock (see usclock.h) starts each conversion through PPI,
+ * so the samples are evenly spaced however busy the CPU is.  The ADC's END
+ * interrupt collects each result as soon as the conversion finishes; the
+ * nRF51's ADC has no DMA, so that is one short interrupt per sample.
+ * Samples are written into one of two blocks while the other is waiting to
+ * be read.
+ ************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define ADCSTREAM_BLOCK 32
+
+// A 10 bit conversion takes 68us, which must finish before the next starts.
+#define ADCSTREAM_MIN_PERIOD 80
+#define ADCSTREAM_MAX_PERIOD 65535
+
+/** Start sampling the GPIO pin every period_us microseconds.  Returns false
+ * if the pin has no analog input. */
+bool adcstream_start(uint8_t pin, uint32_t period_us);
+
+void adcstream_stop(void);
+
+bool adcstream_running(void);
+
+/** The number of samples lost since sampling started, because blocks weren't
+ * read in time or the clock's interrupt was held off for too long. */
+uint32_t adcstream_overruns(void);
+
+/** Copy the block of ADCSTREAM_BLOCK 10 bit samples that has most recently
+ * been filled and not yet read, returning false if there isn't one.  If
+ * blocks aren't read as fast as they are filled, the older ones are lost.
+ */
+bool adcstream_read(uint16_t *block);
+
+#endif // __MICROPY_INCLUDED_LIB_ADCSTREAM_H__
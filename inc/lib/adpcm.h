@@ -0,0 +1,55 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_ADPCM_H__
+#define __MICROPY_INCLUDED_LIB_ADPCM_H__
+
+/*************************************
+ * IMA-ADPCM (4 bits per sample) decoder.
+ ************************************/
+
+#include <stdint.h>
+
+/* The file header is the two byte magic, followed by the initial
+ * predictor (signed 16 bit, little endian) and the initial step index. */
+#define ADPCM_MAGIC_0 'A'
+#define ADPCM_MAGIC_1 'D'
+#define ADPCM_HEADER_SIZE 6
+#define ADPCM_MAX_INDEX 88
+
+typedef struct _adpcm_state_t {
+    int16_t predictor;
+    uint8_t index;
+} adpcm_state_t;
+
+/** Decode `count` bytes of ADPCM data from `in` into `2*count` unsigned
+ * 8 bit samples in `out`. Low nibble is decoded first.
+ */
+void adpcm_decode(adpcm_state_t *state, const uint8_t *in, uint8_t *out, uint32_t count);
+
+/** Read the state from a header. Returns 0 on success, -1 if the header is invalid. */
+int adpcm_read_header(adpcm_state_t *state, const uint8_t *header);
+
+#endif // __MICROPY_INCLUDED_LIB_ADPCM_H__
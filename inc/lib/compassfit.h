@@ -0,0 +1,94 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_COMPASSFIT_H__
+#define __MICROPY_INCLUDED_LIB_COMPASSFIT_H__
+
+/*************************************
+ * Background compass calibration.
+ * Samples are sorted into buckets by their direction from the current
+ * centre estimate, keeping the latest sample in each, and the normal
+ * equations of a least squares fit of an axis aligned ellipsoid to them
+ * are kept up to date as samples replace each other.  Solving them gives
+ * the hard iron offset (the centre) and the soft iron scale of each axis.
+ * All the arithmetic is done in integers.
+ ************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define COMPASS_FIT_BUCKETS 27
+#define COMPASS_FIT_PARAMS 6
+
+// Scales are in units of 1/COMPASS_FIT_ONE.
+#define COMPASS_FIT_ONE 4096
+
+// The fewest filled buckets that give a usable fit.
+#define COMPASS_FIT_MIN_BUCKETS 14
+
+typedef struct _compass_fit_point_t {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+} compass_fit_point_t;
+
+typedef struct _compass_fit_result_t {
+    int32_t centre[3];
+    int32_t scale[3];
+    int32_t radius;
+    uint16_t error;     // mean distance from the fitted sphere, per mille of the radius
+    uint8_t buckets;    // the number of samples used
+} compass_fit_result_t;
+
+typedef struct _compass_fit_t {
+    compass_fit_point_t points[COMPASS_FIT_BUCKETS];
+    uint32_t filled;    // bit n is set if points[n] holds a sample
+    int32_t centre[3];  // the point the samples are taken relative to
+    int32_t radius;     // the estimated field strength
+    int16_t min[3];     // the extent of all the samples, until the first fit
+    int16_t max[3];
+    compass_fit_point_t last;
+    bool fitted;
+    bool stale;         // the sums need rebuilding about a new centre
+    uint16_t added;     // the number of samples since the last solve
+    // The normal equations: sums[i][j] is the sum of terms i times j, and
+    // sums[i][COMPASS_FIT_PARAMS] the sum of term i times the right hand side.
+    int64_t sums[COMPASS_FIT_PARAMS][COMPASS_FIT_PARAMS + 1];
+} compass_fit_t;
+
+void compass_fit_init(compass_fit_t *fit);
+
+/** Add a sample. This does a constant amount of work, so it can be called
+ * from the ticker.
+ */
+void compass_fit_add(compass_fit_t *fit, int x, int y, int z);
+
+/** Solve the fit and centre it on the new estimate. Returns false if there
+ * aren't enough samples yet, or they don't fit an ellipsoid. Solving takes a
+ * few milliseconds, so it shouldn't be called in an interrupt.
+ */
+bool compass_fit_solve(compass_fit_t *fit, compass_fit_result_t *result);
+
+#endif // __MICROPY_INCLUDED_LIB_COMPASSFIT_H__
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_EDGES_H__
+#define __MICROPY_INCLUDED_LIB_EDGES_H__
+
+/*************************************
+ * Edge counting and timestamping on up to EDGES_CHANNELS pins at once.
+ *
+ * There are EDGES_CHANNELS slots, each a GPIOTE channel whose event is
+ * counted in the GPIOTE interrupt.  PPI also connects the event to a
+ * capture task of the microsecond clock (see usclock.h), so the time of
+ * each edge is taken by the hardware and doesn't depend on how long the
+ * interrupt takes to run.  The times are kept, with the pin's level just
+ * after the edge, in a ring supplied by the caller.
+ *
+ * A pin counting rising or falling edges takes one slot.  A pin counting
+ * both takes two, one for each direction, so that the level comes from
+ * which slot saw the edge rather than reading the pin afterwards, and an
+ * edge can only overwrite the capture of an earlier one in the same
+ * direction.
+ *
+ * Audio uses GPIOTE channels 0 and 1 and PPI channels 1 to 4, so the slots
+ * are GPIOTE channels 2 and 3 and PPI channels 5 and 6.
+ ************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define EDGES_CHANNELS 2
+
+// These match the GPIOTE's polarity settings.
+#define EDGES_RISING 1
+#define EDGES_FALLING 2
+#define EDGES_BOTH 3
+
+// Each entry in the ring is a time in microseconds, which wraps around
+// after 2^31, and EDGES_HIGH if the pin was high just after the edge.
+#define EDGES_HIGH 0x80000000
+#define EDGES_TIME_MASK 0x7fffffff
+
+// Called in the GPIOTE interrupt after each edge is recorded.
+typedef void (*edges_callback_t)(int channel);
+
+/** Start counting the given edges on a GPIO pin, which must already be an
+ * input.  If ring is not NULL, len - 1 times can be kept in it until read.
+ * Returns the channel, or -1 if there aren't enough free slots.
+ */
+int edges_start(uint8_t pin, int edges, uint32_t *ring, size_t len, edges_callback_t callback);
+
+void edges_stop(int channel);
+
+void edges_stop_all(void);
+
+/** The channel counting edges on the pin, or -1 if there isn't one. */
+int edges_channel(uint8_t pin);
+
+uint32_t edges_count(int channel);
+
+/** Copy up to n times out of the ring, oldest first, returning how many
+ * were copied.  Edges that arrive while the ring is full are counted, but
+ * their times are lost. */
+size_t edges_read(int channel, uint32_t *times, size_t n);
+
+#endif // __MICROPY_INCLUDED_LIB_EDGES_H__
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_MOTION_H__
+#define __MICROPY_INCLUDED_LIB_MOTION_H__
+
+/*************************************
+ * Incremental features of an accelerometer stream, for activity tracking.
+ * Each sample costs a square root and a few additions, and every feature
+ * can be read at any time without further work.
+ ************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MOTION_MAX_WINDOW 256
+
+// Peaks closer together than this are too fast to be separate steps.
+#define MOTION_MIN_STEP_MS 250
+
+typedef struct _motion_t {
+    uint16_t window;         // number of samples in the moving window
+    uint16_t count;          // samples in the window so far, up to window
+    uint16_t index;          // where the next sample goes in history
+    uint16_t threshold;      // how far above the mean a peak must rise, in milli-g
+    uint16_t magnitude;      // of the latest sample, in milli-g
+    int8_t side;             // which side of the mean the signal was last seen on
+    bool in_peak;
+    uint16_t peak;           // height of the current or last peak above the mean
+    uint16_t crossings;      // mean crossings in the window
+    uint32_t sum;
+    uint64_t sum_squares;
+    uint32_t peaks;
+    uint32_t steps;
+    uint32_t last_step_ms;
+    // Magnitudes of the samples in the window; the top bit is set for the
+    // ones that crossed the mean.
+    uint16_t history[];
+} motion_t;
+
+#define MOTION_CROSSING 0x8000
+#define MOTION_MAX_MAGNITUDE 0x7fff
+
+/** Clear all features and set the window length, which must be 1 to
+ * MOTION_MAX_WINDOW, and the peak threshold.
+ */
+void motion_init(motion_t *motion, uint16_t window, uint16_t threshold);
+
+/** Add a sample, in milli-g, taken at time `ms`. */
+void motion_update(motion_t *motion, int x, int y, int z, uint32_t ms);
+
+/** The mean and variance of the magnitude over the window. */
+int motion_mean(const motion_t *motion);
+uint32_t motion_variance(const motion_t *motion);
+
+/** How many times a second the magnitude crossed its moving mean during
+ * the window, for samples taken `period_ms` apart.
+ */
+uint32_t motion_crossing_rate(const motion_t *motion, uint32_t period_ms);
+
+#endif // __MICROPY_INCLUDED_LIB_MOTION_H__
@@ -35,38 +35,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "nrf_gpio.h"
 
 
-//These defines are timed specific to a series of if statements and will need to be changed
-//to compensate for different writing algorithms than the one in neopixel.c
-#define NEOPIXEL_SEND_ONE	NRF_GPIO->OUTSET = (1UL << PIN); \
-		__ASM ( \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-			); \
-		NRF_GPIO->OUTCLR = (1UL << PIN); \
-
-#define NEOPIXEL_SEND_ZERO NRF_GPIO->OUTSET = (1UL << PIN); \
-		__ASM (  \
-				" NOP\n\t"  \
-			);  \
-		NRF_GPIO->OUTCLR = (1UL << PIN);  \
-		__ASM ( \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-				" NOP\n\t" \
-			);
-		
 typedef union {
 		struct {
 			uint8_t g, r, b;
@@ -74,18 +42,35 @@ typedef union {
     uint8_t grb[3];
 } color_t;
 
+//The strip is sent through an SPI peripheral running at 4MHz, with each data bit
+//encoded as four SPI bits: 1000 for a zero and 1110 for a one, giving 1us bits
+//with high times of 250ns and 750ns.
+#define NEOPIXEL_SPI				NRF_SPI1
+#define NEOPIXEL_PULSES_PER_BYTE	4
+
 typedef struct _neopixel_strip_t {
 	uint8_t pin_num;
 	uint16_t num_leds;
 	color_t *leds;
+	uint8_t brightness;	//applied when the strip is shown, 255 for full
+	const uint8_t *gamma;	//256 entry table applied before the brightness, or NULL
 } neopixel_strip_t;
 
+extern const uint8_t neopixel_gamma_table[256];
+
+//Set while a strip is clocked out by the SPI peripheral. A low time of 50us
+//latches the LEDs, so the ticker skips its I2C sensor reads, which take about
+//1ms, while this is set.
+extern volatile bool neopixel_sending;
+
 /**
   @brief Initialize GPIO and data location
   @param[in] pointer to Strip structure
 	@param[in] pin number for GPIO
+  @retval 0 Successful initialization
+  @retval 1 The LED structure couldn't be allocated
 */
-void neopixel_init(neopixel_strip_t *strip, uint8_t pin_num, uint16_t num_leds);
+uint8_t neopixel_init(neopixel_strip_t *strip, uint8_t pin_num, uint16_t num_leds);
 	
 /**
   @brief Turn all LEDs off
@@ -94,7 +79,9 @@ void neopixel_init(neopixel_strip_t *strip, uint8_t pin_num, uint16_t num_leds);
 void neopixel_clear(neopixel_strip_t *strip);
 
 /**
-  @brief Update strip with structure data
+  @brief Update strip with structure data. Each byte is encoded into SPI
+  pulses as it is sent, and clocked out by the SPI peripheral with interrupts
+  enabled; an interrupt only stretches the low time between bits.
   @param[in] pointer to Strip structure
 */
 void neopixel_show(neopixel_strip_t *strip);
@@ -124,6 +111,50 @@ uint8_t neopixel_set_color(neopixel_strip_t *strip, uint16_t index, uint8_t red,
 */
 uint8_t neopixel_set_color_and_show(neopixel_strip_t *strip, uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
 
+/**
+  @brief Set LEDs start to stop-1 to one colour
+*/
+void neopixel_fill(neopixel_strip_t *strip, uint16_t start, uint16_t stop, uint8_t red, uint8_t green, uint8_t blue);
+
+/**
+  @brief Fade LEDs start to stop-1 evenly from one colour to another
+  @param[in] from, to: red, green and blue values
+*/
+void neopixel_gradient(neopixel_strip_t *strip, uint16_t start, uint16_t stop, const uint8_t *from, const uint8_t *to);
+
+/**
+  @brief Step LEDs start to stop-1 evenly through the hues from hue to
+  end_hue, in degrees, which may be more than 360 apart to wrap round
+  @param[in] saturation and value from 0 to 255
+*/
+void neopixel_hsv(neopixel_strip_t *strip, uint16_t start, uint16_t stop, int32_t hue, int32_t end_hue, uint8_t saturation, uint8_t value);
+
+/**
+  @brief Move every LED's colour n places along, wrapping round the end of
+  the strip for neopixel_rotate() and turning off the LEDs left behind for
+  neopixel_shift(). Negative n moves towards the start.
+*/
+void neopixel_rotate(neopixel_strip_t *strip, int32_t n);
+void neopixel_shift(neopixel_strip_t *strip, int32_t n);
+
+/**
+  @brief Scale every colour by level/255
+*/
+void neopixel_scale(neopixel_strip_t *strip, uint8_t level);
+
+/**
+  @brief Set the brightness the strip is shown at, from 0 to 255. The stored
+  colours are unchanged.
+*/
+void neopixel_set_brightness(neopixel_strip_t *strip, uint8_t brightness);
+
+/**
+  @brief Set a table mapping each colour value to the level it is shown at,
+  such as neopixel_gamma_table, or NULL to show the values as they are. The
+  table must stay valid while the strip is in use.
+*/
+void neopixel_set_gamma(neopixel_strip_t *strip, const uint8_t *table);
+
 /**
   @brief Clears structure data
   @param[in] pointer to Strip structure
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_ORIENTATION_H__
+#define __MICROPY_INCLUDED_LIB_ORIENTATION_H__
+
+/*************************************
+ * Orientation from the accelerometer and compass, in integers only.
+ * Both vectors are smoothed by a low pass filter, and the heading, pitch,
+ * roll and a quaternion are worked out from them after each update, so
+ * they can be read at any time without further work.
+ *
+ * The device's forward axis is its -y axis, right is -x and down is -z, so
+ * with the device lying face up, pointing its top edge north, all three
+ * angles are 0.
+ ************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Angles are in tenths of a degree.
+#define ORIENTATION_DEGREE 10
+
+// The quaternion's components are in units of 1/ORIENTATION_ONE.
+#define ORIENTATION_ONE 16384
+
+// Each update moves the smoothed vectors 1/2^ORIENTATION_SMOOTHING of the
+// way towards the new sample.
+#define ORIENTATION_SMOOTHING 3
+
+typedef struct _orientation_t {
+    int32_t down[3];        // the smoothed accelerometer, times 256
+    int32_t field[3];       // the smoothed compass, times 256
+    bool started;
+    int16_t heading;        // 0 to 3599, clockwise from north
+    int16_t pitch;          // -900 to 900, positive with the top edge up
+    int16_t roll;           // -1800 to 1800, positive with the right edge down
+    int16_t quaternion[4];  // w, x, y, z, rotating the device's axes to north, east, down
+} orientation_t;
+
+/** Add a sample of the acceleration and the magnetic field, in the
+ * accelerometer's axes, and work out the orientation again.  The first
+ * update after the struct is zeroed starts the filter from the sample.
+ */
+void orientation_update(orientation_t *orientation, const int *accel, const int *field);
+
+#endif // __MICROPY_INCLUDED_LIB_ORIENTATION_H__
@@ -0,0 +1,215 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_RADIO_H__
+#define __MICROPY_INCLUDED_LIB_RADIO_H__
+
+/*************************************
+ * Low level driver for the nRF51 RADIO peripheral, used by the radio module.
+ * Received packets and packets waiting to be sent are kept in rings in a
+ * buffer supplied by the caller, and the RADIO IRQ handler moves packets
+ * between them and the air.
+ ************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RADIO_RSSI_BUCKETS 8
+#define RADIO_MAX_ADDRESSES 8
+
+typedef struct _radio_state_t {
+    uint8_t max_payload;    // 1-251 inclusive
+    uint8_t queue_len;      // 1-254 inclusive
+    uint8_t tx_queue_len;   // 1-254 inclusive
+    uint8_t channel;        // 0-100 inclusive
+    int8_t power_dbm;       // one of: -30, -20, -16, -12, -8, -4, 0, 4
+    uint32_t base0;         // for BASE0 and BASE1 registers
+    uint8_t prefix[RADIO_MAX_ADDRESSES]; // for PREFIX0 and PREFIX1 registers
+    uint8_t num_addresses;  // 1-8 inclusive, how many prefixes to listen to
+    uint8_t data_rate;      // one of: RADIO_MODE_MODE_Nrf_{250Kbit,1Mbit,2Mbit}
+    uint16_t large_len;     // 0-65535 inclusive, 0 to not receive large messages
+    uint16_t node_id;       // identifies this device to reliable senders
+    bool reliable;          // acknowledge reliable packets sent to node_id
+    uint8_t tdma_slots;     // 0 to send whenever, or 2-32 slots per frame
+    uint8_t tdma_slot;      // this device's slot, 0 for the coordinator
+    uint8_t slot_ticks;     // 3-255 ticks of RADIO_TDMA_TICK_MS per slot
+    uint8_t hops;           // 1-16 channels to hop between, 1 not to hop
+} radio_state_t;
+
+// The radio writes the length byte and payload of a received packet directly
+// into one of these, and the metadata is stored just in front of it.
+typedef struct _radio_packet_t {
+    uint32_t ticks;         // when the packet was received
+    int8_t rssi;            // in dBm
+    uint8_t match;          // the logical address it was sent to
+    uint8_t reserved;
+    uint8_t len;            // PACKETPTR points here
+    uint8_t data[];
+} radio_packet_t;
+
+typedef struct _radio_stats_t {
+    uint32_t received;
+    uint32_t crc_errors;
+    uint32_t rx_dropped;    // received with the queue full
+    uint32_t rx_lost;       // receptions cut short by switching to transmit
+    uint32_t sent;
+    uint32_t tx_dropped;    // discarded by radio_deinit(), or sent out of TDMA sync
+    uint32_t tx_time_us;    // time on air of the packets sent
+    uint32_t tx_retries;    // reliable packets sent again for want of an ACK
+    uint32_t tx_failed;     // reliable packets never acknowledged
+    uint32_t beacons;       // TDMA beacons sent or received
+    // received packets by RSSI: bucket n counts -40-8n to -47-8n dBm, and
+    // the first and last buckets also count anything stronger or weaker
+    uint32_t rssi[RADIO_RSSI_BUCKETS];
+} radio_stats_t;
+
+extern radio_stats_t radio_stats;
+
+/** The size of the buffer needed for the given state. */
+size_t radio_buffer_size(const radio_state_t *state);
+
+/** Start the radio listening, keeping packets in `buf`. */
+void radio_init(const radio_state_t *state, uint8_t *buf);
+
+/** Stop the radio. Any packets waiting to be sent are discarded. */
+void radio_deinit(void);
+
+/** Change the channel, power, data rate and addresses. The other parts of
+ * `state` must be unchanged. Waits for queued packets to be sent first. */
+void radio_set_config(const radio_state_t *state);
+
+/** Queue the concatenation of the two buffers to be sent, truncated to the
+ * maximum payload. Only waits if the queue is full. */
+void radio_send(const void *buf, size_t len, const void *buf2, size_t len2);
+
+/** Wait until all queued packets have been sent, or TDMA loses sync. */
+void radio_flush_tx(void);
+
+/** Returns the oldest received packet, or NULL if there are none. The packet
+ * stays in the queue, untouched by the radio, until radio_pop() is called. */
+radio_packet_t *radio_peek(void);
+void radio_pop(void);
+
+/** The driver's own packets start with the bytes 1 and 0, like the radio
+ * module's strings, followed by a type from RADIO_FRAME_FIRST_TYPE up. Those
+ * for features that are turned off are queued like any other packet. */
+#define RADIO_FRAME_FIRST_TYPE      (0x10)
+
+/*************************************
+ * Large messages are sent as a series of fragments, which the IRQ handler
+ * reassembles into a buffer of `large_len` bytes, one message at a time.
+ ************************************/
+
+#define RADIO_LARGE_MAX_FRAGMENTS   (255)
+#define RADIO_LARGE_TIMEOUT_MS      (1000)
+
+/** The largest message that can be sent with the given maximum payload. */
+size_t radio_large_max_len(uint8_t max_payload);
+
+/** Queue the fragments of a large message to be sent, waiting as the queue
+ * fills. The message must be no longer than radio_large_max_len(). */
+void radio_send_large(const void *buf, size_t len);
+
+/** Returns the reassembled large message, or NULL if there isn't one. A
+ * message that has had no fragments for RADIO_LARGE_TIMEOUT_MS is discarded.
+ * The message stays in the buffer until radio_pop_large() is called, and
+ * fragments of other messages are dropped in the meantime. */
+const uint8_t *radio_peek_large(size_t *len);
+void radio_pop_large(void);
+
+/*************************************
+ * Reliable packets are sent to one device, identified by its node_id, which
+ * acknowledges them straight from the IRQ handler. A packet that isn't
+ * acknowledged is sent again after a randomised delay which doubles each
+ * time. Each receiver remembers the last sequence number it saw from its
+ * most recent RADIO_RELIABLE_PEERS senders, to drop repeats.
+ ************************************/
+
+#define RADIO_RELIABLE_PEERS        (8)
+#define RADIO_RELIABLE_RETRIES      (5)
+#define RADIO_RELIABLE_TIMEOUT_MS   (12)
+#define RADIO_RELIABLE_HEADER_LEN   (8)
+
+/** Send a packet to device `to` and wait until it is acknowledged, or
+ * RADIO_RELIABLE_RETRIES retries have failed. Returns true if acknowledged.
+ * Reliable packets have a RADIO_RELIABLE_HEADER_LEN byte header, which comes
+ * out of the maximum payload, and are only sent and received when `reliable` is set. */
+bool radio_send_reliable(uint16_t to, const void *buf, size_t len);
+
+/*************************************
+ * In TDMA mode time is divided into frames of `tdma_slots` slots, and each
+ * device only sends in its own slot. At the start of each frame the
+ * coordinator, in slot 0, sends a beacon with the frame number on `channel`,
+ * and the others time their frames from it. The rest of the frame is sent
+ * on a channel which steps through `hops` channels RADIO_TDMA_HOP_SPACING
+ * apart, one per frame. Slots are timed by radio_tdma_tick(), so a device's
+ * clock may run up to a tick ahead of the coordinator's; a device sends from
+ * the second tick of its slot until the last one, and each packet must take
+ * less than a tick to send. Until a beacon is heard, and after
+ * RADIO_TDMA_LOST_FRAMES frames without one, packets can't be sent and
+ * radio_send() drops them.
+ ************************************/
+
+#define RADIO_TDMA_TICK_MS          (6)
+#define RADIO_TDMA_HOP_SPACING      (23)
+#define RADIO_TDMA_LOST_FRAMES      (8)
+
+/** Advance the TDMA schedule. Must be called every RADIO_TDMA_TICK_MS. */
+void radio_tdma_tick(void);
+
+/** Returns true if TDMA is off, or the schedule is synchronised. */
+bool radio_tdma_synced(void);
+
+/*************************************
+ * Benchmarks, run between two devices. The `poll` function is called while
+ * waiting, and returning false from it stops the benchmark.
+ ************************************/
+
+typedef struct _radio_bench_result_t {
+    uint32_t packets;       // sent by FLOOD and PING, received by SINK and ECHO
+    uint32_t received;      // packets received back by PING, or by SINK
+    uint32_t lost;          // gaps in the sequence numbers seen by SINK
+    uint32_t time_ms;       // from the first packet to the last
+    uint32_t rtt_ms;        // total round trip time of PING's replies
+} radio_bench_result_t;
+
+/** Benchmark packets are padded to at least this length, so the maximum
+ * payload must be at least this long. */
+#define RADIO_BENCH_HEADER_LEN      (7)
+
+/** Send `count` packets of `len` bytes as fast as possible. */
+void radio_bench_flood(uint32_t count, uint8_t len, radio_bench_result_t *result, bool (*poll)(void));
+
+/** Count FLOOD packets until none arrive for `timeout_ms`. */
+void radio_bench_sink(uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void));
+
+/** Send `count` pings of `len` bytes one at a time, waiting up to `timeout_ms` for each reply. */
+void radio_bench_ping(uint32_t count, uint8_t len, uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void));
+
+/** Reply to pings until none arrive for `timeout_ms`. */
+void radio_bench_echo(uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void));
+
+#endif // __MICROPY_INCLUDED_LIB_RADIO_H__
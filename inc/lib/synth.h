@@ -0,0 +1,80 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_SYNTH_H__
+#define __MICROPY_INCLUDED_LIB_SYNTH_H__
+
+/*************************************
+ * Wavetable synthesizer for compiled music tunes.
+ * Mixes up to SYNTH_MAX_VOICES voices into unsigned 8 bit samples
+ * at the audio module's rate of 7812.5 samples per second.
+ ************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SYNTH_MAX_VOICES 4
+#define SYNTH_LOG_WAVE_SIZE 5
+#define SYNTH_WAVE_SIZE (1<<SYNTH_LOG_WAVE_SIZE)
+#define SYNTH_MAX_VOLUME 255
+
+// Must match ARTICULATION_MS in microbitmusic.cpp
+#define SYNTH_ARTICULATION_MS 10
+
+enum {
+    SYNTH_WAVE_SQUARE,
+    SYNTH_WAVE_SINE,
+    SYNTH_WAVE_TRIANGLE,
+    SYNTH_WAVE_SAWTOOTH,
+    SYNTH_WAVE_COUNT,
+};
+
+/* One note of a tune, as compiled by the music module. */
+typedef struct _synth_event_t {
+    uint16_t period_us; // 0 for a rest
+    uint16_t ticks;
+} synth_event_t;
+
+typedef struct _synth_voice_t {
+    const synth_event_t *events;
+    uint16_t len;
+    uint16_t index;     // next event to play
+    uint32_t phase;
+    uint32_t phase_inc; // 0 when silent
+    uint32_t remaining; // samples left of the current note or gap
+    uint8_t waveform;
+    uint8_t volume;
+    bool articulate;    // a gap follows the current note
+} synth_voice_t;
+
+/** Set a voice to play `len` events from the start. Waveform and volume are unchanged. */
+void synth_voice_start(synth_voice_t *voice, const synth_event_t *events, uint16_t len);
+
+/** Mix `n` samples of the voices into `out`. Returns the number of voices
+ * that are still playing; once it is 0 the rest of `out` is silence.
+ */
+unsigned int synth_render(synth_voice_t *voices, unsigned int voice_count, uint16_t ms_per_tick, uint8_t *out, unsigned int n);
+
+#endif // __MICROPY_INCLUDED_LIB_SYNTH_H__
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef __MICROPY_INCLUDED_LIB_USCLOCK_H__
+#define __MICROPY_INCLUDED_LIB_USCLOCK_H__
+
+/*************************************
+ * A free running microsecond clock on TIMER2, shared by edge capture and
+ * analog sampling, and only kept running while one of them is using it.
+ *
+ * The timer is 16 bits wide.  CC[0] and CC[1] are left for PPI to capture
+ * into, CC[2] can call back at a given time, and CC[3] catches the timer
+ * wrapping, which is counted to give times up to 31 bits long.
+ ************************************/
+
+#include <stdint.h>
+#include "nrf.h"
+
+#define USCLOCK NRF_TIMER2
+
+// The clock's interrupt priority, which anything extending its captures
+// must share.  It is above the ticker's, so that captures are read soon
+// after they are taken, before later ones overwrite them.
+#define USCLOCK_PRIORITY 0
+
+#define USCLOCK_TIME_MASK 0x7fffffff
+
+/** Called from the clock's interrupt when CC[2] is reached.  Returns the
+ * time in microseconds, less than 65536, until it is to be called again,
+ * or 0 to stop.  The next time is counted from when CC[2] was reached, so
+ * the calls keep to a steady rate.  If the interrupt runs so late that the
+ * next time has already passed, the times that were missed are skipped,
+ * and `missed` says how many at the next call. */
+typedef uint32_t (*usclock_callback_t)(uint32_t missed);
+
+/** Start and stop using the clock.  Calls are counted, so the clock runs
+ * until each start has been matched by a stop. */
+void usclock_start(void);
+void usclock_stop(void);
+
+/** The full time of a value captured from the clock.  Only call this in an
+ * interrupt at USCLOCK_PRIORITY, shortly after the capture. */
+uint32_t usclock_extend(uint32_t captured);
+
+/** The current time, from anywhere, while the clock is running. */
+uint32_t usclock_now(void);
+
+void usclock_set_callback(usclock_callback_t callback, uint32_t delay_us);
+void usclock_clear_callback(void);
+
+#endif // __MICROPY_INCLUDED_LIB_USCLOCK_H__
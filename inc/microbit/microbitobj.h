@@ -47,6 +47,13 @@ extern bool microbit_button_is_pressed(const struct _microbit_button_obj_t *butt
 
 extern void microbit_accelerometer_get_values(const struct _microbit_accelerometer_obj_t *acc, int *x, int *y, int *z);
 
+extern void microbit_compass_get_values(const struct _microbit_compass_obj_t *compass, int *x, int *y, int *z);
+
+/** Store n values into the elements of the writable buffer buf_in, in its
+ * element type, and return it. Raises ValueError if it is too small.
+ */
+extern mp_obj_t microbit_obj_store_values(mp_obj_t buf_in, const int *values, size_t n);
+
 }
 
 #endif // __MICROPY_INCLUDED_MICROBIT_MICROBITOBJ_H__
@@ -56,6 +56,8 @@ extern const microbit_pinmode_t microbit_pinmodes[];
 #define MODE_I2C 9
 #define MODE_SPI 10
 #define MODE_WRITE_ANALOG 11
+#define MODE_EDGES 12
+#define MODE_READ_ANALOG 13
 
 #define microbit_pin_mode_unused        (&microbit_pinmodes[MODE_UNUSED])
 #define microbit_pin_mode_write_analog  (&microbit_pinmodes[MODE_WRITE_ANALOG])
@@ -68,6 +70,11 @@ extern const microbit_pinmode_t microbit_pinmodes[];
 #define microbit_pin_mode_touch         (&microbit_pinmodes[MODE_TOUCH])
 #define microbit_pin_mode_i2c           (&microbit_pinmodes[MODE_I2C])
 #define microbit_pin_mode_spi           (&microbit_pinmodes[MODE_SPI])
+#define microbit_pin_mode_edges         (&microbit_pinmodes[MODE_EDGES])
+#define microbit_pin_mode_read_analog   (&microbit_pinmodes[MODE_READ_ANALOG])
+
+// The low priority callback that calls the handlers for edges on pins.
+#define PIN_EDGES_CALLBACK_ID 1
 
 /** Can this pin be acquired? Safe to call in an interrupt. Not safe to call in an interrupt. */
 void microbit_obj_pin_fail_if_cant_acquire(const microbit_pin_obj_t *pin);
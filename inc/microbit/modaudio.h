@@ -20,6 +20,7 @@ typedef struct _microbit_audio_frame_obj_t {
 } microbit_audio_frame_obj_t;
 
 extern const mp_obj_type_t microbit_audio_frame_type;
+extern const mp_obj_type_t microbit_adpcm_source_type;
 
 bool microbit_audio_is_playing(void);
 
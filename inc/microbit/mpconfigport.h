@@ -127,10 +127,16 @@ extern const struct _mp_obj_module_t speech_module;
     void *audio_buffer; \
     void *audio_source; \
     void *speech_data; \
+    struct _speech_cache_t *speech_cache; \
     const struct _pwm_events *pwm_active_events; \
     const struct _pwm_events *pwm_pending_events; \
     struct _compass_calibration_t *compass_calibration_data; \
+    struct _compass_fit_t *compass_fit; \
+    struct _orientation_t *orientation; \
+    struct _pin_edges_t *pin_edges[2]; \
     struct _music_data_t *music_data; \
+    struct _accelerometer_sampler_t *accelerometer_sampler; \
+    struct _motion_t *accelerometer_motion; \
 
 // We need to provide a declaration/definition of alloca()
 #include <alloca.h>
@@ -11,6 +11,9 @@ Q(sleep)
 Q(running_time)
 Q(panic)
 Q(temperature)
+Q(read_sensors)
+Q(orientation)
+Q(into)
 
 Q(this)
 Q(authors)
@@ -63,6 +66,24 @@ Q(set_pull)
 Q(PULL_UP)
 Q(PULL_DOWN)
 Q(NO_PULL)
+Q(RISING)
+Q(FALLING)
+Q(BOTH)
+Q(start_counting)
+Q(stop_counting)
+Q(edge_count)
+Q(read_edges)
+Q(edges)
+Q(handler)
+Q(time_pulse_us)
+Q(time_period_us)
+Q(level)
+Q(timeout_us)
+Q(read_analog_into)
+Q(read_analog_frames)
+Q(analog_overruns)
+Q(underruns)
+Q(rate)
 
 Q(MicroBitImage)
 Q(Image)
@@ -196,6 +217,22 @@ Q(3g)
 Q(6g)
 Q(8g)
 Q(shake)
+Q(start_sampling)
+Q(stop_sampling)
+Q(read_samples)
+Q(overruns)
+Q(period)
+Q(start_tracking)
+Q(stop_tracking)
+Q(window)
+Q(threshold)
+Q(get_magnitude)
+Q(get_mean)
+Q(get_variance)
+Q(get_crossing_rate)
+Q(get_peak)
+Q(get_peaks)
+Q(get_steps)
 
 Q(MicroBitCompass)
 Q(compass)
@@ -212,6 +249,7 @@ Q(set_calibration)
 Q(get_values)
 Q(start_calibrating)
 Q(stop_calibrating)
+Q(auto_calibrate)
 
 Q(MicroBitI2C)
 Q(i2c)
@@ -233,6 +271,17 @@ Q(pin)
 Q(play)
 Q(set_tempo)
 Q(get_tempo)
+Q(compile)
+Q(Tune)
+Q(Synth)
+Q(set_voice)
+Q(voice)
+Q(waveform)
+Q(volume)
+Q(SQUARE)
+Q(SINE)
+Q(TRIANGLE)
+Q(SAWTOOTH)
 Q(bpm)
 Q(ticks)
 Q(BADDY)
@@ -403,6 +452,18 @@ Q(neopixel)
 Q(NeoPixel)
 Q(clear)
 Q(show)
+Q(gradient)
+Q(hsv)
+Q(rotate)
+Q(shift)
+Q(scale)
+Q(from)
+Q(to)
+Q(hue)
+Q(end_hue)
+Q(saturation)
+Q(get_brightness)
+Q(set_gamma)
 
 Q(random)
 Q(getrandbits)
@@ -419,6 +480,7 @@ Q(pin)
 Q(return_pin)
 Q(source)
 Q(copyfrom)
+Q(ADPCM)
 
 Q(name)
 
@@ -452,6 +514,12 @@ Q(mouth)
 Q(speed)
 Q(debug)
 Q(translate)
+Q(render)
+Q(samples)
+Q(stats)
+Q(cache)
+Q(save_cache)
+Q(load_cache)
 
 Q(radio)
 Q(reset)
@@ -463,6 +531,42 @@ Q(receive_bytes)
 Q(send)
 Q(receive)
 Q(receive_bytes_into)
+Q(receive_full)
+Q(receive_many)
+Q(tx_queue)
+Q(sent)
+Q(tx_dropped)
+Q(rx_lost)
+Q(received)
+Q(crc_errors)
+Q(rx_dropped)
+Q(tx_time)
+Q(rssi)
+Q(benchmark)
+Q(timeout)
+Q(packets)
+Q(lost)
+Q(time)
+Q(pps)
+Q(latency)
+Q(FLOOD)
+Q(SINK)
+Q(PING)
+Q(ECHO)
+Q(send_large)
+Q(receive_large)
+Q(large_length)
+Q(send_reliable)
+Q(node_id)
+Q(reliable)
+Q(tx_retries)
+Q(tx_failed)
+Q(tdma)
+Q(slot)
+Q(slot_time)
+Q(hops)
+Q(beacons)
+Q(synced)
 Q(length)
 Q(queue)
 Q(channel)
@@ -470,6 +574,7 @@ Q(power)
 Q(data_rate)
 Q(address)
 Q(group)
+Q(addresses)
 Q(RATE_250KBIT)
 Q(RATE_1MBIT)
 Q(RATE_2MBIT)
@@ -0,0 +1,148 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include "nrf.h"
+#include "lib/adcstream.h"
+#include "lib/usclock.h"
+
+// Edges use PPI channels 5 and 6.
+#define PPI_CHANNEL 7
+
+static volatile bool running = false;
+static uint32_t period;
+static volatile uint16_t samples[2][ADCSTREAM_BLOCK];
+static volatile uint8_t writing;
+static volatile uint8_t position;
+// At most one block is ready at a time; the other is being filled.
+static volatile bool ready;
+static volatile uint32_t overruns;
+
+// The analog input of each GPIO pin, or -1.
+static int analog_input(uint8_t pin) {
+    if (pin >= 1 && pin <= 6) {
+        return pin + 1;
+    }
+    if (pin == 26 || pin == 27) {
+        return pin - 26;
+    }
+    return -1;
+}
+
+static uint32_t adcstream_sample(uint32_t missed) {
+    // The compare event has already started the conversion through PPI,
+    // but no conversions were started at the times that were missed.
+    overruns += missed;
+    return period;
+}
+
+void ADC_IRQHandler(void) {
+    if (!NRF_ADC->EVENTS_END) {
+        return;
+    }
+    NRF_ADC->EVENTS_END = 0;
+    samples[writing][position] = NRF_ADC->RESULT;
+    if (++position == ADCSTREAM_BLOCK) {
+        position = 0;
+        // A block that is still waiting is too old now, and is overwritten.
+        if (ready) {
+            overruns += ADCSTREAM_BLOCK;
+        }
+        ready = true;
+        writing ^= 1;
+    }
+}
+
+bool adcstream_start(uint8_t pin, uint32_t period_us) {
+    int input = analog_input(pin);
+    if (input < 0) {
+        return false;
+    }
+    adcstream_stop();
+    NRF_ADC->ENABLE = ADC_ENABLE_ENABLE_Enabled;
+    NRF_ADC->CONFIG = (ADC_CONFIG_RES_10bit << ADC_CONFIG_RES_Pos) |
+                      (ADC_CONFIG_INPSEL_AnalogInputOneThirdPrescaling << ADC_CONFIG_INPSEL_Pos) |
+                      (ADC_CONFIG_REFSEL_SupplyOneThirdPrescaling << ADC_CONFIG_REFSEL_Pos) |
+                      ((1 << input) << ADC_CONFIG_PSEL_Pos) |
+                      (ADC_CONFIG_EXTREFSEL_None << ADC_CONFIG_EXTREFSEL_Pos);
+    NRF_ADC->EVENTS_END = 0;
+    NRF_ADC->INTENSET = ADC_INTENSET_END_Msk;
+    NVIC_ClearPendingIRQ(ADC_IRQn);
+    NVIC_SetPriority(ADC_IRQn, USCLOCK_PRIORITY);
+    NVIC_EnableIRQ(ADC_IRQn);
+    period = period_us;
+    writing = 0;
+    position = 0;
+    ready = false;
+    overruns = 0;
+    running = true;
+    usclock_start();
+    NRF_PPI->CH[PPI_CHANNEL].EEP = (uint32_t)&USCLOCK->EVENTS_COMPARE[2];
+    NRF_PPI->CH[PPI_CHANNEL].TEP = (uint32_t)&NRF_ADC->TASKS_START;
+    NRF_PPI->CHENSET = 1 << PPI_CHANNEL;
+    usclock_set_callback(adcstream_sample, period_us);
+    return true;
+}
+
+void adcstream_stop(void) {
+    if (!running) {
+        return;
+    }
+    usclock_clear_callback();
+    NRF_PPI->CHENCLR = 1 << PPI_CHANNEL;
+    usclock_stop();
+    while (NRF_ADC->BUSY) {
+    }
+    NVIC_DisableIRQ(ADC_IRQn);
+    NRF_ADC->INTENCLR = ADC_INTENCLR_END_Msk;
+    NRF_ADC->EVENTS_END = 0;
+    NRF_ADC->ENABLE = ADC_ENABLE_ENABLE_Disabled;
+    running = false;
+}
+
+bool adcstream_running(void) {
+    return running;
+}
+
+uint32_t adcstream_overruns(void) {
+    return overruns;
+}
+
+bool adcstream_read(uint16_t *block) {
+    bool copied = false;
+    // The block must not change half way through the copy.
+    __disable_irq();
+    if (ready) {
+        const volatile uint16_t *filled = samples[writing ^ 1];
+        for (int i = 0; i < ADCSTREAM_BLOCK; i++) {
+            block[i] = filled[i];
+        }
+        ready = false;
+        copied = true;
+    }
+    __enable_irq();
+    return copied;
+}
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "lib/adpcm.h"
+
+static const int16_t step_table[ADPCM_MAX_INDEX+1] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t index_table[8] = {
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+int adpcm_read_header(adpcm_state_t *state, const uint8_t *header) {
+    if (header[0] != ADPCM_MAGIC_0 || header[1] != ADPCM_MAGIC_1 || header[4] > ADPCM_MAX_INDEX) {
+        return -1;
+    }
+    state->predictor = (int16_t)(header[2] | (header[3] << 8));
+    state->index = header[4];
+    return 0;
+}
+
+/* Kept as plain integer shifts and adds; the Cortex-M0 has no divider,
+ * and this runs in the audio fetcher callback. */
+static inline uint8_t decode_nibble(int32_t *predictor, int32_t *index, uint32_t nibble) {
+    int32_t step = step_table[*index];
+    int32_t diff = step >> 3;
+    if (nibble & 4) {
+        diff += step;
+    }
+    if (nibble & 2) {
+        diff += step >> 1;
+    }
+    if (nibble & 1) {
+        diff += step >> 2;
+    }
+    int32_t pred = *predictor;
+    if (nibble & 8) {
+        pred -= diff;
+        if (pred < -32768) {
+            pred = -32768;
+        }
+    } else {
+        pred += diff;
+        if (pred > 32767) {
+            pred = 32767;
+        }
+    }
+    *predictor = pred;
+    int32_t idx = *index + index_table[nibble & 7];
+    if (idx < 0) {
+        idx = 0;
+    } else if (idx > ADPCM_MAX_INDEX) {
+        idx = ADPCM_MAX_INDEX;
+    }
+    *index = idx;
+    return (uint8_t)((pred >> 8) + 128);
+}
+
+void adpcm_decode(adpcm_state_t *state, const uint8_t *in, uint8_t *out, uint32_t count) {
+    int32_t predictor = state->predictor;
+    int32_t index = state->index;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t byte = in[i];
+        out[0] = decode_nibble(&predictor, &index, byte & 15);
+        out[1] = decode_nibble(&predictor, &index, byte >> 4);
+        out += 2;
+    }
+    state->predictor = predictor;
+    state->index = index;
+}
@@ -0,0 +1,373 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "lib/compassfit.h"
+
+/* The samples are scaled so that the field is about UNIT long, which keeps
+ * the sums of the fourth powers well inside 64 bits.  The model is
+ *     a u^2 + b v^2 + c w^2 + d UNIT u + e UNIT v + f UNIT w = UNIT^2
+ * so all the parameters are about 1 once the fit has settled.
+ */
+#define UNIT 128
+#define MAX_TERM (8 * UNIT)
+#define RHS (UNIT * UNIT)
+
+// The solution is found in fixed point with this many fractional bits.
+#define FRAC_BITS 24
+
+static uint32_t isqrt(uint64_t x) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static void terms(const compass_fit_t *fit, const compass_fit_point_t *point, int32_t *t) {
+    int32_t p[3] = {point->x, point->y, point->z};
+    for (int i = 0; i < 3; i++) {
+        int32_t u = (int64_t)(p[i] - fit->centre[i]) * UNIT / fit->radius;
+        if (u > MAX_TERM) {
+            u = MAX_TERM;
+        } else if (u < -MAX_TERM) {
+            u = -MAX_TERM;
+        }
+        t[i] = u * u;
+        t[i + 3] = UNIT * u;
+    }
+}
+
+// Add or remove a sample's terms from the upper half of the normal equations.
+static void accumulate(compass_fit_t *fit, const compass_fit_point_t *point, int sign) {
+    int32_t t[COMPASS_FIT_PARAMS];
+    terms(fit, point, t);
+    for (int i = 0; i < COMPASS_FIT_PARAMS; i++) {
+        int64_t ti = sign * t[i];
+        for (int j = i; j < COMPASS_FIT_PARAMS; j++) {
+            fit->sums[i][j] += ti * t[j];
+        }
+        fit->sums[i][COMPASS_FIT_PARAMS] += ti * RHS;
+    }
+}
+
+/* The bucket is the direction from the centre, with each axis rounded to
+ * -1, 0 or 1 relative to the largest.  That gives 26 directions spread over
+ * the sphere; the middle bucket is never used.
+ */
+static int bucket(const compass_fit_t *fit, const compass_fit_point_t *point) {
+    int32_t d[3] = {point->x - fit->centre[0], point->y - fit->centre[1], point->z - fit->centre[2]};
+    int32_t max = 0;
+    for (int i = 0; i < 3; i++) {
+        int32_t a = d[i] < 0 ? -d[i] : d[i];
+        if (a > max) {
+            max = a;
+        }
+    }
+    if (max == 0 || (fit->fitted && max < fit->radius / 4)) {
+        // Too close to the centre to tell the direction.
+        return -1;
+    }
+    int index = 0;
+    for (int i = 0; i < 3; i++) {
+        index = index * 3 + (d[i] > max / 2 ? 2 : d[i] < -max / 2 ? 0 : 1);
+    }
+    return index;
+}
+
+// Sort the samples into buckets again about the current centre, and sum
+// the equations afresh.
+static void rebuild(compass_fit_t *fit) {
+    compass_fit_point_t points[COMPASS_FIT_BUCKETS];
+    uint32_t filled = fit->filled;
+    memcpy(points, fit->points, sizeof(points));
+    fit->filled = 0;
+    for (int i = 0; i < COMPASS_FIT_BUCKETS; i++) {
+        if (filled & (1UL << i)) {
+            int index = bucket(fit, &points[i]);
+            if (index >= 0) {
+                fit->points[index] = points[i];
+                fit->filled |= 1UL << index;
+            }
+        }
+    }
+    memset(fit->sums, 0, sizeof(fit->sums));
+    for (int i = 0; i < COMPASS_FIT_BUCKETS; i++) {
+        if (fit->filled & (1UL << i)) {
+            accumulate(fit, &fit->points[i], 1);
+        }
+    }
+    fit->stale = false;
+}
+
+// Whether there are samples from both ends of every axis, without which
+// the size of the ellipsoid along that axis can't be told.
+static bool surrounded(uint32_t filled) {
+    for (int weight = 1; weight <= 9; weight *= 3) {
+        bool low = false;
+        bool high = false;
+        for (int i = 0; i < COMPASS_FIT_BUCKETS; i++) {
+            if (filled & (1UL << i)) {
+                low |= (i / weight) % 3 == 0;
+                high |= (i / weight) % 3 == 2;
+            }
+        }
+        if (!low || !high) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void compass_fit_init(compass_fit_t *fit) {
+    memset(fit, 0, sizeof(*fit));
+    fit->radius = 1;
+    fit->stale = true;
+    for (int i = 0; i < 3; i++) {
+        fit->min[i] = INT16_MAX;
+        fit->max[i] = INT16_MIN;
+    }
+}
+
+void compass_fit_add(compass_fit_t *fit, int x, int y, int z) {
+    compass_fit_point_t point = {x, y, z};
+    if (memcmp(&point, &fit->last, sizeof(point)) == 0) {
+        // The compass hasn't taken a new sample.
+        return;
+    }
+    fit->last = point;
+    if (!fit->fitted) {
+        // Until there is a fit, centre on the middle of the samples so far.
+        int16_t p[3] = {point.x, point.y, point.z};
+        int32_t radius = 1;
+        for (int i = 0; i < 3; i++) {
+            if (p[i] < fit->min[i]) {
+                fit->min[i] = p[i];
+            }
+            if (p[i] > fit->max[i]) {
+                fit->max[i] = p[i];
+            }
+            int32_t centre = (fit->min[i] + fit->max[i]) / 2;
+            if (centre != fit->centre[i]) {
+                fit->centre[i] = centre;
+                fit->stale = true;
+            }
+            if ((fit->max[i] - fit->min[i]) / 2 > radius) {
+                radius = (fit->max[i] - fit->min[i]) / 2;
+            }
+        }
+        if (radius != fit->radius) {
+            fit->radius = radius;
+            fit->stale = true;
+        }
+    }
+    int index = bucket(fit, &point);
+    if (index < 0) {
+        return;
+    }
+    uint32_t bit = 1UL << index;
+    if (!fit->stale && (fit->filled & bit)) {
+        accumulate(fit, &fit->points[index], -1);
+    }
+    fit->points[index] = point;
+    fit->filled |= bit;
+    if (!fit->stale) {
+        accumulate(fit, &point, 1);
+    }
+    if (fit->added < UINT16_MAX) {
+        fit->added++;
+    }
+}
+
+// Scale a row of the equations so that its largest entry has 30 bits.
+static void normalise(int64_t *row) {
+    int64_t max = 0;
+    for (int k = 0; k <= COMPASS_FIT_PARAMS; k++) {
+        int64_t a = row[k] < 0 ? -row[k] : row[k];
+        if (a > max) {
+            max = a;
+        }
+    }
+    if (max == 0) {
+        return;
+    }
+    int bits = 0;
+    while ((max >> bits) != 0) {
+        bits++;
+    }
+    for (int k = 0; k <= COMPASS_FIT_PARAMS; k++) {
+        if (bits > 30) {
+            row[k] /= 1LL << (bits - 30);
+        } else {
+            row[k] *= 1LL << (30 - bits);
+        }
+    }
+}
+
+// Solve the normal equations by Gaussian elimination, giving the
+// parameters with FRAC_BITS fractional bits.
+static bool solve(const compass_fit_t *fit, int64_t *params) {
+    int64_t a[COMPASS_FIT_PARAMS][COMPASS_FIT_PARAMS + 1];
+    for (int i = 0; i < COMPASS_FIT_PARAMS; i++) {
+        for (int j = 0; j <= COMPASS_FIT_PARAMS; j++) {
+            a[i][j] = j < i ? fit->sums[j][i] : fit->sums[i][j];
+        }
+    }
+    for (int col = 0; col < COMPASS_FIT_PARAMS; col++) {
+        // Once the rows are normalised, the largest pivot keeps every
+        // multiplier at most 1, so nothing below can overflow.
+        int pivot = col;
+        for (int r = col; r < COMPASS_FIT_PARAMS; r++) {
+            normalise(a[r]);
+            int64_t v = a[r][col] < 0 ? -a[r][col] : a[r][col];
+            int64_t p = a[pivot][col] < 0 ? -a[pivot][col] : a[pivot][col];
+            if (v > p) {
+                pivot = r;
+            }
+        }
+        if (a[pivot][col] == 0) {
+            return false;
+        }
+        if (pivot != col) {
+            int64_t tmp[COMPASS_FIT_PARAMS + 1];
+            memcpy(tmp, a[col], sizeof(tmp));
+            memcpy(a[col], a[pivot], sizeof(tmp));
+            memcpy(a[pivot], tmp, sizeof(tmp));
+        }
+        for (int r = col + 1; r < COMPASS_FIT_PARAMS; r++) {
+            int64_t f = a[r][col];
+            for (int k = col + 1; k <= COMPASS_FIT_PARAMS; k++) {
+                a[r][k] -= a[col][k] * f / a[col][col];
+            }
+            a[r][col] = 0;
+        }
+    }
+    for (int r = COMPASS_FIT_PARAMS - 1; r >= 0; r--) {
+        int64_t sum = a[r][COMPASS_FIT_PARAMS] * (1LL << FRAC_BITS);
+        for (int k = r + 1; k < COMPASS_FIT_PARAMS; k++) {
+            sum -= a[r][k] * params[k];
+        }
+        params[r] = sum / a[r][r];
+        if (params[r] > (1LL << (FRAC_BITS + 6)) || params[r] < -(1LL << (FRAC_BITS + 6))) {
+            // Far from anything a compass could produce.
+            return false;
+        }
+    }
+    return true;
+}
+
+bool compass_fit_solve(compass_fit_t *fit, compass_fit_result_t *result) {
+    if (fit->stale) {
+        rebuild(fit);
+    }
+    int buckets = 0;
+    for (int i = 0; i < COMPASS_FIT_BUCKETS; i++) {
+        buckets += (fit->filled >> i) & 1;
+    }
+    if (buckets < COMPASS_FIT_MIN_BUCKETS || !surrounded(fit->filled)) {
+        return false;
+    }
+    fit->added = 0;
+    int64_t params[COMPASS_FIT_PARAMS];
+    if (!solve(fit, params)) {
+        return false;
+    }
+
+    // Complete the squares to find the centre and the radius along each axis.
+    int64_t offset[3];
+    int64_t rhs = RHS;
+    for (int i = 0; i < 3; i++) {
+        if (params[i] <= 0) {
+            return false;
+        }
+        offset[i] = -params[i + 3] * (UNIT / 2) / params[i];
+        if (offset[i] > 4 * UNIT || offset[i] < -4 * UNIT) {
+            return false;
+        }
+        rhs += (params[i] * offset[i] * offset[i]) >> FRAC_BITS;
+    }
+    int32_t radius[3];
+    int32_t mean = 0;
+    for (int i = 0; i < 3; i++) {
+        radius[i] = isqrt((uint64_t)rhs * (1ULL << FRAC_BITS) / params[i]);
+        if (radius[i] == 0) {
+            return false;
+        }
+        mean += radius[i];
+    }
+    mean /= 3;
+    for (int i = 0; i < 3; i++) {
+        result->scale[i] = mean * COMPASS_FIT_ONE / radius[i];
+        if (result->scale[i] < COMPASS_FIT_ONE / 2 || result->scale[i] > COMPASS_FIT_ONE * 2) {
+            return false;
+        }
+        result->centre[i] = fit->centre[i] + offset[i] * fit->radius / UNIT;
+    }
+    result->radius = mean * fit->radius / UNIT;
+    if (result->radius < 1) {
+        return false;
+    }
+
+    // Measure how well the corrected samples lie on a sphere.
+    uint32_t total = 0;
+    for (int i = 0; i < COMPASS_FIT_BUCKETS; i++) {
+        if ((fit->filled & (1UL << i)) == 0) {
+            continue;
+        }
+        int32_t p[3] = {fit->points[i].x, fit->points[i].y, fit->points[i].z};
+        uint64_t sum = 0;
+        for (int j = 0; j < 3; j++) {
+            int64_t d = (int64_t)(p[j] - result->centre[j]) * result->scale[j] / COMPASS_FIT_ONE;
+            sum += d * d;
+        }
+        int32_t error = (int32_t)isqrt(sum) - result->radius;
+        total += error < 0 ? -error : error;
+    }
+    uint32_t error = total * 1000 / ((uint32_t)buckets * result->radius);
+    result->error = error > UINT16_MAX ? UINT16_MAX : error;
+    result->buckets = buckets;
+
+    // Take the samples relative to the new estimate from now on, so that
+    // the next solve refines it.
+    for (int i = 0; i < 3; i++) {
+        fit->centre[i] = result->centre[i];
+    }
+    fit->radius = result->radius;
+    fit->fitted = true;
+    rebuild(fit);
+    return true;
+}
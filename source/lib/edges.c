@@ -0,0 +1,202 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "nrf_gpio.h"
+#include "nrf_gpiote.h"
+#include "lib/edges.h"
+#include "lib/usclock.h"
+
+// Slot n is GPIOTE channel FIRST_GPIOTE_CHANNEL + n, whose events PPI channel
+// FIRST_PPI_CHANNEL + n turns into captures of the clock into CC[n].
+#define FIRST_GPIOTE_CHANNEL 2
+#define FIRST_PPI_CHANNEL 5
+
+typedef struct _edges_channel_t {
+    bool active;
+    bool both;  // rising edges on this channel's slot, falling ones on the next
+    uint8_t pin;
+    volatile uint32_t count;
+    uint32_t *ring;
+    uint16_t len;
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    edges_callback_t callback;
+} edges_channel_t;
+
+static edges_channel_t channels[EDGES_CHANNELS];
+
+// The channel using each slot, or NULL, and the pin's level after its edges.
+static edges_channel_t *slots[EDGES_CHANNELS];
+static uint32_t slot_level[EDGES_CHANNELS];
+
+static void edges_record(int slot, uint32_t time) {
+    edges_channel_t *channel = slots[slot];
+    if (channel == NULL) {
+        return;
+    }
+    channel->count++;
+    if (channel->ring != NULL) {
+        uint16_t head = channel->head;
+        uint16_t next = head + 1 == channel->len ? 0 : head + 1;
+        // When the ring is full, the edge is still counted.
+        if (next != channel->tail) {
+            channel->ring[head] = time | slot_level[slot];
+            channel->head = next;
+        }
+    }
+    if (channel->callback != NULL) {
+        channel->callback(channel - channels);
+    }
+}
+
+void GPIOTE_IRQHandler(void) {
+    uint32_t times[EDGES_CHANNELS];
+    bool fired[EDGES_CHANNELS];
+    for (int slot = 0; slot < EDGES_CHANNELS; slot++) {
+        fired[slot] = NRF_GPIOTE->EVENTS_IN[FIRST_GPIOTE_CHANNEL + slot] != 0;
+        if (fired[slot]) {
+            NRF_GPIOTE->EVENTS_IN[FIRST_GPIOTE_CHANNEL + slot] = 0;
+            times[slot] = usclock_extend(USCLOCK->CC[slot]);
+        }
+    }
+    // A pin's rising and falling edges may both have arrived, so record the
+    // earlier first.
+    int first = fired[0] && fired[1] && ((times[0] - times[1]) & EDGES_TIME_MASK) < 0x40000000;
+    for (int i = 0; i < EDGES_CHANNELS; i++) {
+        int slot = first ^ i;
+        if (fired[slot]) {
+            edges_record(slot, times[slot]);
+        }
+    }
+}
+
+static void slot_start(int slot, edges_channel_t *channel, int edges) {
+    uint32_t gpiote = FIRST_GPIOTE_CHANNEL + slot;
+    uint32_t ppi = FIRST_PPI_CHANNEL + slot;
+    slots[slot] = channel;
+    slot_level[slot] = edges == EDGES_RISING ? EDGES_HIGH : 0;
+    NRF_PPI->CH[ppi].EEP = (uint32_t)&NRF_GPIOTE->EVENTS_IN[gpiote];
+    NRF_PPI->CH[ppi].TEP = (uint32_t)&USCLOCK->TASKS_CAPTURE[slot];
+    NRF_PPI->CHENSET = 1 << ppi;
+    nrf_gpiote_event_configure(gpiote, channel->pin, (nrf_gpiote_polarity_t)edges);
+    NRF_GPIOTE->EVENTS_IN[gpiote] = 0;
+    nrf_gpiote_event_enable(gpiote);
+    NRF_GPIOTE->INTENSET = GPIOTE_INTENSET_IN0_Msk << gpiote;
+}
+
+static void slot_stop(int slot) {
+    uint32_t gpiote = FIRST_GPIOTE_CHANNEL + slot;
+    NRF_GPIOTE->INTENCLR = GPIOTE_INTENSET_IN0_Msk << gpiote;
+    NRF_PPI->CHENCLR = 1 << (FIRST_PPI_CHANNEL + slot);
+    nrf_gpiote_event_disable(gpiote);
+    nrf_gpiote_te_default(gpiote);
+    slots[slot] = NULL;
+}
+
+int edges_start(uint8_t pin, int edges, uint32_t *ring, size_t len, edges_callback_t callback) {
+    // Both edges take two slots, so that the hardware tells them apart.
+    int needed = edges == EDGES_BOTH ? 2 : 1;
+    int index = -1;
+    for (int i = 0; i + needed <= EDGES_CHANNELS; i++) {
+        if (slots[i] == NULL && (needed == 1 || slots[i + 1] == NULL)) {
+            index = i;
+            break;
+        }
+    }
+    if (index < 0) {
+        return -1;
+    }
+    edges_channel_t *channel = &channels[index];
+    channel->pin = pin;
+    channel->both = needed == 2;
+    channel->count = 0;
+    channel->ring = ring;
+    channel->len = len;
+    channel->head = 0;
+    channel->tail = 0;
+    channel->callback = callback;
+    channel->active = true;
+    usclock_start();
+
+    if (channel->both) {
+        slot_start(index, channel, EDGES_RISING);
+        slot_start(index + 1, channel, EDGES_FALLING);
+    } else {
+        slot_start(index, channel, edges);
+    }
+    NVIC_SetPriority(GPIOTE_IRQn, USCLOCK_PRIORITY);
+    NVIC_EnableIRQ(GPIOTE_IRQn);
+    return index;
+}
+
+void edges_stop(int index) {
+    edges_channel_t *channel = &channels[index];
+    if (!channel->active) {
+        return;
+    }
+    slot_stop(index);
+    if (channel->both) {
+        slot_stop(index + 1);
+    }
+    channel->active = false;
+    channel->ring = NULL;
+    channel->callback = NULL;
+    usclock_stop();
+}
+
+void edges_stop_all(void) {
+    for (int i = 0; i < EDGES_CHANNELS; i++) {
+        edges_stop(i);
+    }
+}
+
+int edges_channel(uint8_t pin) {
+    for (int i = 0; i < EDGES_CHANNELS; i++) {
+        if (channels[i].active && channels[i].pin == pin) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+uint32_t edges_count(int index) {
+    return channels[index].count;
+}
+
+size_t edges_read(int index, uint32_t *times, size_t n) {
+    edges_channel_t *channel = &channels[index];
+    if (channel->ring == NULL) {
+        return 0;
+    }
+    uint16_t tail = channel->tail;
+    size_t copied = 0;
+    while (copied < n && tail != channel->head) {
+        times[copied++] = channel->ring[tail];
+        tail = tail + 1 == channel->len ? 0 : tail + 1;
+    }
+    channel->tail = tail;
+    return copied;
+}
@@ -0,0 +1,152 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "lib/motion.h"
+
+static uint32_t motion_sqrt(uint32_t x) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+void motion_init(motion_t *motion, uint16_t window, uint16_t threshold) {
+    motion->window = window;
+    motion->count = 0;
+    motion->index = 0;
+    motion->threshold = threshold;
+    motion->magnitude = 0;
+    motion->side = 0;
+    motion->in_peak = false;
+    motion->peak = 0;
+    motion->crossings = 0;
+    motion->sum = 0;
+    motion->sum_squares = 0;
+    motion->peaks = 0;
+    motion->steps = 0;
+    motion->last_step_ms = 0;
+}
+
+void motion_update(motion_t *motion, int x, int y, int z, uint32_t ms) {
+    uint32_t magnitude = motion_sqrt(x * x + y * y + z * z);
+    if (magnitude > MOTION_MAX_MAGNITUDE) {
+        magnitude = MOTION_MAX_MAGNITUDE;
+    }
+    motion->magnitude = magnitude;
+
+    // Everything below looks at the signal relative to the mean of the
+    // samples before this one, so that slow changes such as tilting the
+    // device are ignored.
+    int mean = motion->count == 0 ? (int)magnitude : (int)(motion->sum / motion->count);
+    int dynamic = (int)magnitude - mean;
+
+    // Count crossings of the mean, with some hysteresis so that noise
+    // around it doesn't count.
+    uint16_t entry = magnitude;
+    int hysteresis = motion->threshold / 4;
+    int8_t side = motion->side;
+    if (dynamic > hysteresis && side <= 0) {
+        motion->side = 1;
+    } else if (dynamic < -hysteresis && side >= 0) {
+        motion->side = -1;
+    }
+    if (side != 0 && side != motion->side) {
+        entry |= MOTION_CROSSING;
+    }
+
+    // A peak starts when the signal rises above the threshold and ends when
+    // it falls back below half of it.  Each peak is a step, unless it comes
+    // too soon after the last one.
+    if (dynamic > (int)motion->threshold) {
+        if (!motion->in_peak || dynamic > motion->peak) {
+            motion->peak = dynamic;
+        }
+        motion->in_peak = true;
+    } else if (motion->in_peak && dynamic < (int)motion->threshold / 2) {
+        motion->in_peak = false;
+        motion->peaks++;
+        if (motion->steps == 0 || ms - motion->last_step_ms >= MOTION_MIN_STEP_MS) {
+            motion->steps++;
+            motion->last_step_ms = ms;
+        }
+    }
+
+    // Slide the window along.
+    uint16_t *slot = &motion->history[motion->index];
+    if (motion->count == motion->window) {
+        uint32_t old = *slot & MOTION_MAX_MAGNITUDE;
+        motion->sum -= old;
+        motion->sum_squares -= old * old;
+        if (*slot & MOTION_CROSSING) {
+            motion->crossings--;
+        }
+    } else {
+        motion->count++;
+    }
+    *slot = entry;
+    motion->sum += magnitude;
+    motion->sum_squares += magnitude * magnitude;
+    if (entry & MOTION_CROSSING) {
+        motion->crossings++;
+    }
+    if (++motion->index == motion->window) {
+        motion->index = 0;
+    }
+}
+
+int motion_mean(const motion_t *motion) {
+    if (motion->count == 0) {
+        return 0;
+    }
+    return motion->sum / motion->count;
+}
+
+uint32_t motion_variance(const motion_t *motion) {
+    uint64_t n = motion->count;
+    if (n == 0) {
+        return 0;
+    }
+    uint64_t sum = motion->sum;
+    return (motion->sum_squares * n - sum * sum) / (n * n);
+}
+
+uint32_t motion_crossing_rate(const motion_t *motion, uint32_t period_ms) {
+    if (motion->count == 0 || period_ms == 0) {
+        return 0;
+    }
+    return motion->crossings * 1000 / (motion->count * period_ms);
+}
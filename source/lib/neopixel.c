@@ -76,14 +76,63 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "nrf_gpio.h"
 #include "neopixel.h"
 
-void neopixel_init(neopixel_strip_t *strip, uint8_t pin_num, uint16_t num_leds)
+//The SPI bits for each nibble of data, most significant first.
+#define P(b3, b2, b1, b0) ((b3 ? 0xe000 : 0x8000) | (b2 ? 0x0e00 : 0x0800) | (b1 ? 0x00e0 : 0x0080) | (b0 ? 0x000e : 0x0008))
+static const uint16_t nibble_pulses[16] = {
+	P(0,0,0,0), P(0,0,0,1), P(0,0,1,0), P(0,0,1,1),
+	P(0,1,0,0), P(0,1,0,1), P(0,1,1,0), P(0,1,1,1),
+	P(1,0,0,0), P(1,0,0,1), P(1,0,1,0), P(1,0,1,1),
+	P(1,1,0,0), P(1,1,0,1), P(1,1,1,0), P(1,1,1,1),
+};
+#undef P
+
+//Gamma correction with an exponent of 2.8, for neopixel_set_gamma().
+const uint8_t neopixel_gamma_table[256] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+	  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   1,   1,   1,
+	  1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+	  2,   3,   3,   3,   3,   3,   3,   3,   4,   4,   4,   4,   4,   5,   5,   5,
+	  5,   6,   6,   6,   6,   7,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,
+	 10,  10,  11,  11,  11,  12,  12,  13,  13,  13,  14,  14,  15,  15,  16,  16,
+	 17,  17,  18,  18,  19,  19,  20,  20,  21,  21,  22,  22,  23,  24,  24,  25,
+	 25,  26,  27,  27,  28,  29,  29,  30,  31,  32,  32,  33,  34,  35,  35,  36,
+	 37,  38,  39,  39,  40,  41,  42,  43,  44,  45,  46,  47,  48,  49,  50,  50,
+	 51,  52,  54,  55,  56,  57,  58,  59,  60,  61,  62,  63,  64,  66,  67,  68,
+	 69,  70,  72,  73,  74,  75,  77,  78,  79,  81,  82,  83,  85,  86,  87,  89,
+	 90,  92,  93,  95,  96,  98,  99, 101, 102, 104, 105, 107, 109, 110, 112, 114,
+	115, 117, 119, 120, 122, 124, 126, 127, 129, 131, 133, 135, 137, 138, 140, 142,
+	144, 146, 148, 150, 152, 154, 156, 158, 160, 162, 164, 167, 169, 171, 173, 175,
+	177, 180, 182, 184, 186, 189, 191, 193, 196, 198, 200, 203, 205, 208, 210, 213,
+	215, 218, 220, 223, 225, 228, 231, 233, 236, 239, 241, 244, 247, 249, 252, 255,
+};
+
+volatile bool neopixel_sending = false;
+
+//The level sent to the LEDs for a stored colour value.
+static inline uint8_t neopixel_level(const neopixel_strip_t *strip, uint8_t value)
+{
+	if (strip->gamma != NULL)
+	{
+		value = strip->gamma[value];
+	}
+	return (value * (strip->brightness + 1)) >> 8;
+}
+
+uint8_t neopixel_init(neopixel_strip_t *strip, uint8_t pin_num, uint16_t num_leds)
 {
 	strip->leds = (color_t*) malloc(sizeof(color_t) * num_leds);
+	if (strip->leds == NULL)
+	{
+		return 1;
+	}
 	strip->pin_num = pin_num;
 	strip->num_leds = num_leds;
+	strip->brightness = 255;
+	strip->gamma = NULL;
 	nrf_gpio_cfg_output(pin_num);
 	NRF_GPIO->OUTCLR = (1UL << pin_num);
 	for (int i = 0; i < num_leds; i++)
@@ -92,6 +141,7 @@ void neopixel_init(neopixel_strip_t *strip, uint8_t pin_num, uint16_t num_leds)
 		strip->leds[i].simple.r = 0;
 		strip->leds[i].simple.b = 0;
 	}
+	return 0;
 }
 
 void neopixel_clear(neopixel_strip_t *strip)
@@ -105,43 +155,83 @@ void neopixel_clear(neopixel_strip_t *strip)
 			neopixel_show(strip);
 }
 
+//The four SPI bytes for a stored colour value, first in the top byte.
+static inline uint32_t neopixel_pulses(const neopixel_strip_t *strip, uint8_t value)
+{
+	uint8_t level = neopixel_level(strip, value);
+	return (uint32_t)nibble_pulses[level >> 4] << 16 | nibble_pulses[level & 15];
+}
+
+static void neopixel_spi_wait(NRF_SPI_Type *spi)
+{
+	while (spi->EVENTS_READY == 0);
+	spi->EVENTS_READY = 0;
+	(void)spi->RXD;
+}
+
+//Clock the strip out of the SPI peripheral, keeping its double-buffered TXD
+//register full. Each byte of colour is encoded while the previous one is sent,
+//which leaves about 4us to do it in. The pulses for each bit end low, and MOSI
+//stays low while the buffer is empty, so being interrupted only lengthens the
+//gap between bits.
+static void neopixel_send_pulses(neopixel_strip_t *strip)
+{
+	NRF_SPI_Type *spi = NEOPIXEL_SPI;
+	const uint8_t *data = strip->leds[0].grb;
+	int len = strip->num_leds * sizeof(color_t);
+
+	//borrow the peripheral, which may be in use by the spi module
+	uint32_t enable = spi->ENABLE;
+	uint32_t psel_sck = spi->PSELSCK;
+	uint32_t psel_mosi = spi->PSELMOSI;
+	uint32_t psel_miso = spi->PSELMISO;
+	uint32_t frequency = spi->FREQUENCY;
+	uint32_t config = spi->CONFIG;
+
+	spi->ENABLE = SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos;
+	spi->PSELSCK = 0xFFFFFFFF;
+	spi->PSELMOSI = strip->pin_num;
+	spi->PSELMISO = 0xFFFFFFFF;
+	spi->FREQUENCY = SPI_FREQUENCY_FREQUENCY_M4 << SPI_FREQUENCY_FREQUENCY_Pos;
+	spi->CONFIG = SPI_CONFIG_ORDER_MsbFirst << SPI_CONFIG_ORDER_Pos;
+	spi->EVENTS_READY = 0;
+	spi->ENABLE = SPI_ENABLE_ENABLE_Enabled << SPI_ENABLE_ENABLE_Pos;
+
+	neopixel_sending = true;
+	uint32_t pulses = neopixel_pulses(strip, data[0]);
+	spi->TXD = pulses >> 24;
+	spi->TXD = pulses >> 16;
+	neopixel_spi_wait(spi);
+	spi->TXD = pulses >> 8;
+	neopixel_spi_wait(spi);
+	spi->TXD = pulses;
+	for (int i = 1; i < len; i++)
+	{
+		pulses = neopixel_pulses(strip, data[i]);
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			neopixel_spi_wait(spi);
+			spi->TXD = pulses >> shift;
+		}
+	}
+	neopixel_spi_wait(spi);
+	neopixel_spi_wait(spi);
+	neopixel_sending = false;
+
+	spi->ENABLE = SPI_ENABLE_ENABLE_Disabled << SPI_ENABLE_ENABLE_Pos;
+	spi->PSELSCK = psel_sck;
+	spi->PSELMOSI = psel_mosi;
+	spi->PSELMISO = psel_miso;
+	spi->FREQUENCY = frequency;
+	spi->CONFIG = config;
+	spi->ENABLE = enable;
+}
+
 void neopixel_show(neopixel_strip_t *strip)
 {
-	const uint8_t PIN =  strip->pin_num;
-	NRF_GPIO->OUTCLR = (1UL << PIN);
+	NRF_GPIO->OUTCLR = (1UL << strip->pin_num);
 	nrf_delay_us(50);
-	uint32_t irq_state = __get_PRIMASK();
-	__disable_irq();
-			for (int i = 0; i < strip->num_leds; i++)
-			{
-				for (int j = 0; j < 3; j++)
-				{
-					if ((strip->leds[i].grb[j] & 128) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-					
-					if ((strip->leds[i].grb[j] & 64) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-					
-					if ((strip->leds[i].grb[j] & 32) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-					
-					if ((strip->leds[i].grb[j] & 16) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-					
-					if ((strip->leds[i].grb[j] & 8) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-					
-					if ((strip->leds[i].grb[j] & 4) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-					
-					if ((strip->leds[i].grb[j] & 2) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-					
-					if ((strip->leds[i].grb[j] & 1) > 0)	{NEOPIXEL_SEND_ONE}
-					else	{NEOPIXEL_SEND_ZERO}
-				}
-			}
-	__set_PRIMASK(irq_state);
+	neopixel_send_pulses(strip);
 }
 
 uint8_t neopixel_set_color(neopixel_strip_t *strip, uint16_t index, uint8_t red, uint8_t green, uint8_t blue )
@@ -171,6 +261,133 @@ uint8_t neopixel_set_color_and_show(neopixel_strip_t *strip, uint16_t index, uin
 		return 0;
 }
 
+void neopixel_fill(neopixel_strip_t *strip, uint16_t start, uint16_t stop, uint8_t red, uint8_t green, uint8_t blue)
+{
+	for (int i = start; i < stop; i++)
+	{
+		strip->leds[i].simple.r = red;
+		strip->leds[i].simple.g = green;
+		strip->leds[i].simple.b = blue;
+	}
+}
+
+void neopixel_gradient(neopixel_strip_t *strip, uint16_t start, uint16_t stop, const uint8_t *from, const uint8_t *to)
+{
+	int steps = stop - start - 1;
+	for (int i = 0; start + i < stop; i++)
+	{
+		uint8_t rgb[3];
+		for (int j = 0; j < 3; j++)
+		{
+			rgb[j] = steps == 0 ? from[j] : from[j] + ((to[j] - from[j]) * i + (to[j] > from[j] ? steps / 2 : -steps / 2)) / steps;
+		}
+		neopixel_set_color(strip, start + i, rgb[0], rgb[1], rgb[2]);
+	}
+}
+
+static void hsv_to_rgb(uint16_t hue, uint8_t saturation, uint8_t value, color_t *color)
+{
+	uint8_t sector = hue / 60;
+	uint32_t f = (hue % 60) * 255 / 60;
+	uint8_t p = value * (255 - saturation) / 255;
+	uint8_t q = value * (255 * 255 - saturation * f) / (255 * 255);
+	uint8_t t = value * (255 * 255 - saturation * (255 - f)) / (255 * 255);
+	uint8_t r, g, b;
+	switch (sector)
+	{
+		case 0: r = value; g = t; b = p; break;
+		case 1: r = q; g = value; b = p; break;
+		case 2: r = p; g = value; b = t; break;
+		case 3: r = p; g = q; b = value; break;
+		case 4: r = t; g = p; b = value; break;
+		default: r = value; g = p; b = q; break;
+	}
+	color->simple.r = r;
+	color->simple.g = g;
+	color->simple.b = b;
+}
+
+void neopixel_hsv(neopixel_strip_t *strip, uint16_t start, uint16_t stop, int32_t hue, int32_t end_hue, uint8_t saturation, uint8_t value)
+{
+	int steps = stop - start - 1;
+	for (int i = 0; start + i < stop; i++)
+	{
+		int32_t h = steps == 0 ? hue : hue + (end_hue - hue) * i / steps;
+		h %= 360;
+		if (h < 0)
+		{
+			h += 360;
+		}
+		hsv_to_rgb(h, saturation, value, &strip->leds[start + i]);
+	}
+}
+
+static void neopixel_reverse(color_t *leds, int len)
+{
+	for (int i = 0, j = len - 1; i < j; i++, j--)
+	{
+		color_t c = leds[i];
+		leds[i] = leds[j];
+		leds[j] = c;
+	}
+}
+
+void neopixel_rotate(neopixel_strip_t *strip, int32_t n)
+{
+	int len = strip->num_leds;
+	n %= len;
+	if (n < 0)
+	{
+		n += len;
+	}
+	if (n == 0)
+	{
+		return;
+	}
+	//rotate in place by reversing both parts and then the whole strip
+	neopixel_reverse(strip->leds, len - n);
+	neopixel_reverse(strip->leds + len - n, n);
+	neopixel_reverse(strip->leds, len);
+}
+
+void neopixel_shift(neopixel_strip_t *strip, int32_t n)
+{
+	int len = strip->num_leds;
+	if (n >= len || n <= -len)
+	{
+		memset(strip->leds, 0, len * sizeof(color_t));
+	}
+	else if (n > 0)
+	{
+		memmove(strip->leds + n, strip->leds, (len - n) * sizeof(color_t));
+		memset(strip->leds, 0, n * sizeof(color_t));
+	}
+	else if (n < 0)
+	{
+		memmove(strip->leds, strip->leds - n, (len + n) * sizeof(color_t));
+		memset(strip->leds + len + n, 0, -n * sizeof(color_t));
+	}
+}
+
+void neopixel_scale(neopixel_strip_t *strip, uint8_t level)
+{
+	uint8_t *data = strip->leds[0].grb;
+	for (int i = 0; i < strip->num_leds * 3; i++)
+	{
+		data[i] = (data[i] * level + 127) / 255;
+	}
+}
+
+void neopixel_set_brightness(neopixel_strip_t *strip, uint8_t brightness)
+{
+	strip->brightness = brightness;
+}
+
+void neopixel_set_gamma(neopixel_strip_t *strip, const uint8_t *table)
+{
+	strip->gamma = table;
+}
+
 void neopixel_destroy(neopixel_strip_t *strip)
 {
 	free(strip->leds);
@@ -0,0 +1,188 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "lib/orientation.h"
+
+#define ONE ORIENTATION_ONE
+
+static uint32_t isqrt(uint32_t x) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/* atan2 in tenths of a degree, from -1800 to 1800.  For the first octant
+ *     atan(z) ~ 45z + z(1 - z)(14.02 + 3.80z) degrees
+ * which is within 0.1 degrees.
+ */
+static int atan2_tenths(int32_t y, int32_t x) {
+    int32_t ax = x < 0 ? -x : x;
+    int32_t ay = y < 0 ? -y : y;
+    if (ax == 0 && ay == 0) {
+        return 0;
+    }
+    bool steep = ay > ax;
+    int32_t z = ((int64_t)(steep ? ax : ay) << 15) / (steep ? ay : ax);
+    int32_t curve = ((int64_t)z * (32768 - z)) >> 15;
+    int32_t angle = ((450 * z) >> 15) + ((int64_t)curve * (1402 + ((380 * z) >> 15)) >> 15) / 10;
+    if (steep) {
+        angle = 900 - angle;
+    }
+    if (x < 0) {
+        angle = 1800 - angle;
+    }
+    return y < 0 ? -angle : angle;
+}
+
+// Scale v to a unit vector, with components in units of 1/ONE.  Returns
+// false if it is too short to have a direction.
+static bool unit(const int32_t *v, int32_t *out) {
+    // Bring the components into 15 bits first so the squares can't overflow.
+    int32_t max = 0;
+    for (int i = 0; i < 3; i++) {
+        int32_t a = v[i] < 0 ? -v[i] : v[i];
+        if (a > max) {
+            max = a;
+        }
+    }
+    int shift = 0;
+    while ((max >> shift) >= (1 << 15)) {
+        shift++;
+    }
+    int32_t s[3];
+    uint32_t sum = 0;
+    for (int i = 0; i < 3; i++) {
+        s[i] = v[i] / (1 << shift);
+        sum += s[i] * s[i];
+    }
+    uint32_t len = isqrt(sum);
+    if (len < 16) {
+        return false;
+    }
+    for (int i = 0; i < 3; i++) {
+        out[i] = s[i] * ONE / (int32_t)len;
+    }
+    return true;
+}
+
+static void cross(const int32_t *a, const int32_t *b, int32_t *out) {
+    out[0] = ((int64_t)a[1] * b[2] - (int64_t)a[2] * b[1]) / ONE;
+    out[1] = ((int64_t)a[2] * b[0] - (int64_t)a[0] * b[2]) / ONE;
+    out[2] = ((int64_t)a[0] * b[1] - (int64_t)a[1] * b[0]) / ONE;
+}
+
+// The quaternion of a rotation matrix with entries in units of 1/ONE.
+static void quaternion(int32_t m[3][3], int16_t *q) {
+    int32_t trace = m[0][0] + m[1][1] + m[2][2];
+    int32_t w, x, y, z;
+    // Work from the largest of the four to keep the divisions accurate.
+    if (trace > 0) {
+        int32_t s = 2 * isqrt((uint32_t)(trace + ONE) * ONE);
+        w = s / 4;
+        x = (m[2][1] - m[1][2]) * ONE / s;
+        y = (m[0][2] - m[2][0]) * ONE / s;
+        z = (m[1][0] - m[0][1]) * ONE / s;
+    } else if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+        int32_t s = 2 * isqrt((uint32_t)(ONE + m[0][0] - m[1][1] - m[2][2]) * ONE);
+        w = (m[2][1] - m[1][2]) * ONE / s;
+        x = s / 4;
+        y = (m[0][1] + m[1][0]) * ONE / s;
+        z = (m[0][2] + m[2][0]) * ONE / s;
+    } else if (m[1][1] > m[2][2]) {
+        int32_t s = 2 * isqrt((uint32_t)(ONE + m[1][1] - m[0][0] - m[2][2]) * ONE);
+        w = (m[0][2] - m[2][0]) * ONE / s;
+        x = (m[0][1] + m[1][0]) * ONE / s;
+        y = s / 4;
+        z = (m[1][2] + m[2][1]) * ONE / s;
+    } else {
+        int32_t s = 2 * isqrt((uint32_t)(ONE + m[2][2] - m[0][0] - m[1][1]) * ONE);
+        w = (m[1][0] - m[0][1]) * ONE / s;
+        x = (m[0][2] + m[2][0]) * ONE / s;
+        y = (m[1][2] + m[2][1]) * ONE / s;
+        z = s / 4;
+    }
+    // Keep w positive, so the same orientation always gives the same result.
+    int sign = w < 0 ? -1 : 1;
+    q[0] = sign * w;
+    q[1] = sign * x;
+    q[2] = sign * y;
+    q[3] = sign * z;
+}
+
+void orientation_update(orientation_t *orientation, const int *accel, const int *field) {
+    for (int i = 0; i < 3; i++) {
+        if (orientation->started) {
+            orientation->down[i] += (accel[i] * 256 - orientation->down[i]) >> ORIENTATION_SMOOTHING;
+            orientation->field[i] += (field[i] * 256 - orientation->field[i]) >> ORIENTATION_SMOOTHING;
+        } else {
+            orientation->down[i] = accel[i] * 256;
+            orientation->field[i] = field[i] * 256;
+        }
+    }
+    orientation->started = true;
+
+    // North, east and down in the device's axes: the rows of the matrix
+    // that turns the device's axes into the world's.
+    int32_t down[3], north[3], east[3], m[3];
+    if (!unit(orientation->down, down) || !unit(orientation->field, m)) {
+        return;
+    }
+    cross(down, m, east);
+    if (!unit(east, east)) {
+        // The field is straight up or down, so there is no north.
+        return;
+    }
+    cross(east, down, north);
+
+    // The device's forward, right and down axes are -y, -x and -z.
+    orientation->heading = atan2_tenths(-east[1], -north[1]);
+    if (orientation->heading < 0) {
+        orientation->heading += 360 * ORIENTATION_DEGREE;
+    }
+    orientation->pitch = atan2_tenths(down[1], isqrt(down[0] * down[0] + down[2] * down[2]));
+    orientation->roll = atan2_tenths(-down[0], -down[2]);
+
+    int32_t *rows[3] = {north, east, down};
+    int32_t matrix[3][3];
+    for (int i = 0; i < 3; i++) {
+        matrix[i][0] = -rows[i][1];
+        matrix[i][1] = -rows[i][0];
+        matrix[i][2] = -rows[i][2];
+    }
+    quaternion(matrix, orientation->quaternion);
+}
@@ -0,0 +1,989 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "nrf.h"
+#include "lib/radio.h"
+
+// Busy-wait for a peripheral event.  The host simulator in tools/radiosim
+// replaces this, so that its simulated radio can make progress.
+#ifndef RADIO_WAIT_FOR
+#define RADIO_WAIT_FOR(event) while ((event) == 0)
+#endif
+
+// The radio listens whenever it isn't sending.  Sending switches it through
+// these modes, driven by the DISABLED event in the IRQ handler.
+enum {
+    RADIO_MODE_RX,
+    RADIO_MODE_SWITCH,  // disabling the receiver to transmit or change channel
+    RADIO_MODE_TX,
+    RADIO_MODE_ACK,     // sending an acknowledgement
+    RADIO_MODE_BEACON,  // sending a TDMA beacon
+};
+
+// Shortcuts used in all modes: start receiving/transmitting as soon as the
+// radio is ready, and sample the RSSI when an address matches.
+#define RADIO_SHORTS_COMMON (RADIO_SHORTS_READY_START_Msk | RADIO_SHORTS_ADDRESS_RSSISTART_Msk)
+
+radio_stats_t radio_stats;
+
+static uint8_t *rx_ring;
+static size_t rx_slot_size;
+static uint8_t rx_slots;
+static volatile uint8_t rx_head; // the slot being received into, written only by the IRQ
+static volatile uint8_t rx_tail; // the oldest waiting packet, written only by the reader
+
+// Packets waiting to be sent are kept in a ring of slots holding the length
+// byte and payload, which the radio transmits from directly.
+static uint8_t *tx_ring;
+static size_t tx_slot_size;
+static uint8_t tx_slots;
+static volatile uint8_t tx_head; // the next free slot, written only by radio_send
+static volatile uint8_t tx_tail; // the packet being sent, written only by the IRQ
+static volatile uint8_t radio_mode;
+
+// The driver's own packets start with the typed header the radio module puts
+// on strings, 1 and 0 followed by the type, with types of their own.
+#define FRAME_HEADER_LEN    (3)
+
+enum {
+    FRAME_LARGE = RADIO_FRAME_FIRST_TYPE,
+    FRAME_RELIABLE_DATA,
+    FRAME_RELIABLE_ACK,
+    FRAME_BEACON,
+    FRAME_BENCH_FLOOD,
+    FRAME_BENCH_PING,
+    FRAME_BENCH_PONG,
+};
+
+// Fragments of large messages have the message id, the fragment's index, the
+// number of fragments and the fragment's offset into the message.
+#define LARGE_HEADER_LEN    (FRAME_HEADER_LEN + 5)
+
+enum {
+    LARGE_EMPTY,
+    LARGE_PARTIAL,
+    LARGE_COMPLETE,
+};
+
+static uint8_t *large_buf;
+static size_t large_buf_size;
+static volatile uint8_t large_status;
+static uint8_t large_id;
+static uint8_t large_count;
+static uint8_t large_received;
+static size_t large_len;
+static volatile uint32_t large_ticks; // when the last fragment arrived
+static uint8_t large_have[(RADIO_LARGE_MAX_FRAGMENTS + 7) / 8];
+static uint8_t large_next_id;
+
+// Reliable packets and their ACKs have the ids of the sender and the
+// receiver, and the sender's sequence number.
+#define RELIABLE_HEADER_LEN (RADIO_RELIABLE_HEADER_LEN)
+
+typedef struct _reliable_peer_t {
+    uint16_t id;
+    uint8_t seq;
+    bool valid;
+} reliable_peer_t;
+
+static bool reliable;
+static uint16_t node_id;
+static reliable_peer_t peers[RADIO_RELIABLE_PEERS];
+static uint8_t next_peer;
+static uint8_t ack_packet[1 + RELIABLE_HEADER_LEN];
+static volatile bool ack_pending;   // ack_packet is waiting to be sent
+static bool tx_awaits_ack;          // the packet being sent is a reliable one
+// the ACK radio_send_reliable() is waiting for
+static uint16_t ack_peer;
+static uint8_t ack_seq;
+static volatile bool ack_received;
+static uint8_t reliable_seq;
+static uint32_t random_state;
+
+// TDMA beacons carry the frame number.
+#define BEACON_LEN          (FRAME_HEADER_LEN + 4)
+
+static uint8_t tdma_slots;
+static uint8_t tdma_slot;
+static uint8_t slot_ticks;
+static uint8_t hops;
+static uint8_t base_channel;
+static volatile uint8_t radio_channel;  // used from the next time the radio is enabled
+static volatile bool tdma_retune;       // radio_channel has changed
+static volatile bool tdma_synced;       // always set when TDMA is off
+static volatile bool tdma_window;       // this device may send, always set when TDMA is off
+static uint16_t tdma_tick_count;        // ticks since the start of the frame
+static uint32_t tdma_frame;
+static uint8_t tdma_lost;               // frames since the last beacon
+static uint8_t beacon_packet[1 + BEACON_LEN];
+static volatile bool beacon_pending;
+
+extern uint32_t ticks;
+
+static inline void frame_header(uint8_t *data, uint8_t type) {
+    data[0] = 1;
+    data[1] = 0;
+    data[2] = type;
+}
+
+// Returns the type of one of the driver's own packets, or 0 for any other.
+static inline uint8_t frame_type(const uint8_t *data, size_t len) {
+    if (len < FRAME_HEADER_LEN || data[0] != 1 || data[1] != 0 || data[2] < RADIO_FRAME_FIRST_TYPE) {
+        return 0;
+    }
+    return data[2];
+}
+
+static inline radio_packet_t *rx_slot(uint8_t index) {
+    return (radio_packet_t*)(rx_ring + index * rx_slot_size);
+}
+
+static inline uint8_t rx_next(uint8_t index) {
+    return index + 1 == rx_slots ? 0 : index + 1;
+}
+
+static inline uint8_t *tx_slot(uint8_t index) {
+    return tx_ring + index * tx_slot_size;
+}
+
+static inline uint8_t tx_next(uint8_t index) {
+    return index + 1 == tx_slots ? 0 : index + 1;
+}
+
+static inline bool tx_ready(void) {
+    return tx_tail != tx_head && tdma_window;
+}
+
+// Time on air of a packet: preamble, 5 byte address, length, payload and CRC.
+static uint32_t airtime_us(uint8_t len) {
+    uint32_t bits = (1 + 5 + 1 + len + 2) * 8;
+    switch (NRF_RADIO->MODE) {
+        case RADIO_MODE_MODE_Nrf_2Mbit: return bits >> 1;
+        case RADIO_MODE_MODE_Nrf_250Kbit: return bits << 2;
+        default: return bits;
+    }
+}
+
+static void radio_receive_fragment(const radio_packet_t *packet) {
+    const uint8_t *data = packet->data;
+    uint8_t id = data[3];
+    uint8_t index = data[4];
+    uint8_t count = data[5];
+    size_t offset = data[6] | data[7] << 8;
+    size_t len = packet->len - LARGE_HEADER_LEN;
+
+    if (large_status == LARGE_PARTIAL && (id != large_id || count != large_count)) {
+        // another message: only start on it if the current one has stalled
+        if (ticks - large_ticks < RADIO_LARGE_TIMEOUT_MS) {
+            radio_stats.rx_dropped += 1;
+            return;
+        }
+        large_status = LARGE_EMPTY;
+    }
+    if (large_status == LARGE_COMPLETE || index >= count || offset + len > large_buf_size) {
+        radio_stats.rx_dropped += 1;
+        return;
+    }
+    if (large_status == LARGE_EMPTY) {
+        large_id = id;
+        large_count = count;
+        large_received = 0;
+        memset(large_have, 0, sizeof(large_have));
+        large_status = LARGE_PARTIAL;
+    }
+
+    // fragments may arrive more than once, and in any order
+    if (!(large_have[index >> 3] & (1 << (index & 7)))) {
+        large_have[index >> 3] |= 1 << (index & 7);
+        memcpy(large_buf + offset, data + LARGE_HEADER_LEN, len);
+        if (index == count - 1) {
+            large_len = offset + len;
+        }
+        if (++large_received == count) {
+            large_status = LARGE_COMPLETE;
+        }
+    }
+    large_ticks = ticks;
+}
+
+static inline uint16_t get_uint16(const uint8_t *data) {
+    return data[0] | data[1] << 8;
+}
+
+static inline void put_uint16(uint8_t *data, uint16_t value) {
+    data[0] = value;
+    data[1] = value >> 8;
+}
+
+static inline uint32_t get_uint32(const uint8_t *data) {
+    return get_uint16(data) | (uint32_t)get_uint16(data + 2) << 16;
+}
+
+static inline void put_uint32(uint8_t *data, uint32_t value) {
+    put_uint16(data, value);
+    put_uint16(data + 2, value >> 16);
+}
+
+// Returns true if the packet should be queued, with its header removed.
+static bool radio_receive_reliable(radio_packet_t *packet) {
+    const uint8_t *data = packet->data;
+    uint16_t src = get_uint16(data + 3);
+    uint8_t seq = data[7];
+    if (get_uint16(data + 5) != node_id) {
+        return false;
+    }
+    if (data[2] == FRAME_RELIABLE_ACK) {
+        if (src == ack_peer && seq == ack_seq) {
+            ack_received = true;
+        }
+        return false;
+    }
+
+    if (ack_pending) {
+        // there's only room for one ACK, and the last one hasn't gone yet, so
+        // let the sender try again without remembering this packet
+        radio_stats.rx_dropped += 1;
+        return false;
+    }
+
+    reliable_peer_t *peer = NULL;
+    for (size_t i = 0; i < RADIO_RELIABLE_PEERS; i++) {
+        if (peers[i].valid && peers[i].id == src) {
+            peer = &peers[i];
+            break;
+        }
+    }
+    bool repeat = peer != NULL && peer->seq == seq;
+    if (!repeat && rx_next(rx_head) == rx_tail) {
+        // no room to keep it, so let the sender try again later
+        radio_stats.rx_dropped += 1;
+        return false;
+    }
+
+    // acknowledge repeats too, as it may be the last ACK that was lost
+    ack_packet[0] = RELIABLE_HEADER_LEN;
+    frame_header(ack_packet + 1, FRAME_RELIABLE_ACK);
+    put_uint16(ack_packet + 4, node_id);
+    put_uint16(ack_packet + 6, src);
+    ack_packet[8] = seq;
+    ack_pending = true;
+    if (repeat) {
+        return false;
+    }
+
+    if (peer == NULL) {
+        // forget the oldest peer
+        peer = &peers[next_peer];
+        next_peer = next_peer + 1 == RADIO_RELIABLE_PEERS ? 0 : next_peer + 1;
+        peer->id = src;
+        peer->valid = true;
+    }
+    peer->seq = seq;
+
+    packet->len -= RELIABLE_HEADER_LEN;
+    memmove(packet->data, packet->data + RELIABLE_HEADER_LEN, packet->len);
+    return true;
+}
+
+// Work out the channel and whether this device may send, for the current tick
+// of the frame.
+static void tdma_update(void) {
+    uint8_t slot = tdma_tick_count / slot_ticks;
+    uint8_t tick = tdma_tick_count % slot_ticks;
+    // our clock may be up to a tick ahead of the coordinator's, so leave the
+    // first tick of the slot for the last packet of the previous one
+    tdma_window = tdma_synced && slot == tdma_slot && tick >= 1 && tick < slot_ticks - 1;
+
+    // the beacon slot stays on the base channel, where devices that have lost
+    // track of the frame can hear it
+    uint8_t channel = base_channel;
+    if (tdma_synced && slot != 0) {
+        channel = (base_channel + (tdma_frame % hops) * RADIO_TDMA_HOP_SPACING) % 101;
+    }
+    if (channel != radio_channel) {
+        radio_channel = channel;
+        tdma_retune = true;
+    }
+}
+
+static void radio_receive_beacon(const radio_packet_t *packet) {
+    if (tdma_slot == 0) {
+        // there's another coordinator, and we carry on with our own frames
+        return;
+    }
+    radio_stats.beacons += 1;
+    tdma_frame = get_uint32(packet->data + FRAME_HEADER_LEN);
+    // the coordinator sends it on the second tick of the frame
+    tdma_tick_count = 1;
+    tdma_lost = 0;
+    tdma_synced = true;
+    tdma_update();
+}
+
+// Point the radio at the next free slot, unless it would overwrite a packet
+// that hasn't been read, in which case the next packet overwrites this one.
+static void radio_queue_packet(radio_packet_t *packet, uint32_t rssi) {
+    uint8_t next = rx_next(rx_head);
+    if (next != rx_tail) {
+        packet->rssi = -(int)rssi;
+        packet->match = NRF_RADIO->RXMATCH;
+        packet->ticks = ticks;
+        rx_head = next;
+        NRF_RADIO->PACKETPTR = (uint32_t)&rx_slot(next)->len;
+    } else {
+        radio_stats.rx_dropped += 1;
+    }
+}
+
+// Get ready to receive, once the receiver has been enabled.
+static void radio_listen(void) {
+    NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON;
+    NRF_RADIO->PACKETPTR = (uint32_t)&rx_slot(rx_head)->len;
+    NRF_RADIO->EVENTS_ADDRESS = 0;
+    radio_mode = RADIO_MODE_RX;
+}
+
+static void radio_start_rx(void) {
+    radio_listen();
+    NRF_RADIO->TASKS_RXEN = 1;
+}
+
+static void radio_start_tx(void) {
+    // disable the radio again once the packet is sent
+    uint8_t *packet = tx_slot(tx_tail);
+    uint32_t shorts = RADIO_SHORTS_COMMON | RADIO_SHORTS_END_DISABLE_Msk;
+    tx_awaits_ack = reliable && packet[0] >= RELIABLE_HEADER_LEN
+        && frame_type(packet + 1, packet[0]) == FRAME_RELIABLE_DATA;
+    if (tx_awaits_ack) {
+        // turn straight round to receive the ACK, which the receiver sends
+        // as soon as it can
+        shorts |= RADIO_SHORTS_DISABLED_RXEN_Msk;
+    }
+    NRF_RADIO->SHORTS = shorts;
+    NRF_RADIO->PACKETPTR = (uint32_t)packet;
+    radio_mode = RADIO_MODE_TX;
+    NRF_RADIO->TASKS_TXEN = 1;
+}
+
+// Send an ACK or a beacon.
+static void radio_start_control(uint8_t *packet, uint8_t mode) {
+    NRF_RADIO->SHORTS = RADIO_SHORTS_COMMON | RADIO_SHORTS_END_DISABLE_Msk;
+    NRF_RADIO->PACKETPTR = (uint32_t)packet;
+    radio_mode = mode;
+    NRF_RADIO->TASKS_TXEN = 1;
+}
+
+void RADIO_IRQHandler(void) {
+    // when a packet has been sent the END_DISABLE shortcut takes it from here
+    if (NRF_RADIO->EVENTS_END && radio_mode == RADIO_MODE_RX) {
+        NRF_RADIO->EVENTS_END = 0;
+        NRF_RADIO->EVENTS_ADDRESS = 0;
+
+        radio_packet_t *packet = rx_slot(rx_head);
+        size_t max_len = NRF_RADIO->PCNF1 & 0xff;
+        if (packet->len > max_len) {
+            packet->len = max_len;
+        }
+
+        // if the CRC was valid then accept the packet
+        if (NRF_RADIO->CRCSTATUS == 1) {
+            // the RSSI was sampled when the address matched
+            uint32_t rssi = NRF_RADIO->RSSISAMPLE;
+            uint32_t bucket = rssi < 40 ? 0 : (rssi - 40) >> 3;
+            radio_stats.rssi[bucket < RADIO_RSSI_BUCKETS ? bucket : RADIO_RSSI_BUCKETS - 1] += 1;
+            radio_stats.received += 1;
+
+            // the driver's packets for features that are off are queued as usual
+            uint8_t type = frame_type(packet->data, packet->len);
+            if (type == FRAME_BEACON && tdma_slots != 0 && packet->len == BEACON_LEN) {
+                radio_receive_beacon(packet);
+            } else if (type == FRAME_LARGE && large_buf != NULL && packet->len >= LARGE_HEADER_LEN) {
+                // fragments are copied out, and the slot is reused
+                radio_receive_fragment(packet);
+            } else if ((type == FRAME_RELIABLE_DATA || type == FRAME_RELIABLE_ACK)
+                && reliable && packet->len >= RELIABLE_HEADER_LEN) {
+                if (radio_receive_reliable(packet)) {
+                    radio_queue_packet(packet, rssi);
+                }
+            } else {
+                radio_queue_packet(packet, rssi);
+            }
+        } else {
+            radio_stats.crc_errors += 1;
+        }
+
+        if (ack_pending || beacon_pending || tx_ready() || tdma_retune) {
+            // an ACK is due, or packets were queued or the channel changed
+            // while this one was being received
+            radio_mode = RADIO_MODE_SWITCH;
+            NRF_RADIO->TASKS_DISABLE = 1;
+        } else {
+            NRF_RADIO->TASKS_START = 1;
+        }
+    } else {
+        NRF_RADIO->EVENTS_END = 0;
+    }
+
+    if (NRF_RADIO->EVENTS_DISABLED) {
+        NRF_RADIO->EVENTS_DISABLED = 0;
+
+        if (radio_mode == RADIO_MODE_SWITCH) {
+            if (NRF_RADIO->EVENTS_ADDRESS) {
+                // a packet started arriving just as the receiver was disabled
+                radio_stats.rx_lost += 1;
+            }
+        } else if (radio_mode == RADIO_MODE_TX) {
+            radio_stats.sent += 1;
+            radio_stats.tx_time_us += airtime_us(tx_slot(tx_tail)[0]);
+            tx_tail = tx_next(tx_tail);
+            if (tx_awaits_ack) {
+                // the DISABLED_RXEN shortcut has already enabled the receiver
+                radio_listen();
+                return;
+            }
+        } else if (radio_mode == RADIO_MODE_ACK) {
+            radio_stats.tx_time_us += airtime_us(ack_packet[0]);
+            ack_pending = false;
+        } else if (radio_mode == RADIO_MODE_BEACON) {
+            radio_stats.tx_time_us += airtime_us(beacon_packet[0]);
+            radio_stats.beacons += 1;
+            beacon_pending = false;
+        } else {
+            // disabled by radio_deinit() or radio_set_config()
+            return;
+        }
+
+        NRF_RADIO->FREQUENCY = radio_channel;
+        tdma_retune = false;
+        if (ack_pending) {
+            radio_start_control(ack_packet, RADIO_MODE_ACK);
+        } else if (beacon_pending) {
+            radio_start_control(beacon_packet, RADIO_MODE_BEACON);
+        } else if (tx_ready()) {
+            radio_start_tx();
+        } else {
+            radio_start_rx();
+        }
+    }
+}
+
+// Hand over to the IRQ handler if there's something to send or the channel
+// has changed, unless the radio is already sending or is in the middle of
+// receiving a packet, in which case the IRQ handler does so when it's done.
+// Must be called with the IRQ disabled.
+static void radio_switch(void) {
+    if ((beacon_pending || tx_ready() || tdma_retune)
+        && radio_mode == RADIO_MODE_RX && NRF_RADIO->EVENTS_ADDRESS == 0) {
+        radio_mode = RADIO_MODE_SWITCH;
+        NRF_RADIO->TASKS_DISABLE = 1;
+    }
+}
+
+static void radio_kick_tx(void) {
+    NVIC_DisableIRQ(RADIO_IRQn);
+    radio_switch();
+    NVIC_EnableIRQ(RADIO_IRQn);
+}
+
+void radio_flush_tx(void) {
+    // the IRQ handler sets both of these when the last packet is sent
+    while ((tx_tail != tx_head && tdma_synced) || radio_mode != RADIO_MODE_RX) {
+        __WFI();
+    }
+}
+
+void radio_tdma_tick(void) {
+    if (tdma_slots == 0 || tx_ring == NULL) {
+        return;
+    }
+    NVIC_DisableIRQ(RADIO_IRQn);
+    if (++tdma_tick_count == tdma_slots * slot_ticks) {
+        tdma_tick_count = 0;
+        tdma_frame += 1;
+        if (tdma_slot != 0 && tdma_synced && ++tdma_lost > RADIO_TDMA_LOST_FRAMES) {
+            tdma_synced = false;
+        }
+    }
+    tdma_update();
+    if (tdma_slot == 0 && tdma_tick_count == 1) {
+        beacon_packet[0] = BEACON_LEN;
+        frame_header(beacon_packet + 1, FRAME_BEACON);
+        put_uint32(beacon_packet + 1 + FRAME_HEADER_LEN, tdma_frame);
+        beacon_pending = true;
+    }
+    radio_switch();
+    NVIC_EnableIRQ(RADIO_IRQn);
+}
+
+bool radio_tdma_synced(void) {
+    return tdma_synced;
+}
+
+radio_packet_t *radio_peek(void) {
+    if (rx_tail == rx_head) {
+        return NULL;
+    }
+    return rx_slot(rx_tail);
+}
+
+void radio_pop(void) {
+    rx_tail = rx_next(rx_tail);
+}
+
+size_t radio_buffer_size(const radio_state_t *state) {
+    // round up so the metadata stays word aligned
+    size_t rx_size = (sizeof(radio_packet_t) + state->max_payload + 3) & ~3;
+    size_t tx_size = (state->max_payload + 1 + 3) & ~3;
+    // a slot for each queued packet, plus one for the radio to receive into
+    // and one left free to tell a full tx queue from an empty one, then the
+    // buffer for large messages
+    return rx_size * (state->queue_len + 1) + tx_size * (state->tx_queue_len + 1)
+        + ((state->large_len + 3) & ~3);
+}
+
+static uint8_t radio_random_byte(void) {
+    NRF_RNG->EVENTS_VALRDY = 0;
+    NRF_RNG->TASKS_START = 1;
+    RADIO_WAIT_FOR(NRF_RNG->EVENTS_VALRDY);
+    NRF_RNG->TASKS_STOP = 1;
+    return NRF_RNG->VALUE;
+}
+
+static void radio_disable_irq_and_wait(void) {
+    NVIC_DisableIRQ(RADIO_IRQn);
+    NRF_RADIO->EVENTS_DISABLED = 0;
+    NRF_RADIO->TASKS_DISABLE = 1;
+    RADIO_WAIT_FOR(NRF_RADIO->EVENTS_DISABLED);
+    NRF_RADIO->EVENTS_DISABLED = 0;
+}
+
+void radio_deinit(void) {
+    radio_disable_irq_and_wait();
+    NRF_RADIO->SHORTS = 0;
+    tdma_slots = 0;
+    // with no queue, radio_tx_slot() must drop packets instead of using it
+    tdma_synced = false;
+    if (tx_ring != NULL) {
+        radio_stats.tx_dropped += (tx_head + tx_slots - tx_tail) % tx_slots;
+        tx_ring = NULL;
+        rx_ring = NULL;
+        large_buf = NULL;
+    }
+}
+
+static void radio_set_registers(const radio_state_t *state) {
+    // power should be one of: -30, -20, -16, -12, -8, -4, 0, 4
+    NRF_RADIO->TXPOWER = state->power_dbm;
+
+    // should be between 0 and 100 inclusive (actual physical freq is 2400MHz + this register)
+    NRF_RADIO->FREQUENCY = state->channel;
+
+    // configure data rate
+    NRF_RADIO->MODE = state->data_rate;
+
+    // The radio supports filtering packets at the hardware level based on an address.
+    // We use a 5-byte address comprised of 4 bytes (set by BALEN=4 below) from the BASEx
+    // register, plus 1 byte from PREFIXm.APn.
+    // The (x,m,n) values are selected by the logical address.  We send on logical address 0
+    // which means using BASE0 with PREFIX0.AP0, and listen on logical addresses 0 up to
+    // num_addresses - 1.  Logical addresses 1-7 use BASE1, which is set the same as BASE0,
+    // with PREFIX0.AP1-3 and PREFIX1.AP4-7.
+    const uint8_t *prefix = state->prefix;
+    NRF_RADIO->BASE0 = state->base0;
+    NRF_RADIO->BASE1 = state->base0;
+    NRF_RADIO->PREFIX0 = prefix[0] | prefix[1] << 8 | prefix[2] << 16 | (uint32_t)prefix[3] << 24;
+    NRF_RADIO->PREFIX1 = prefix[4] | prefix[5] << 8 | prefix[6] << 16 | (uint32_t)prefix[7] << 24;
+    NRF_RADIO->RXADDRESSES = (1 << state->num_addresses) - 1; // a bit mask of logical addresses
+
+    reliable = state->reliable;
+    node_id = state->node_id;
+    random_state = node_id | 0x10000;
+    ack_pending = false;
+
+    // the coordinator starts a new frame, and the others wait for its beacon
+    tdma_slots = 0;
+    base_channel = state->channel;
+    radio_channel = state->channel;
+    tdma_retune = false;
+    beacon_pending = false;
+    tdma_slot = state->tdma_slot;
+    slot_ticks = state->slot_ticks;
+    hops = state->hops;
+    tdma_tick_count = 0;
+    tdma_frame = 0;
+    tdma_lost = 0;
+    tdma_synced = state->tdma_slots == 0 || state->tdma_slot == 0;
+    tdma_window = true;
+    if (state->tdma_slots != 0) {
+        tdma_update();
+    }
+    tdma_slots = state->tdma_slots;
+}
+
+void radio_init(const radio_state_t *state, uint8_t *buf) {
+    radio_deinit();
+
+    // the tx queue goes at the start of the buffer
+    tx_slots = state->tx_queue_len + 1;
+    tx_slot_size = (state->max_payload + 1 + 3) & ~3;
+    rx_slots = state->queue_len + 1;
+    rx_slot_size = (sizeof(radio_packet_t) + state->max_payload + 3) & ~3;
+    tx_ring = buf;
+    rx_ring = buf + tx_slot_size * tx_slots;
+    large_buf_size = state->large_len;
+    large_buf = large_buf_size == 0 ? NULL : rx_ring + rx_slot_size * rx_slots;
+    large_status = LARGE_EMPTY;
+    memset(peers, 0, sizeof(peers));
+    rx_head = 0;
+    rx_tail = 0;
+    tx_head = 0;
+    tx_tail = 0;
+
+    // Enable the High Frequency clock on the processor. This is a pre-requisite for
+    // the RADIO module. Without this clock, no communication is possible.
+    NRF_CLOCK->EVENTS_HFCLKSTARTED = 0;
+    NRF_CLOCK->TASKS_HFCLKSTART = 1;
+    RADIO_WAIT_FOR(NRF_CLOCK->EVENTS_HFCLKSTARTED);
+
+    // start the sequence somewhere new each time, so that a receiver which
+    // remembers this device from before doesn't drop its first packet as a
+    // repeat
+    reliable_seq = radio_random_byte();
+
+    radio_set_registers(state);
+    NRF_RADIO->TXADDRESS = 0; // transmit on logical address 0
+
+    // LFLEN=8 bits, S0LEN=0, S1LEN=0
+    NRF_RADIO->PCNF0 = 0x00000008;
+    // STATLEN=0, BALEN=4, ENDIAN=0 (little), WHITEEN=1
+    NRF_RADIO->PCNF1 = 0x02040000 | state->max_payload;
+
+    // Enable automatic 16bit CRC generation and checking, and configure how the CRC is calculated.
+    NRF_RADIO->CRCCNF = RADIO_CRCCNF_LEN_Two;
+    NRF_RADIO->CRCINIT = 0xFFFF;
+    NRF_RADIO->CRCPOLY = 0x11021;
+
+    // Set the start random value of the data whitening algorithm. This can be any non zero number.
+    NRF_RADIO->DATAWHITEIV = 0x18;
+
+    // configure interrupts
+    NRF_RADIO->EVENTS_END = 0;
+    NRF_RADIO->EVENTS_DISABLED = 0;
+    NRF_RADIO->INTENSET = RADIO_INTENSET_END_Msk | RADIO_INTENSET_DISABLED_Msk;
+    NVIC_ClearPendingIRQ(RADIO_IRQn);
+    NVIC_EnableIRQ(RADIO_IRQn);
+
+    // enable receiver, which starts listening as soon as it's ready
+    radio_start_rx();
+}
+
+void radio_set_config(const radio_state_t *state) {
+    // let anything queued go out with the old settings
+    radio_flush_tx();
+    radio_disable_irq_and_wait();
+
+    radio_set_registers(state);
+
+    // need to set RXEN for FREQUENCY decision point, and START
+    // (done by the READY_START shortcut) for the BASEx, PREFIXx and RXADDRESSES
+    NRF_RADIO->EVENTS_END = 0;
+    radio_start_rx();
+
+    NVIC_ClearPendingIRQ(RADIO_IRQn);
+    NVIC_EnableIRQ(RADIO_IRQn);
+}
+
+// Wait for a free slot in the queue and return it, or NULL if TDMA has lost
+// track of our slot, in which case the packet is counted as dropped.
+static uint8_t *radio_tx_slot(void) {
+    while (!tdma_synced || tx_next(tx_head) == tx_tail) {
+        if (!tdma_synced) {
+            radio_stats.tx_dropped += 1;
+            return NULL;
+        }
+        __WFI();
+    }
+    return tx_slot(tx_head);
+}
+
+// Queue the packet built in the slot from radio_tx_slot(), and let the IRQ
+// handler send it.
+static void radio_queue_tx(void) {
+    tx_head = tx_next(tx_head);
+    radio_kick_tx();
+}
+
+void radio_send(const void *buf, size_t len, const void *buf2, size_t len2) {
+    uint8_t *packet = radio_tx_slot();
+    if (packet == NULL) {
+        return;
+    }
+
+    // construct the packet
+    // note: we must send from RAM
+    size_t max_len = NRF_RADIO->PCNF1 & 0xff;
+    if (len + len2 > max_len) {
+        if (len > max_len) {
+            len = max_len;
+            len2 = 0;
+        } else {
+            len2 = max_len - len;
+        }
+    }
+    packet[0] = len + len2;
+    memcpy(packet + 1, buf, len);
+    if (len2 != 0) {
+        memcpy(packet + 1 + len, buf2, len2);
+    }
+    radio_queue_tx();
+}
+
+static size_t large_fragment_len(uint8_t max_payload) {
+    return max_payload > LARGE_HEADER_LEN ? max_payload - LARGE_HEADER_LEN : 0;
+}
+
+size_t radio_large_max_len(uint8_t max_payload) {
+    size_t max_len = large_fragment_len(max_payload) * RADIO_LARGE_MAX_FRAGMENTS;
+    // fragment offsets are 16 bits
+    return max_len <= 0xffff ? max_len : 0xffff;
+}
+
+void radio_send_large(const void *buf, size_t len) {
+    size_t fragment_len = large_fragment_len(NRF_RADIO->PCNF1 & 0xff);
+    size_t count = len == 0 ? 1 : (len + fragment_len - 1) / fragment_len;
+    uint8_t header[LARGE_HEADER_LEN];
+    frame_header(header, FRAME_LARGE);
+    header[3] = large_next_id++;
+    header[5] = count;
+    for (size_t i = 0; i < count; i++) {
+        size_t offset = i * fragment_len;
+        header[4] = i;
+        put_uint16(header + 6, offset);
+        radio_send(header, LARGE_HEADER_LEN, (const uint8_t*)buf + offset,
+            len - offset < fragment_len ? len - offset : fragment_len);
+    }
+}
+
+const uint8_t *radio_peek_large(size_t *len) {
+    if (large_status == LARGE_PARTIAL && ticks - large_ticks >= RADIO_LARGE_TIMEOUT_MS) {
+        // give up on a stalled message, unless a fragment just arrived
+        NVIC_DisableIRQ(RADIO_IRQn);
+        if (large_status == LARGE_PARTIAL && ticks - large_ticks >= RADIO_LARGE_TIMEOUT_MS) {
+            large_status = LARGE_EMPTY;
+        }
+        NVIC_EnableIRQ(RADIO_IRQn);
+    }
+    if (large_status != LARGE_COMPLETE) {
+        return NULL;
+    }
+    *len = large_len;
+    return large_buf;
+}
+
+void radio_pop_large(void) {
+    large_status = LARGE_EMPTY;
+}
+
+static uint32_t radio_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
+
+bool radio_send_reliable(uint16_t to, const void *buf, size_t len) {
+    // wait for anything already queued, so only this packet awaits an ACK
+    radio_flush_tx();
+
+    uint8_t header[RELIABLE_HEADER_LEN];
+    frame_header(header, FRAME_RELIABLE_DATA);
+    put_uint16(header + 3, node_id);
+    put_uint16(header + 5, to);
+    header[7] = ++reliable_seq;
+    ack_peer = to;
+    ack_seq = reliable_seq;
+
+    uint32_t timeout_ms = RADIO_RELIABLE_TIMEOUT_MS;
+    for (int retries = 0;; retries++) {
+        ack_received = false;
+        radio_send(header, RELIABLE_HEADER_LEN, buf, len);
+        // randomise the delay so that colliding senders drift apart
+        uint32_t start = ticks;
+        uint32_t wait_ms = timeout_ms + radio_random() % timeout_ms;
+        while (!ack_received && ticks - start < wait_ms) {
+            __WFI();
+        }
+        if (ack_received) {
+            return true;
+        }
+        if (retries == RADIO_RELIABLE_RETRIES) {
+            radio_stats.tx_failed += 1;
+            return false;
+        }
+        radio_stats.tx_retries += 1;
+        timeout_ms <<= 1;
+    }
+}
+
+/*****************************************************************************/
+// Benchmarks
+
+// Benchmark packets have a sequence number.
+#define BENCH_HEADER_LEN    (RADIO_BENCH_HEADER_LEN)
+
+static void bench_header(uint8_t *packet, uint8_t type, uint32_t seq) {
+    frame_header(packet, type);
+    put_uint32(packet + FRAME_HEADER_LEN, seq);
+}
+
+// Returns the type of a benchmark packet, or 0 for any other packet.
+static uint8_t bench_type(const radio_packet_t *packet, uint32_t *seq) {
+    uint8_t type = frame_type(packet->data, packet->len);
+    if (packet->len < BENCH_HEADER_LEN || type < FRAME_BENCH_FLOOD || type > FRAME_BENCH_PONG) {
+        return 0;
+    }
+    *seq = get_uint32(packet->data + FRAME_HEADER_LEN);
+    return type;
+}
+
+static uint8_t bench_len(uint8_t len) {
+    uint8_t max_len = NRF_RADIO->PCNF1 & 0xff;
+    if (len > max_len) {
+        len = max_len;
+    }
+    return len < BENCH_HEADER_LEN ? BENCH_HEADER_LEN : len;
+}
+
+// Build a benchmark packet, padded with zeros, straight into the tx queue.
+static void bench_send(uint8_t type, uint32_t seq, uint8_t len) {
+    uint8_t *packet = radio_tx_slot();
+    if (packet == NULL) {
+        return;
+    }
+    packet[0] = len;
+    bench_header(packet + 1, type, seq);
+    memset(packet + 1 + BENCH_HEADER_LEN, 0, len - BENCH_HEADER_LEN);
+    radio_queue_tx();
+}
+
+void radio_bench_flood(uint32_t count, uint8_t len, radio_bench_result_t *result, bool (*poll)(void)) {
+    memset(result, 0, sizeof(*result));
+    len = bench_len(len);
+    uint32_t start = ticks;
+    for (uint32_t seq = 0; seq < count && poll(); seq++) {
+        bench_send(FRAME_BENCH_FLOOD, seq, len);
+        result->packets += 1;
+    }
+    radio_flush_tx();
+    result->time_ms = ticks - start;
+}
+
+void radio_bench_sink(uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void)) {
+    memset(result, 0, sizeof(*result));
+    uint32_t first = 0;
+    uint32_t last = 0;
+    uint32_t expected = 0;
+    // wait as long as it takes for the first packet
+    while (poll() && (result->received == 0 || ticks - last < timeout_ms)) {
+        radio_packet_t *packet = radio_peek();
+        if (packet == NULL) {
+            continue;
+        }
+        uint32_t seq;
+        if (bench_type(packet, &seq) == FRAME_BENCH_FLOOD) {
+            if (result->received == 0) {
+                first = packet->ticks;
+            } else if (seq > expected) {
+                result->lost += seq - expected;
+            }
+            expected = seq + 1;
+            last = packet->ticks;
+            result->received += 1;
+        }
+        radio_pop();
+    }
+    result->packets = result->received;
+    result->time_ms = last - first;
+}
+
+void radio_bench_ping(uint32_t count, uint8_t len, uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void)) {
+    memset(result, 0, sizeof(*result));
+    len = bench_len(len);
+    uint32_t start = ticks;
+    for (uint32_t seq = 0; seq < count; seq++) {
+        uint32_t sent = ticks;
+        bench_send(FRAME_BENCH_PING, seq, len);
+        result->packets += 1;
+        bool waiting = true;
+        while (waiting && ticks - sent < timeout_ms) {
+            if (!poll()) {
+                goto done;
+            }
+            radio_packet_t *reply = radio_peek();
+            if (reply == NULL) {
+                continue;
+            }
+            uint32_t reply_seq;
+            if (bench_type(reply, &reply_seq) == FRAME_BENCH_PONG && reply_seq == seq) {
+                result->received += 1;
+                result->rtt_ms += reply->ticks - sent;
+                waiting = false;
+            }
+            radio_pop();
+        }
+    }
+done:
+    result->time_ms = ticks - start;
+}
+
+void radio_bench_echo(uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void)) {
+    memset(result, 0, sizeof(*result));
+    uint32_t first = 0;
+    uint32_t last = 0;
+    // wait as long as it takes for the first ping
+    while (poll() && (result->packets == 0 || ticks - last < timeout_ms)) {
+        radio_packet_t *packet = radio_peek();
+        if (packet == NULL) {
+            continue;
+        }
+        uint32_t seq;
+        if (bench_type(packet, &seq) == FRAME_BENCH_PING) {
+            // reply straight from the receive queue
+            packet->data[2] = FRAME_BENCH_PONG;
+            radio_send(packet->data, packet->len, NULL, 0);
+            if (result->packets == 0) {
+                first = packet->ticks;
+            }
+            last = packet->ticks;
+            result->packets += 1;
+        }
+        radio_pop();
+    }
+    result->received = result->packets;
+    result->time_ms = last - first;
+}
@@ -27,14 +27,26 @@ const int timetable[5][5] =
 
 extern void SamOutputByte(unsigned int pos, unsigned char b);
 
+static unsigned oldtimetableindex = 0;
+
 void Output(int index, unsigned char A)
 {
-    static unsigned oldtimetableindex = 0;
     bufferpos += timetable[oldtimetableindex][index];
     oldtimetableindex = index;
     SamOutputByte(bufferpos, (A & 15)*16);
 }
 
+// Output a run of formant (timetable index 0) samples.
+static void OutputBlock(const unsigned char *block, unsigned int n)
+{
+    unsigned int i;
+    for (i = 0; i < n; i++) {
+        bufferpos += timetable[oldtimetableindex][0];
+        oldtimetableindex = 0;
+        SamOutputByte(bufferpos, (block[i] & 15)*16);
+    }
+}
+
 
 
 //written by me because of different table positions.
@@ -142,23 +154,14 @@ void Write(sam_memory* sam, unsigned char p, unsigned char Y, unsigned char valu
 
 
 // Code48227()
-unsigned char RenderSample(sam_memory* sam, unsigned char *mem66, unsigned sample, unsigned char pos)
-{     
-	int tempA;
-	// current phoneme's index
-    unsigned char mem47;
-    unsigned char mem49 = pos;
-    unsigned char mem53;
-    unsigned char mem56;
-
-	// mask low three bits and subtract 1 get value to 
+// Start outputting the sampled consonant for the current frame. The sample is
+// then output a byte (8 bits) at a time by SampleByte().
+static void StartSample(sam_memory* sam, render_state_t *st)
+{
+	// mask low three bits and subtract 1 get value to
 	// convert 0 bits on unvoiced samples.
-	unsigned char A = sample&7;
-	unsigned char X = A-1;
+	unsigned char X = (st->sample & 7) - 1;
 
-    // store the result
-	mem56 = X;
-	
 	// determine which offset to use from table { 0x18, 0x1A, 0x17, 0x17, 0x17 }
 	// T, S, Z                0          0x18
 	// CH, J, SH, ZH          1          0x1A
@@ -169,132 +172,82 @@ unsigned char RenderSample(sam_memory* sam, unsigned char *mem66, unsigned sampl
     // get value from the table
     if (X >= sizeof(tab48426))
         sam_error = "Out-of-buffer read";
-	mem53 = tab48426[X];
-	mem47 = X;      //46016+mem[56]*256
-	
+	st->sample_zero = tab48426[X];
+	st->sample_table = X;      //46016+mem[56]*256
+
 	// voiced sample?
-	A = sample & 248;
+	unsigned char A = st->sample & 248;
 	if(A == 0)
 	{
         // voiced phoneme: Z*, ZH, V*, DH
-		pos = mem49;
-		A = sam->render.pitch[9] >> 4;
-		
-		// jump to voiced portion
-		goto pos48315;
-	}
-	
-	pos = A ^ 255;
-pos48274:
-         
-    // step through the 8 bits in the sample
-	mem56 = 8;
-	
-	// get the next sample from the table
-    // mem47*256 = offset to start of samples
-	A = sampleTable[mem47*256+pos];
-pos48280:
-
-    // left shift to get the high bit
-	tempA = A;
-	A = A << 1;
-	//48281: BCC 48290
-	
-	// bit not set?
-	if ((tempA & 128) == 0)
+        // number of samples?
+		st->sample_left = (sam->render.pitch[9] >> 4) ^ 255;
+		st->sample_pos = st->mem66;
+	} else
 	{
-        // convert the bit to value from table
-		X = mem53;
-		//mem[54296] = X;
-        // output the byte
-		Output(1, X);
-		// if X != 0, exit loop
-		if(X != 0) goto pos48296;
+		st->sample_pos = A ^ 255;
 	}
-	
-	// output a 5 for the on bit
-	Output(2, 5);
-
-	//48295: NOP
-pos48296:
-
-	X = 0;
-
-    // decrement counter
-	mem56--;
-	
-	// if not done, jump to top of loop
-	if (mem56 != 0) goto pos48280;
-	
-	// increment position
-	pos++;
-	if (pos != 0) goto pos48274;
-	
-	// restore values and return
-	pos = mem49;
-	return pos;
-
-
-	unsigned char phase1;
-
-pos48315:
-// handle voiced samples here
-
-   // number of samples?
-	phase1 = A ^ 255;
+	st->sampling = 1;
+}
 
-	pos = *mem66;
-	do
+// Output the next byte of the sample. Returns non-zero once the sample is done.
+static int SampleByte(render_state_t *st)
+{
+	// get the next sample from the table
+    // sample_table*256 = offset to start of samples
+	unsigned char A = sampleTable[st->sample_table*256 + st->sample_pos];
+	// step through the 8 bits in the sample
+	unsigned char bits = 8;
+	if (st->sample & 248)
 	{
-		//pos48321:
-
-        // shift through all 8 bits
-		mem56 = 8;
-		//A = Read(sam, mem47, pos);
-		
-		// fetch value from table
-		A = sampleTable[mem47*256+pos];
-
-        // loop 8 times
-		//pos48327:
 		do
 		{
-			//48327: ASL A
-			//48328: BCC 48337
-			
-			// left shift and check high bit
-			tempA = A;
-			A = A << 1;
-			if ((tempA & 128) != 0)
+			// bit not set?
+			if ((A & 128) == 0)
 			{
-                // if bit set, output 26
-				X = 26;
-				Output(3, X);
+				// convert the bit to value from table and output it
+				Output(1, st->sample_zero);
+				// if the value is not zero, skip the 5 below
+				if (st->sample_zero == 0) Output(2, 5);
 			} else
 			{
-				//timetable 4
-				// bit is not set, output a 6
-				X=6;
-				Output(4, X);
+				// output a 5 for the on bit
+				Output(2, 5);
 			}
+			A = A << 1;
+			bits--;
+		} while (bits != 0);
 
-			mem56--;
-		} while(mem56 != 0);
-
-        // move ahead in the table
-		pos++;
-		
-		// continue until counter done
-		phase1++;
+		// increment position, done when it wraps
+		st->sample_pos++;
+		return st->sample_pos == 0;
+	}
 
-	} while (phase1 != 0);
-	//	if (phase1 != 0) goto pos48321;
-	
-	// restore values and return
-	A = 1;
-	*mem66 = pos;
-	pos = mem49;
-	return pos;
+    // handle voiced samples here
+	do
+	{
+		if ((A & 128) != 0)
+		{
+            // if bit set, output 26
+			Output(3, 26);
+		} else
+		{
+			//timetable 4
+			// bit is not set, output a 6
+			Output(4, 6);
+		}
+		A = A << 1;
+		bits--;
+	} while (bits != 0);
+
+    // move ahead in the table
+	st->sample_pos++;
+
+	// continue until counter done
+	st->sample_left++;
+	if (st->sample_left != 0) return 0;
+	st->mem66 = st->sample_pos;
+	return 1;
 }
 
 
@@ -714,13 +667,27 @@ void Render(sam_memory* sam)
     OutputFrames(sam, mem48);
 }
 
-void OutputFrames(sam_memory *sam, unsigned char frame_count) {
+// Number of decrements of an unsigned char counter before it reaches zero.
+#define STEPS_TO_ZERO(c) ((c) == 0 ? 256 : (c))
 
-	unsigned char phase1 = 0;
-	unsigned char phase2 = 0;
-	unsigned char phase3 = 0;
-	unsigned char speedcounter = 72; //sam standard speed
-    unsigned char mem66 = 0;
+#define FORMANT_BLOCK 32
+
+// Sum the three formants for one sample. The low nibbles of sinus[] and
+// rectangle[] are always zero, so `multtable[sinus[phase] | amp]` is the same
+// as indexing the slice of multtable starting at `amp`.
+static inline unsigned char FormantSample(const unsigned char *mult1, const unsigned char *mult2,
+                                          const unsigned char *mult3, unsigned char phase1,
+                                          unsigned char phase2, unsigned char phase3)
+{
+	unsigned int sum = mult1[sinus[phase1]] + mult2[sinus[phase2]];
+	// Add the carry out of the 8 bit sum of the first two formants, as the 6502 does.
+	unsigned char A = sum + mult3[rectangle[phase3]] + (sum >> 8);
+	return ((A + 136) & 255) >> 4;
+}
+
+// Set up for OutputFramesStep() to output the first frame_count frames.
+void OutputFrames(sam_memory *sam, unsigned char frame_count) {
+	render_state_t *st = &sam->render.state;
 
     // RESCALE AMPLITUDE
     // Rescale volume from decibels to a linear scale.
@@ -731,15 +698,24 @@ void OutputFrames(sam_memory *sam, unsigned char frame_count) {
 		sam->render.freq_amp[i].amp3 = amplitudeRescale[sam->render.freq_amp[i].amp3];
 	}
 
-	unsigned char Y = 0;
 	unsigned char A = sam->render.pitch[0];
-	unsigned char glottal_pulse = A;
-	unsigned char count = A - (A>>2);     // 3/4*A ???
+	st->frame = 0;
+	st->frame_count = frame_count;
+	st->phase1 = 0;
+	st->phase2 = 0;
+	st->phase3 = 0;
+	st->speedcounter = 72; //sam standard speed
+	st->mem66 = 0;
+	st->glottal_pulse = A;
+	st->count = A - (A>>2);     // 3/4*A ???
+	st->sampling = 0;
+	st->rendering = 1;
 
     if (debug)
     {
         PrintOutput(sam->render.flags, sam->render.freq_amp, sam->render.pitch, frame_count);
     }
+}
 
 // PROCESS THE FRAMES
 //
@@ -749,91 +725,154 @@ void OutputFrames(sam_memory *sam, unsigned char frame_count) {
 // SAM generates these formants directly with sin and rectangular waves.
 // To simulate them being driven by the glottal pulse, the waveforms are
 // reset at the beginning of each glottal pulse.
+//
+// The frames are output a little at a time by OutputFramesStep(), which keeps
+// its place in sam->render.state between calls.
 
-	//finally the loop for sound output
-	//pos48078:
-	while(1)
+//pos48159:
+static void StartGlottalPulse(sam_memory *sam, render_state_t *st)
+{
+    // fetch the next glottal pulse length
+	unsigned char A = sam->render.pitch[st->frame];
+	st->glottal_pulse = A;
+	st->count = A - (A>>2);
+
+	// reset the formant wave generators to keep them in
+	// sync with the glottal pulse
+	st->phase1 = 0;
+	st->phase2 = 0;
+	st->phase3 = 0;
+}
+
+//pos48155:
+static void NextSample(sam_memory *sam, render_state_t *st)
+{
+    // decrement the remaining length of the glottal pulse
+	st->glottal_pulse--;
+
+	// finished with a glottal pulse?
+	if(st->glottal_pulse == 0)
 	{
-        // get the sampled information on the phoneme
-		A = sam->render.flags[Y];
-		unsigned char sample = A;
-		
-		// unvoiced sampled phoneme?
-		A = A & 248;
-		if(A != 0)
+		StartGlottalPulse(sam, st);
+		return;
+	}
+
+	// decrement the count
+	st->count--;
+
+	// is the count non-zero and the sampled flag is zero?
+	if((st->count != 0) || (st->sample == 0)) {
+        // reset the phase of the formants to match the pulse
+		st->phase1 += sam->render.freq_amp[st->frame].freq1;
+		st->phase2 += sam->render.freq_amp[st->frame].freq2;
+		st->phase3 += sam->render.freq_amp[st->frame].freq3;
+		return;
+	}
+
+	// voiced sampled phonemes interleave the sample with the
+	// glottal pulse. The sample flag is non-zero, so render
+	// the sample for the phoneme.
+	StartSample(sam, st);
+}
+
+// Returns 0 once the last frame is done.
+static int EndFrame(sam_memory *sam, render_state_t *st)
+{
+	// if the frame count is zero, exit the loop
+	if(st->frame_count == 0) return 0;
+	st->speedcounter = sam->common.speed;
+	NextSample(sam, st);
+	return 1;
+}
+
+int OutputFramesStep(sam_memory *sam)
+{
+	render_state_t *st = &sam->render.state;
+
+	if (st->sampling)
+	{
+		if (!SampleByte(st)) return 1;
+		st->sampling = 0;
+		if (st->sample & 248)
 		{
-            // render the sample for the phoneme
-			Y = RenderSample(sam, &mem66, sample, Y);
-			
 			// skip ahead two in the frame buffer
-			Y += 2;
-			frame_count -= 2;
-		} else
-		{
-            // simulate the glottal pulse and formants
-			unsigned char accum = multtable[sinus[phase1] | sam->render.freq_amp[Y].amp1];
-
-			int carry = 0;
-			if ((accum+multtable[sinus[phase2] | sam->render.freq_amp[Y].amp2] ) > 255) carry = 1;
-			accum += multtable[sinus[phase2] | sam->render.freq_amp[Y].amp2];
-			A = accum + multtable[rectangle[phase3] | sam->render.freq_amp[Y].amp3] + (carry?1:0);
-			A = ((A + 136) & 255) >> 4; //there must be also a carry
-			//mem[54296] = A;
-			
-			// output the accumulated value
-			Output(0, A);
-			speedcounter--;
-			if (speedcounter != 0) goto pos48155;
-			Y++; //go to next amplitude
-			
-			// decrement the frame count
-			frame_count--;
+			st->frame += 2;
+			st->frame_count -= 2;
+			return EndFrame(sam, st);
 		}
-		
-		// if the frame count is zero, exit the loop
-		if(frame_count == 0) 	return;
-		speedcounter = sam->common.speed;
-pos48155:
-         
-        // decrement the remaining length of the glottal pulse
-		glottal_pulse--;
-		
-		// finished with a glottal pulse?
-		if(glottal_pulse == 0)
+		StartGlottalPulse(sam, st);
+		return 1;
+	}
+
+    // get the sampled information on the phoneme
+	unsigned char sample = sam->render.flags[st->frame];
+	st->sample = sample;
+
+	// unvoiced sampled phoneme?
+	if((sample & 248) != 0)
+	{
+        // render the sample for the phoneme
+		StartSample(sam, st);
+		return 1;
+	}
+
+	// Render as many formant samples as possible before the frame ends, the
+	// glottal pulse ends or a sample is due, up to FORMANT_BLOCK of them.
+	// This leaves at least one sample for the general code below.
+	unsigned int run = STEPS_TO_ZERO(st->speedcounter);
+	if (STEPS_TO_ZERO(st->glottal_pulse) < run) run = STEPS_TO_ZERO(st->glottal_pulse);
+	if (sample != 0 && STEPS_TO_ZERO(st->count) < run) run = STEPS_TO_ZERO(st->count);
+	run--;
+	if (run > FORMANT_BLOCK) run = FORMANT_BLOCK;
+	render_freq_amp_t fa = sam->render.freq_amp[st->frame];
+	unsigned char phase1 = st->phase1, phase2 = st->phase2, phase3 = st->phase3;
+	if (run != 0)
+	{
+		const unsigned char *mult1 = multtable + fa.amp1;
+		const unsigned char *mult2 = multtable + fa.amp2;
+		const unsigned char *mult3 = multtable + fa.amp3;
+		unsigned char freq1 = fa.freq1, freq2 = fa.freq2, freq3 = fa.freq3;
+		unsigned char block[FORMANT_BLOCK];
+		st->speedcounter -= run;
+		st->glottal_pulse -= run;
+		st->count -= run;
+		unsigned int i;
+		for (i = 0; i < run; i++)
 		{
-pos48159:
-            // fetch the next glottal pulse length
-			A = sam->render.pitch[Y];
-			glottal_pulse = A;
-			A = A - (A>>2);
-			count = A;
-			
-			// reset the formant wave generators to keep them in 
-			// sync with the glottal pulse
-			phase1 = 0;
-			phase2 = 0;
-			phase3 = 0;
-			continue;
-		}
-		
-		// decrement the count
-		count--;
-		
-		// is the count non-zero and the sampled flag is zero?
-		if((count != 0) || (sample == 0)) {
-            // reset the phase of the formants to match the pulse
-			phase1 += sam->render.freq_amp[Y].freq1;
-			phase2 += sam->render.freq_amp[Y].freq2;
-			phase3 += sam->render.freq_amp[Y].freq3;
-			continue;
+			block[i] = FormantSample(mult1, mult2, mult3, phase1, phase2, phase3);
+			phase1 += freq1;
+			phase2 += freq2;
+			phase3 += freq3;
 		}
-		
-		// voiced sampled phonemes interleave the sample with the
-		// glottal pulse. The sample flag is non-zero, so render
-		// the sample for the phoneme.
-		Y = RenderSample(sam, &mem66, sample, Y);
-		goto pos48159;
+		OutputBlock(block, run);
+		st->phase1 = phase1;
+		st->phase2 = phase2;
+		st->phase3 = phase3;
 	}
+
+    // simulate the glottal pulse and formants
+	unsigned char accum = multtable[sinus[phase1] | fa.amp1];
+
+	int carry = 0;
+	if ((accum+multtable[sinus[phase2] | fa.amp2] ) > 255) carry = 1;
+	accum += multtable[sinus[phase2] | fa.amp2];
+	unsigned char A = accum + multtable[rectangle[phase3] | fa.amp3] + (carry?1:0);
+	A = ((A + 136) & 255) >> 4; //there must be also a carry
+	//mem[54296] = A;
+
+	// output the accumulated value
+	Output(0, A);
+	st->speedcounter--;
+	if (st->speedcounter != 0)
+	{
+		NextSample(sam, st);
+		return 1;
+	}
+	st->frame++; //go to next amplitude
+
+	// decrement the frame count
+	st->frame_count--;
+	return EndFrame(sam, st);
 }
 
 
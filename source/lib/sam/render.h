@@ -6,6 +6,7 @@
 void Render(sam_memory* sam);
 void SetMouthThroat(unsigned char mouth, unsigned char throat);
 void OutputFrames(sam_memory *sam, unsigned char frame_count);
+int OutputFramesStep(sam_memory *sam);
 
 /** Scaling c64 rate to sample rate */
 // Rate for 22.05kHz
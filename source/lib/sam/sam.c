@@ -92,7 +92,7 @@ void  ClearInput(sam_memory* sam) {
     sam->prepare.input_length = 0;
 }
 
-int SAMMain(sam_memory* sam)
+int SAMPrepare(sam_memory* sam)
 {
 	Init(sam);
 
@@ -130,7 +130,28 @@ int SAMMain(sam_memory* sam)
         PrintPhonemes("Processed phonemes", sam->prepare.phoneme_input);
     }
 
-	PrepareOutput(sam);
+	memset(&sam->render.state, 0, sizeof(sam->render.state));
+	return 1;
+}
+
+int SAMRender(sam_memory* sam)
+{
+	render_state_t *st = &sam->render.state;
+	while (!st->rendering)
+	{
+		if (st->finished)
+			return 0;
+		PrepareOutput(sam);
+	}
+	st->rendering = OutputFramesStep(sam);
+	return 1;
+}
+
+int SAMMain(sam_memory* sam)
+{
+	if (!SAMPrepare(sam))
+		return 0;
+	while (SAMRender(sam)) {}
     if (strcmp(sam_error, "OK"))
         return 0;
 	return 1;
@@ -138,10 +159,11 @@ int SAMMain(sam_memory* sam)
 
 
 //void Code48547()
+// Copy the next breath group to phoneme_output and start rendering it.
 void PrepareOutput(sam_memory* sam)
 {
 	unsigned char A = 0;
-	unsigned char X = 0;
+	unsigned char X = sam->render.state.input_pos;
 	unsigned char Y = 0;
 
 	//pos48551:
@@ -151,20 +173,18 @@ void PrepareOutput(sam_memory* sam)
 		if (A == PHONEME_END)
 		{
 			sam->common.phoneme_output[Y].index = PHONEME_END;
+			sam->render.state.finished = 1;
 			Render(sam);
 			return;
 		}
 		if (A == PHONEME_END_BREATH)
 		{
 			X++;
-			int temp = X;
 			//mem[48546] = X;
+			sam->render.state.input_pos = X;
 			sam->common.phoneme_output[Y].index = PHONEME_END;
 			Render(sam);
-			//X = mem[48546];
-			X=temp;
-			Y = 0;
-			continue;
+			return;
 		}
 
 		if (A == 0)
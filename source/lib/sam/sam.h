@@ -50,10 +50,33 @@ typedef struct _render_freq_amp_t {
     unsigned int amp3:4;
 } render_freq_amp_t;
 
+/* How far rendering has got, so that it can stop and carry on later. */
+typedef struct _render_state_t {
+    unsigned char input_pos;    // start of the next breath group in phoneme_input
+    unsigned char finished;     // no breath groups left to render
+    unsigned char rendering;    // the frames of a breath group are being output
+    unsigned char sampling;     // a sampled consonant is being output
+    unsigned char frame;
+    unsigned char frame_count;
+    unsigned char phase1;
+    unsigned char phase2;
+    unsigned char phase3;
+    unsigned char speedcounter;
+    unsigned char glottal_pulse;
+    unsigned char count;
+    unsigned char sample;
+    unsigned char mem66;
+    unsigned char sample_table;
+    unsigned char sample_zero;
+    unsigned char sample_pos;
+    unsigned char sample_left;
+} render_state_t;
+
 typedef struct _render_memory {
     render_freq_amp_t freq_amp[RENDER_FRAMES];
     unsigned char pitch[RENDER_FRAMES];
     unsigned char flags[RENDER_FRAMES];
+    render_state_t state;
 } render_memory;
 
 typedef struct _sam_memory {
@@ -66,6 +89,17 @@ void SetInput(sam_memory* mem, const char *_input, unsigned int len);
 
 int SAMMain(sam_memory* mem);
 
+/* SAMMain() in two halves, so that the output can be rendered a little at a
+ * time. SAMPrepare() returns 0 on error. SAMRender() renders the next part of
+ * the utterance, and returns 0 once all of it has been rendered. */
+int SAMPrepare(sam_memory* mem);
+int SAMRender(sam_memory* mem);
+
+/* The most that the position passed to SamOutputByte() advances in one call
+ * of SAMRender(): 33 formant samples, or the 16 outputs for a byte of a
+ * sampled consonant, each at most 226 positions on. */
+#define SAM_RENDER_STEP_MAX (33*226)
+
 extern char *sam_error;
 
 char* GetBuffer();
@@ -0,0 +1,145 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "lib/synth.h"
+
+// Voices are mixed in blocks of this many samples, one AudioFrame's worth.
+#define SYNTH_BLOCK 32
+
+static const int8_t waves[SYNTH_WAVE_COUNT][SYNTH_WAVE_SIZE] = {
+    // SYNTH_WAVE_SQUARE
+    { 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127, 127,
+      -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127 },
+    // SYNTH_WAVE_SINE
+    { 0, 25, 49, 71, 90, 106, 117, 125, 127, 125, 117, 106, 90, 71, 49, 25,
+      0, -25, -49, -71, -90, -106, -117, -125, -127, -125, -117, -106, -90, -71, -49, -25 },
+    // SYNTH_WAVE_TRIANGLE
+    { 0, 16, 32, 48, 64, 80, 96, 112, 127, 112, 96, 80, 64, 48, 32, 16,
+      0, -16, -32, -48, -64, -80, -96, -112, -127, -112, -96, -80, -64, -48, -32, -16 },
+    // SYNTH_WAVE_SAWTOOTH
+    { -128, -120, -112, -104, -96, -88, -80, -72, -64, -56, -48, -40, -32, -24, -16, -8,
+      0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120 },
+};
+
+/* 7812.5 samples per second is 125/16 samples per millisecond. */
+static inline uint32_t ms_to_samples(uint32_t ms) {
+    return (ms * 125) >> 4;
+}
+
+void synth_voice_start(synth_voice_t *voice, const synth_event_t *events, uint16_t len) {
+    voice->events = events;
+    voice->len = len;
+    voice->index = 0;
+    voice->phase = 0;
+    voice->phase_inc = 0;
+    voice->remaining = 0;
+    voice->articulate = false;
+}
+
+static void start_event(synth_voice_t *voice, const synth_event_t *event, uint16_t ms_per_tick) {
+    // The phase advances by 2**32 * 128 / period_us per sample. Notes above
+    // half the sample rate would alias, so they are played as rests.
+    if (event->period_us < 256) {
+        voice->phase_inc = 0;
+    } else {
+        voice->phase_inc = (0x80000000u / event->period_us) << 8;
+    }
+    // Cut off a short time from end of note so we hear articulation.
+    int32_t gap_ms = (int32_t)ms_per_tick * event->ticks - SYNTH_ARTICULATION_MS;
+    if (gap_ms < SYNTH_ARTICULATION_MS) {
+        gap_ms = SYNTH_ARTICULATION_MS;
+    }
+    voice->remaining = ms_to_samples(gap_ms);
+    voice->articulate = true;
+}
+
+/* Add `n` samples of a voice to `mix`. Returns false once the voice has finished. */
+static bool render_voice(synth_voice_t *voice, int32_t *mix, unsigned int n, uint16_t ms_per_tick) {
+    unsigned int pos = 0;
+    while (pos < n) {
+        if (voice->remaining == 0) {
+            if (voice->articulate) {
+                voice->articulate = false;
+                voice->phase_inc = 0;
+                voice->remaining = ms_to_samples(SYNTH_ARTICULATION_MS);
+            } else if (voice->index < voice->len) {
+                start_event(voice, &voice->events[voice->index++], ms_per_tick);
+            } else {
+                return false;
+            }
+        }
+        unsigned int run = n - pos;
+        if (run > voice->remaining) {
+            run = voice->remaining;
+        }
+        voice->remaining -= run;
+        int32_t volume = voice->volume;
+        uint32_t inc = voice->phase_inc;
+        if (inc == 0 || volume == 0) {
+            pos += run;
+            continue;
+        }
+        const int8_t *wave = waves[voice->waveform];
+        uint32_t phase = voice->phase;
+        int32_t *dest = mix + pos;
+        pos += run;
+        while (run--) {
+            *dest++ += wave[phase >> (32 - SYNTH_LOG_WAVE_SIZE)] * volume;
+            phase += inc;
+        }
+        voice->phase = phase;
+    }
+    return true;
+}
+
+unsigned int synth_render(synth_voice_t *voices, unsigned int voice_count, uint16_t ms_per_tick, uint8_t *out, unsigned int n) {
+    unsigned int playing = 0;
+    while (n > 0) {
+        int32_t mix[SYNTH_BLOCK];
+        unsigned int len = n < SYNTH_BLOCK ? n : SYNTH_BLOCK;
+        memset(mix, 0, sizeof(mix));
+        playing = 0;
+        for (unsigned int v = 0; v < voice_count; v++) {
+            playing += render_voice(&voices[v], mix, len, ms_per_tick);
+        }
+        // Each voice contributes up to +/-64 at full volume, so two voices
+        // fill the output range and more than that saturate.
+        for (unsigned int i = 0; i < len; i++) {
+            int32_t sample = 128 + (mix[i] >> 9);
+            if (sample < 0) {
+                sample = 0;
+            } else if (sample > 255) {
+                sample = 255;
+            }
+            out[i] = sample;
+        }
+        out += len;
+        n -= len;
+    }
+    return playing;
+}
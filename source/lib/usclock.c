@@ -0,0 +1,156 @@
+/*
+ * This file is part of the Micro Python project, http://micropython.org/
+ *
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2016 The micro:bit MicroPython contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stddef.h>
+#include "nrf_delay.h"
+#include "lib/usclock.h"
+
+#define Clock_IRQn TIMER2_IRQn
+#define Clock_IRQHandler TIMER2_IRQHandler
+
+#define CALLBACK_CC 2
+#define OVERFLOW_CC 3
+
+// The least time ahead that the next compare can be set for, to be sure the
+// timer hasn't already passed it by the time it is written.
+#define MIN_CALLBACK_DELAY 4
+
+static uint8_t users;
+static volatile uint32_t clock_high;
+static usclock_callback_t callback;
+static uint32_t callback_missed;
+
+void usclock_start(void) {
+    if (users++ > 0) {
+        return;
+    }
+    NRF_TIMER_Type *clock = USCLOCK;
+    clock->POWER = 1;
+    __NOP();
+    clock->TASKS_STOP = 1;
+    clock->TASKS_CLEAR = 1;
+    clock->MODE = TIMER_MODE_MODE_Timer;
+    clock->BITMODE = TIMER_BITMODE_BITMODE_16Bit << TIMER_BITMODE_BITMODE_Pos;
+    clock->PRESCALER = 4; // 1 tick == 1 microsecond
+    clock->SHORTS = 0;
+    clock->CC[OVERFLOW_CC] = 0;
+    clock->EVENTS_COMPARE[CALLBACK_CC] = 0;
+    clock->EVENTS_COMPARE[OVERFLOW_CC] = 0;
+    clock->INTENSET = TIMER_INTENSET_COMPARE3_Msk;
+    clock_high = 0;
+    NVIC_SetPriority(Clock_IRQn, USCLOCK_PRIORITY);
+    NVIC_EnableIRQ(Clock_IRQn);
+    // Workaround for Anomaly 73, as in the ticker.
+    *(uint32_t *)0x4000AC0C = 1; //for Timer 2
+    clock->TASKS_START = 1;
+}
+
+void usclock_stop(void) {
+    if (users == 0 || --users > 0) {
+        return;
+    }
+    NVIC_DisableIRQ(Clock_IRQn);
+    USCLOCK->TASKS_STOP = 1;
+    *(uint32_t *)0x4000AC0C = 0; //for Timer 2
+    USCLOCK->INTENCLR = TIMER_INTENCLR_COMPARE2_Msk | TIMER_INTENCLR_COMPARE3_Msk;
+    callback = NULL;
+}
+
+void Clock_IRQHandler(void) {
+    NRF_TIMER_Type *clock = USCLOCK;
+    if (clock->EVENTS_COMPARE[OVERFLOW_CC]) {
+        clock->EVENTS_COMPARE[OVERFLOW_CC] = 0;
+        clock_high += 0x10000;
+    }
+    if (clock->EVENTS_COMPARE[CALLBACK_CC]) {
+        clock->EVENTS_COMPARE[CALLBACK_CC] = 0;
+        uint32_t due = clock->CC[CALLBACK_CC];
+        uint32_t delay = callback == NULL ? 0 : callback(callback_missed);
+        callback_missed = 0;
+        if (delay == 0) {
+            usclock_clear_callback();
+        } else {
+            /* If this interrupt ran so late that the next compare time has
+             * passed, the timer would only reach it after wrapping, 65ms
+             * later.  Skip the compares that were missed instead, and tell
+             * the callback how many next time. */
+            clock->TASKS_CAPTURE[CALLBACK_CC] = 1;
+            uint32_t late = (clock->CC[CALLBACK_CC] - due) & 0xffff;
+            callback_missed = (late + MIN_CALLBACK_DELAY) / delay;
+            clock->CC[CALLBACK_CC] = (due + delay * (callback_missed + 1)) & 0xffff;
+        }
+    }
+}
+
+/* The clock's interrupt can't run while the caller's does, so the clock may
+ * have wrapped without clock_high being updated yet; if so, small captures
+ * were taken after it wrapped. */
+uint32_t usclock_extend(uint32_t captured) {
+    uint32_t high = clock_high;
+    if (USCLOCK->EVENTS_COMPARE[OVERFLOW_CC] && captured < 0x8000) {
+        high += 0x10000;
+    }
+    return (high + captured) & USCLOCK_TIME_MASK;
+}
+
+/* There is no spare CC to capture the time into, so borrow the one that
+ * catches the timer wrapping, with interrupts off.  It is put back well
+ * within a microsecond, so the wrap can only be missed if the capture was
+ * the last count before it; then wait until the timer has certainly
+ * wrapped, and count the wrap here if the compare didn't see it. */
+uint32_t usclock_now(void) {
+    NRF_TIMER_Type *clock = USCLOCK;
+    uint32_t irq_state = __get_PRIMASK();
+    __disable_irq();
+    clock->TASKS_CAPTURE[OVERFLOW_CC] = 1;
+    uint32_t captured = clock->CC[OVERFLOW_CC];
+    clock->CC[OVERFLOW_CC] = 0;
+    uint32_t now = usclock_extend(captured);
+    if (captured == 0xffff) {
+        nrf_delay_us(2);
+        if (!clock->EVENTS_COMPARE[OVERFLOW_CC]) {
+            clock_high += 0x10000;
+        }
+    }
+    __set_PRIMASK(irq_state);
+    return now;
+}
+
+void usclock_set_callback(usclock_callback_t func, uint32_t delay_us) {
+    NRF_TIMER_Type *clock = USCLOCK;
+    clock->INTENCLR = TIMER_INTENCLR_COMPARE2_Msk;
+    callback = func;
+    callback_missed = 0;
+    clock->TASKS_CAPTURE[CALLBACK_CC] = 1;
+    clock->CC[CALLBACK_CC] = (clock->CC[CALLBACK_CC] + delay_us) & 0xffff;
+    clock->EVENTS_COMPARE[CALLBACK_CC] = 0;
+    clock->INTENSET = TIMER_INTENSET_COMPARE2_Msk;
+}
+
+void usclock_clear_callback(void) {
+    USCLOCK->INTENCLR = TIMER_INTENCLR_COMPARE2_Msk;
+    callback = NULL;
+}
@@ -7,6 +7,7 @@ extern "C" {
 #include "lib/ticker.h"
 #include "filesystem.h"
 #include "lib/pwm.h"
+#include "lib/radio.h"
 
     void mp_run(void);
     
@@ -47,10 +48,14 @@ void app_main() {
 extern "C" {
 
 extern void compass_tick(void);
+extern void accelerometer_tick(void);
 
 void microbit_ticker(void) {
     accelerometer_up_to_date = false;
 
+    // Take a sample for the accelerometer's sampler
+    accelerometer_tick();
+
     // Update buttons and pins with touch.
     microbit_button_tick();
 
@@ -64,6 +69,9 @@ void microbit_ticker(void) {
     compass_tick();
     compass_up_to_date = false;
 
+    // Keep time for the radio's TDMA slots
+    radio_tdma_tick();
+
 }
 
 // We need to override this function so that the linker does not pull in
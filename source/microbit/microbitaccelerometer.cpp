@@ -28,8 +28,14 @@
 
 extern "C" {
 
+#include "lib/ticker.h"
+#include "lib/motion.h"
+#include "lib/neopixel.h"
 #include "py/runtime.h"
+#include "py/binary.h"
 #include "modmicrobit.h"
+#include "microbitobj.h"
+#include "nrf_gpio.h"
 
 typedef struct _microbit_accelerometer_obj_t {
     mp_obj_base_t base;
@@ -47,7 +53,7 @@ volatile uint16_t gesture_state = 0;                    // 1 bit per gesture
 volatile uint8_t gesture_list_cur = 0;                  // index into gesture_list
 volatile uint8_t gesture_list[GESTURE_LIST_SIZE] = {0}; // list of pending gestures, 4-bits per element
 
-static void update(microbit_accelerometer_obj_t *self) {
+static void update(const microbit_accelerometer_obj_t *self) {
     /* The only time it is possible for accelerometer_updating to be true here
      * is if this is called in an interrupt when it is already updating in
      * the main execution thread. This is extremely unlikely, so we just
@@ -104,24 +110,255 @@ mp_obj_t microbit_accelerometer_get_z(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_z_obj, microbit_accelerometer_get_z);
 
-void microbit_accelerometer_get_values(microbit_accelerometer_obj_t *self, int *x, int *y, int *z) {
+void microbit_accelerometer_get_values(const microbit_accelerometer_obj_t *self, int *x, int *y, int *z) {
     update(self);
     *x = self->accelerometer->getX();
     *y = self->accelerometer->getY();
     *z = self->accelerometer->getZ();
 }
 
-static mp_obj_t microbit_accelerometer_get_values_func(mp_obj_t self_in) {
-    microbit_accelerometer_obj_t *self = (microbit_accelerometer_obj_t*)self_in;
-    int x, y, z;
-    microbit_accelerometer_get_values(self, &x, &y, &z);
+static mp_obj_t microbit_accelerometer_get_values_func(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_into, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    microbit_accelerometer_obj_t *self = (microbit_accelerometer_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    int values[3];
+    microbit_accelerometer_get_values(self, &values[0], &values[1], &values[2]);
+    if (args[0].u_obj != mp_const_none) {
+        return microbit_obj_store_values(args[0].u_obj, values, 3);
+    }
     mp_obj_tuple_t *tuple = (mp_obj_tuple_t *)mp_obj_new_tuple(3, NULL);
-    tuple->items[0] = mp_obj_new_int(x);
-    tuple->items[1] = mp_obj_new_int(y);
-    tuple->items[2] = mp_obj_new_int(z);
+    tuple->items[0] = mp_obj_new_int(values[0]);
+    tuple->items[1] = mp_obj_new_int(values[1]);
+    tuple->items[2] = mp_obj_new_int(values[2]);
     return tuple;
 }
-MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_values_obj, microbit_accelerometer_get_values_func);
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_accelerometer_get_values_obj, 1, microbit_accelerometer_get_values_func);
+
+/* The background sampler.  The ticker reads each new sample as soon as the
+ * accelerometer signals that it is ready, and puts it in a ring of x, y, z
+ * triples for read_samples() to copy out.  The MMA8653 has no FIFO, so the
+ * fastest rate is one sample per ticker period.  When the ring is full, new
+ * samples are dropped and counted, so that what has been read is never
+ * overwritten half way through a copy.
+ */
+typedef struct _accelerometer_sampler_t {
+    volatile uint16_t head;
+    volatile uint16_t tail;
+    uint16_t len;
+    volatile uint32_t overruns;
+    int16_t samples[];
+} accelerometer_sampler_t;
+
+#define sampler MP_STATE_PORT(accelerometer_sampler)
+
+// The motion features, also updated from the ticker for each new sample.
+#define motion MP_STATE_PORT(accelerometer_motion)
+
+extern uint32_t ticks;
+
+static void sampler_add(accelerometer_sampler_t *s, int x, int y, int z) {
+    uint16_t next = s->head + 1;
+    if (next == s->len) {
+        next = 0;
+    }
+    if (next == s->tail) {
+        s->overruns++;
+        return;
+    }
+    int16_t *sample = &s->samples[3 * s->head];
+    sample[0] = x;
+    sample[1] = y;
+    sample[2] = z;
+    s->head = next;
+}
+
+void accelerometer_tick(void) {
+    accelerometer_sampler_t *s = sampler;
+    motion_t *m = motion;
+    if ((s == NULL && m == NULL) || accelerometer_updating || neopixel_sending) {
+        return;
+    }
+    // The data ready line is active low.
+    if (nrf_gpio_pin_read(MICROBIT_PIN_ACCEL_DATA_READY)) {
+        return;
+    }
+    accelerometer_updating = true;
+    uBit.accelerometer.idleTick();
+    accelerometer_updating = false;
+    accelerometer_up_to_date = true;
+    int x = uBit.accelerometer.getX();
+    int y = uBit.accelerometer.getY();
+    int z = uBit.accelerometer.getZ();
+    if (m != NULL) {
+        motion_update(m, x, y, z, ticks);
+    }
+    if (s != NULL) {
+        sampler_add(s, x, y, z);
+    }
+}
+
+STATIC mp_obj_t microbit_accelerometer_stop_sampling(mp_obj_t self_in) {
+    (void)self_in;
+    accelerometer_sampler_t *s = sampler;
+    if (s != NULL) {
+        sampler = NULL;
+        m_del_var(accelerometer_sampler_t, int16_t, 3 * s->len, s);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_stop_sampling_obj, microbit_accelerometer_stop_sampling);
+
+STATIC mp_obj_t microbit_accelerometer_start_sampling(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_period, MP_ARG_INT, {.u_int = 20} },
+        { MP_QSTR_length, MP_ARG_INT, {.u_int = 64} },
+    };
+    microbit_accelerometer_obj_t *self = (microbit_accelerometer_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_int_t period = args[0].u_int;
+    mp_int_t length = args[1].u_int;
+    if (period < MILLISECONDS_PER_MACRO_TICK) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "period too short"));
+    }
+    if (length < 1 || length > 4096) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid length"));
+    }
+    microbit_accelerometer_stop_sampling(self);
+    // The ring keeps one slot empty to tell full from empty.
+    accelerometer_sampler_t *s = m_new_obj_var(accelerometer_sampler_t, int16_t, 3 * (length + 1));
+    s->head = 0;
+    s->tail = 0;
+    s->len = length + 1;
+    s->overruns = 0;
+    self->accelerometer->setPeriod(period);
+    sampler = s;
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_accelerometer_start_sampling_obj, 1, microbit_accelerometer_start_sampling);
+
+STATIC mp_obj_t microbit_accelerometer_read_samples(mp_obj_t self_in, mp_obj_t buf_in) {
+    (void)self_in;
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    accelerometer_sampler_t *s = sampler;
+    if (s == NULL) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "not sampling"));
+    }
+    // Copy whole samples in the element type of buf, oldest first.  The
+    // ticker only moves head, so the samples up to it can be read here
+    // without stopping it.
+    size_t max = bufinfo.len / mp_binary_get_size('@', bufinfo.typecode, NULL) / 3;
+    size_t count = 0;
+    uint16_t tail = s->tail;
+    uint16_t head = s->head;
+    while (count < max && tail != head) {
+        for (int i = 0; i < 3; i++) {
+            mp_binary_set_val_array_from_int(bufinfo.typecode, bufinfo.buf, 3 * count + i, s->samples[3 * tail + i]);
+        }
+        if (++tail == s->len) {
+            tail = 0;
+        }
+        count++;
+    }
+    s->tail = tail;
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(microbit_accelerometer_read_samples_obj, microbit_accelerometer_read_samples);
+
+STATIC mp_obj_t microbit_accelerometer_overruns(mp_obj_t self_in) {
+    (void)self_in;
+    accelerometer_sampler_t *s = sampler;
+    return mp_obj_new_int_from_uint(s == NULL ? 0 : s->overruns);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_overruns_obj, microbit_accelerometer_overruns);
+
+STATIC mp_obj_t microbit_accelerometer_stop_tracking(mp_obj_t self_in) {
+    (void)self_in;
+    motion_t *m = motion;
+    if (m != NULL) {
+        motion = NULL;
+        m_del_var(motion_t, uint16_t, m->window, m);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_stop_tracking_obj, microbit_accelerometer_stop_tracking);
+
+STATIC mp_obj_t microbit_accelerometer_start_tracking(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_window,    MP_ARG_INT, {.u_int = 50} },
+        { MP_QSTR_threshold, MP_ARG_INT, {.u_int = 200} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_int_t window = args[0].u_int;
+    mp_int_t threshold = args[1].u_int;
+    if (window < 1 || window > MOTION_MAX_WINDOW) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid window"));
+    }
+    if (threshold < 0 || threshold > MOTION_MAX_MAGNITUDE) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid threshold"));
+    }
+    microbit_accelerometer_stop_tracking(pos_args[0]);
+    motion_t *m = m_new_obj_var(motion_t, uint16_t, window);
+    motion_init(m, window, threshold);
+    motion = m;
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_accelerometer_start_tracking_obj, 1, microbit_accelerometer_start_tracking);
+
+static const motion_t *get_motion(void) {
+    const motion_t *m = motion;
+    if (m == NULL) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "not tracking"));
+    }
+    return m;
+}
+
+STATIC mp_obj_t microbit_accelerometer_get_magnitude(mp_obj_t self_in) {
+    (void)self_in;
+    return MP_OBJ_NEW_SMALL_INT(get_motion()->magnitude);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_magnitude_obj, microbit_accelerometer_get_magnitude);
+
+STATIC mp_obj_t microbit_accelerometer_get_mean(mp_obj_t self_in) {
+    (void)self_in;
+    return MP_OBJ_NEW_SMALL_INT(motion_mean(get_motion()));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_mean_obj, microbit_accelerometer_get_mean);
+
+STATIC mp_obj_t microbit_accelerometer_get_variance(mp_obj_t self_in) {
+    (void)self_in;
+    return mp_obj_new_int_from_uint(motion_variance(get_motion()));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_variance_obj, microbit_accelerometer_get_variance);
+
+STATIC mp_obj_t microbit_accelerometer_get_crossing_rate(mp_obj_t self_in) {
+    microbit_accelerometer_obj_t *self = (microbit_accelerometer_obj_t*)self_in;
+    return mp_obj_new_int_from_uint(motion_crossing_rate(get_motion(), self->accelerometer->getPeriod()));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_crossing_rate_obj, microbit_accelerometer_get_crossing_rate);
+
+STATIC mp_obj_t microbit_accelerometer_get_peak(mp_obj_t self_in) {
+    (void)self_in;
+    return MP_OBJ_NEW_SMALL_INT(get_motion()->peak);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_peak_obj, microbit_accelerometer_get_peak);
+
+STATIC mp_obj_t microbit_accelerometer_get_peaks(mp_obj_t self_in) {
+    (void)self_in;
+    return mp_obj_new_int_from_uint(get_motion()->peaks);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_peaks_obj, microbit_accelerometer_get_peaks);
+
+STATIC mp_obj_t microbit_accelerometer_get_steps(mp_obj_t self_in) {
+    (void)self_in;
+    return mp_obj_new_int_from_uint(get_motion()->steps);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_accelerometer_get_steps_obj, microbit_accelerometer_get_steps);
 
 STATIC const qstr gesture_name_map[] = {
     [GESTURE_NONE] = MP_QSTR_NULL,
@@ -199,6 +436,19 @@ STATIC const mp_map_elem_t microbit_accelerometer_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_is_gesture), (mp_obj_t)&microbit_accelerometer_is_gesture_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_was_gesture), (mp_obj_t)&microbit_accelerometer_was_gesture_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_gestures), (mp_obj_t)&microbit_accelerometer_get_gestures_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_start_sampling), (mp_obj_t)&microbit_accelerometer_start_sampling_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_stop_sampling), (mp_obj_t)&microbit_accelerometer_stop_sampling_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_samples), (mp_obj_t)&microbit_accelerometer_read_samples_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_overruns), (mp_obj_t)&microbit_accelerometer_overruns_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_start_tracking), (mp_obj_t)&microbit_accelerometer_start_tracking_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_stop_tracking), (mp_obj_t)&microbit_accelerometer_stop_tracking_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_magnitude), (mp_obj_t)&microbit_accelerometer_get_magnitude_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_mean), (mp_obj_t)&microbit_accelerometer_get_mean_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_variance), (mp_obj_t)&microbit_accelerometer_get_variance_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_crossing_rate), (mp_obj_t)&microbit_accelerometer_get_crossing_rate_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_peak), (mp_obj_t)&microbit_accelerometer_get_peak_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_peaks), (mp_obj_t)&microbit_accelerometer_get_peaks_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_steps), (mp_obj_t)&microbit_accelerometer_get_steps_obj },
 };
 
 STATIC MP_DEFINE_CONST_DICT(microbit_accelerometer_locals_dict, microbit_accelerometer_locals_dict_table);
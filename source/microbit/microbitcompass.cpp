@@ -29,6 +29,9 @@
 extern "C" {
 
 #include "lib/ticker.h"
+#include "lib/compassfit.h"
+#include "lib/orientation.h"
+#include "lib/neopixel.h"
 #include "py/runtime.h"
 #include "modmicrobit.h"
 #include "py/mphal.h"
@@ -43,6 +46,14 @@ typedef struct _persistent_compass_calibration {
     int x;
     int y;
     int z;
+    /* Soft iron corrections, as the amount to add to COMPASS_FIT_ONE to get
+     * the scale of each axis, so that an erased page means no correction. */
+    int scale_x;
+    int scale_y;
+    int scale_z;
+    /* How far the samples were from a sphere in a background calibration, in
+     * parts per thousand, or 0 if it was calibrated some other way. */
+    int error;
 } persistent_compass_calibration;
 
 typedef struct _point {
@@ -77,6 +88,23 @@ static inline volatile persistent_compass_calibration *get_calibration(void) {
     return (volatile persistent_compass_calibration *)&data.calibration;
 }
 
+#define compass_fit MP_STATE_PORT(compass_fit)
+
+/* While calibrating in the background, the latest fit is used in place of
+ * the saved calibration, and saved only when it is a clear improvement. */
+static persistent_compass_calibration fitted_calibration;
+static bool fitted = false;
+static volatile bool fit_solving = false;
+
+static void refine_calibration(void);
+
+static inline const volatile persistent_compass_calibration *current_calibration(void) {
+    if (compass_fit != NULL && fitted) {
+        return &fitted_calibration;
+    }
+    return get_calibration();
+}
+
 typedef struct _microbit_compass_obj_t {
     mp_obj_base_t base;
     MicroBitCompass *compass;
@@ -84,7 +112,8 @@ typedef struct _microbit_compass_obj_t {
 
 mp_obj_t microbit_compass_is_calibrated(mp_obj_t self_in) {
     (void)self_in;
-    return mp_obj_new_bool(get_calibration()->calibrated);
+    refine_calibration();
+    return mp_obj_new_bool(current_calibration()->calibrated);
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_is_calibrated_obj, microbit_compass_is_calibrated);
 
@@ -107,7 +136,25 @@ static void update(const microbit_compass_obj_t *self) {
 
 #define calibration_data MP_STATE_PORT(compass_calibration_data)
 
+static void orientation_sample(orientation_t *state);
+
 void compass_tick(void) {
+    // The I2C reads would pause a NeoPixel strip for long enough to latch it.
+    if (neopixel_sending) {
+        return;
+    }
+
+    orientation_t *state = MP_STATE_PORT(orientation);
+    if (state != NULL) {
+        orientation_sample(state);
+    }
+
+    compass_fit_t *fit = compass_fit;
+    if (fit != NULL && !fit_solving) {
+        update(&microbit_compass_obj);
+        compass_fit_add(fit, uBit.compass.getX(RAW) >> 4, uBit.compass.getY(RAW) >> 4, uBit.compass.getZ(RAW) >> 4);
+    }
+
     /** If compass is calibrating see if sample is on periphery
      *  and record it if it is.
      */
@@ -227,15 +274,85 @@ static float cos_angle(point *a, point *b, point *common) {
     return res;
 }
 
-static void microbit_compass_save_calibration(bool calibrated, int x, int y, int z) {
+static void save_calibration(const persistent_compass_calibration *calibration) {
     persistent_erase_page((const void *)&data);
+    persistent_write_unchecked((const void *)&data, calibration, sizeof(persistent_compass_calibration));
+}
+
+static void microbit_compass_save_calibration(bool calibrated, int x, int y, int z) {
     persistent_compass_calibration calibration;
     calibration.calibrated = calibrated;
     calibration.x = x;
     calibration.y = y;
     calibration.z = z;
-    persistent_write_unchecked((const void *)&data, &calibration, sizeof(persistent_compass_calibration));
+    calibration.scale_x = 0;
+    calibration.scale_y = 0;
+    calibration.scale_z = 0;
+    calibration.error = 0;
+    save_calibration(&calibration);
+    fitted = false;
+}
+
+// New samples needed before the background fit is solved again.
+#define REFINE_SAMPLES 32
+// The largest error, in parts per thousand, of a fit that will be used.
+#define MAX_FIT_ERROR 60
+// The fewest buckets in a fit that will be saved.
+#define SAVE_BUCKETS 20
+
+/* Solve the background fit if there are enough new samples.  This takes a
+ * few milliseconds, so it is done here, when the compass is read from
+ * Python, rather than in the ticker. */
+static void refine_calibration(void) {
+    compass_fit_t *fit = compass_fit;
+    if (fit == NULL || fit->added < REFINE_SAMPLES) {
+        return;
+    }
+    compass_fit_result_t result;
+    fit_solving = true;
+    bool solved = compass_fit_solve(fit, &result);
+    fit_solving = false;
+    if (!solved || result.error > MAX_FIT_ERROR) {
+        return;
+    }
+    persistent_compass_calibration calibration;
+    calibration.calibrated = true;
+    calibration.x = result.centre[0] << 4;
+    calibration.y = result.centre[1] << 4;
+    calibration.z = result.centre[2] << 4;
+    calibration.scale_x = result.scale[0] - COMPASS_FIT_ONE;
+    calibration.scale_y = result.scale[1] - COMPASS_FIT_ONE;
+    calibration.scale_z = result.scale[2] - COMPASS_FIT_ONE;
+    calibration.error = result.error > 0 ? result.error : 1;
+    // The ticker reads the calibration, so it mustn't see half of each fit.
+    __disable_irq();
+    fitted_calibration = calibration;
+    fitted = true;
+    __enable_irq();
+    // Spare the flash by only saving fits that are clearly better.
+    const volatile persistent_compass_calibration *saved = get_calibration();
+    if (result.buckets >= SAVE_BUCKETS && (!saved->calibrated || saved->error == 0
+        || calibration.error * 8 < saved->error * 7)) {
+        save_calibration(&calibration);
+    }
+}
+
+STATIC mp_obj_t microbit_compass_auto_calibrate(mp_uint_t n_args, const mp_obj_t *args) {
+    bool on = n_args < 2 || mp_obj_is_true(args[1]);
+    compass_fit_t *fit = compass_fit;
+    if (fit != NULL) {
+        compass_fit = NULL;
+        m_del_obj(compass_fit_t, fit);
+    }
+    fitted = false;
+    if (on) {
+        fit = m_new_obj(compass_fit_t);
+        compass_fit_init(fit);
+        compass_fit = fit;
+    }
+    return mp_const_none;
 }
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(microbit_compass_auto_calibrate_obj, 1, 2, microbit_compass_auto_calibrate);
 
 #define MIN_SEPARATION (6000>>4)
 
@@ -417,23 +534,29 @@ MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_clear_calibration_obj, microbit_compa
 volatile bool compass_up_to_date = false;
 volatile bool compass_updating = false;
 
-static int get_x(microbit_compass_obj_t *self) {
-    return self->compass->getX(RAW) - get_calibration()->x;
+static int get_x(const microbit_compass_obj_t *self) {
+    const volatile persistent_compass_calibration *calibration = current_calibration();
+    return (self->compass->getX(RAW) - calibration->x) * (COMPASS_FIT_ONE + calibration->scale_x) / COMPASS_FIT_ONE;
 }
 
-static int get_y(microbit_compass_obj_t *self) {
-    return self->compass->getY(RAW) - get_calibration()->y;
+static int get_y(const microbit_compass_obj_t *self) {
+    const volatile persistent_compass_calibration *calibration = current_calibration();
+    return (self->compass->getY(RAW) - calibration->y) * (COMPASS_FIT_ONE + calibration->scale_y) / COMPASS_FIT_ONE;
 }
 
-static int get_z(microbit_compass_obj_t *self) {
-    return self->compass->getZ(RAW) - get_calibration()->z;
+static int get_z(const microbit_compass_obj_t *self) {
+    const volatile persistent_compass_calibration *calibration = current_calibration();
+    return (self->compass->getZ(RAW) - calibration->z) * (COMPASS_FIT_ONE + calibration->scale_z) / COMPASS_FIT_ONE;
 }
 
 #define PITCH_ADJUST true
 
 mp_obj_t microbit_compass_heading(mp_obj_t self_in) {
     microbit_compass_obj_t *self = (microbit_compass_obj_t*)self_in;
-    if (!get_calibration()->calibrated) {
+    refine_calibration();
+    // When calibrating in the background, don't interrupt the program with
+    // the calibration game; the heading improves as the fit does.
+    if (!current_calibration()->calibrated && compass_fit == NULL) {
         microbit_compass_calibrate(self_in);
     }
     float x, y;
@@ -470,6 +593,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_heading_obj, microbit_compass_heading
 mp_obj_t microbit_compass_get_x(mp_obj_t self_in) {
     microbit_compass_obj_t *self = (microbit_compass_obj_t*)self_in;
     update(self);
+    refine_calibration();
     return mp_obj_new_int(get_x(self));
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_get_x_obj, microbit_compass_get_x);
@@ -477,6 +601,7 @@ MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_get_x_obj, microbit_compass_get_x);
 mp_obj_t microbit_compass_get_y(mp_obj_t self_in) {
     microbit_compass_obj_t *self = (microbit_compass_obj_t*)self_in;
     update(self);
+    refine_calibration();
     return mp_obj_new_int(get_y(self));
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_get_y_obj, microbit_compass_get_y);
@@ -484,28 +609,98 @@ MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_get_y_obj, microbit_compass_get_y);
 mp_obj_t microbit_compass_get_z(mp_obj_t self_in) {
     microbit_compass_obj_t *self = (microbit_compass_obj_t*)self_in;
     update(self);
+    refine_calibration();
     return mp_obj_new_int(get_z(self));
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_get_z_obj, microbit_compass_get_z);
 
-mp_obj_t microbit_compass_get_values(mp_obj_t self_in) {
-    microbit_compass_obj_t *self = (microbit_compass_obj_t*)self_in;
-    mp_obj_tuple_t *tuple = (mp_obj_tuple_t *)mp_obj_new_tuple(3, NULL);
+void microbit_compass_get_values(const microbit_compass_obj_t *self, int *x, int *y, int *z) {
     update(self);
-    tuple->items[0] = mp_obj_new_int(get_x(self));
-    tuple->items[1] = mp_obj_new_int(get_y(self));
-    tuple->items[2] = mp_obj_new_int(get_z(self));
+    refine_calibration();
+    *x = get_x(self);
+    *y = get_y(self);
+    *z = get_z(self);
+}
+
+mp_obj_t microbit_compass_get_values_func(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_into, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    microbit_compass_obj_t *self = (microbit_compass_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    int values[3];
+    microbit_compass_get_values(self, &values[0], &values[1], &values[2]);
+    if (args[0].u_obj != mp_const_none) {
+        return microbit_obj_store_values(args[0].u_obj, values, 3);
+    }
+    mp_obj_tuple_t *tuple = (mp_obj_tuple_t *)mp_obj_new_tuple(3, NULL);
+    tuple->items[0] = mp_obj_new_int(values[0]);
+    tuple->items[1] = mp_obj_new_int(values[1]);
+    tuple->items[2] = mp_obj_new_int(values[2]);
+    return tuple;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_compass_get_values_obj, 1, microbit_compass_get_values_func);
+
+/* Orientation is worked out in the ticker, from both sensors, once
+ * microbit.orientation() has been called.  There is no gyroscope, so the
+ * filter just smooths the gravity and field vectors. */
+static void orientation_sample(orientation_t *state) {
+    update(&microbit_compass_obj);
+    int accel[3], field[3];
+    microbit_accelerometer_get_values(&microbit_accelerometer_obj, &accel[0], &accel[1], &accel[2]);
+    // The compass's x axis points the other way to the accelerometer's.
+    field[0] = -get_x(&microbit_compass_obj);
+    field[1] = get_y(&microbit_compass_obj);
+    field[2] = get_z(&microbit_compass_obj);
+    orientation_update(state, accel, field);
+}
+
+STATIC mp_obj_t microbit_orientation(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_into, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    refine_calibration();
+    orientation_t *state = MP_STATE_PORT(orientation);
+    if (state == NULL) {
+        if (!current_calibration()->calibrated && compass_fit == NULL) {
+            microbit_compass_calibrate((mp_obj_t)&microbit_compass_obj);
+        }
+        state = m_new0(orientation_t, 1);
+        // Start from a sample taken now, then leave it to the ticker.
+        orientation_sample(state);
+        MP_STATE_PORT(orientation) = state;
+    }
+    int values[7];
+    // Don't let the ticker change the values half way through copying them.
+    __disable_irq();
+    values[0] = state->heading;
+    values[1] = state->pitch;
+    values[2] = state->roll;
+    for (int i = 0; i < 4; i++) {
+        values[3 + i] = state->quaternion[i];
+    }
+    __enable_irq();
+    if (args[0].u_obj != mp_const_none) {
+        return microbit_obj_store_values(args[0].u_obj, values, 7);
+    }
+    mp_obj_tuple_t *tuple = (mp_obj_tuple_t *)mp_obj_new_tuple(7, NULL);
+    for (int i = 0; i < 7; i++) {
+        tuple->items[i] = MP_OBJ_NEW_SMALL_INT(values[i]);
+    }
     return tuple;
 }
-MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_get_values_obj, microbit_compass_get_values);
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_orientation_obj, 0, microbit_orientation);
 
 
 mp_obj_t microbit_compass_get_calibration(mp_obj_t self_in) {
     (void)self_in;
     mp_obj_tuple_t *tuple = (mp_obj_tuple_t *)mp_obj_new_tuple(3, NULL);
-    tuple->items[0] = mp_obj_new_int(get_calibration()->x);
-    tuple->items[1] = mp_obj_new_int(get_calibration()->y);
-    tuple->items[2] = mp_obj_new_int(get_calibration()->z);
+    tuple->items[0] = mp_obj_new_int(current_calibration()->x);
+    tuple->items[1] = mp_obj_new_int(current_calibration()->y);
+    tuple->items[2] = mp_obj_new_int(current_calibration()->z);
     return tuple;
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_compass_get_calibration_obj, microbit_compass_get_calibration);
@@ -537,6 +732,7 @@ STATIC const mp_map_elem_t microbit_compass_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_calibration), (mp_obj_t)&microbit_compass_set_calibration_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_start_calibrating), (mp_obj_t)&microbit_compass_start_calibrating_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_stop_calibrating), (mp_obj_t)&microbit_compass_stop_calibrating_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_auto_calibrate), (mp_obj_t)&microbit_compass_auto_calibrate_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_values), (mp_obj_t)&microbit_compass_get_values_obj },
 };
 
@@ -30,12 +30,16 @@
 extern "C" {
 
 #include "py/runtime.h"
+#include "py/runtime0.h"
 #include "py/objstr.h"
+#include "py/objtuple.h"
 #include "py/mphal.h"
 #include "modmicrobit.h"
 #include "microbit/microbitobj.h"
 #include "microbit/microbitpin.h"
 #include "lib/pwm.h"
+#include "lib/synth.h"
+#include "microbit/modaudio.h"
 
 #define DEFAULT_BPM      120
 #define DEFAULT_TICKS    4 // i.e. 4 ticks per beat
@@ -43,13 +47,24 @@ extern "C" {
 #define DEFAULT_DURATION 4 // Crotchet
 #define ARTICULATION_MS  10 // articulation between notes in milliseconds
 
+// A note compiled to the period of its pitch and its length in ticks,
+// so that playing it needs no parsing.  The synthesizer plays the same events.
+typedef synth_event_t music_event_t;
+
+typedef struct _music_tune_obj_t {
+    mp_obj_base_t base;
+    mp_uint_t len;
+    const music_event_t *events;
+} music_tune_obj_t;
+
+extern const mp_obj_type_t microbit_music_tune_type;
+
 typedef struct _music_data_t {
     uint16_t bpm;
     uint16_t ticks;
 
-    // store these to simplify the writing process
-    uint8_t last_octave;
-    uint8_t last_duration;
+    // cached from bpm and ticks, so the tick handler needn't divide
+    uint16_t ms_per_tick;
 
     // Asynchronous parts.
     volatile uint8_t async_state;
@@ -58,7 +73,7 @@ typedef struct _music_data_t {
     uint16_t async_notes_len;
     uint16_t async_notes_index;
     const microbit_pin_obj_t *async_pin;
-    mp_obj_t async_note;
+    const music_tune_obj_t *async_tune;
 } music_data_t;
 
 enum {
@@ -71,7 +86,24 @@ enum {
 
 extern uint32_t ticks;
 
-STATIC uint32_t start_note(const char *note_str, size_t note_len, const microbit_pin_obj_t *pin);
+// The built-in tunes, compiled at build time by tools/makemusictunes.py.
+#define MUSIC_TUNE(name, ...) \
+    STATIC const music_event_t music_tune_ ## name ## _events[] = {__VA_ARGS__};
+#include "genhdr/musictunes.generated.h"
+#undef MUSIC_TUNE
+
+typedef struct _music_builtin_tune_t {
+    const mp_obj_tuple_t *notes;
+    music_tune_obj_t tune;
+} music_builtin_tune_t;
+
+#define MUSIC_TUNE(name, ...) \
+    { &microbit_music_tune_ ## name ## _obj, {{&microbit_music_tune_type}, \
+        MP_ARRAY_SIZE(music_tune_ ## name ## _events), music_tune_ ## name ## _events} },
+STATIC const music_builtin_tune_t music_builtin_tunes[] = {
+#include "genhdr/musictunes.generated.h"
+};
+#undef MUSIC_TUNE
 
 void microbit_music_tick(void) {
     if (music_data == NULL) {
@@ -106,26 +138,21 @@ void microbit_music_tick(void) {
                 return;
             }
         }
-        mp_obj_t note;
-        if (music_data->async_notes_len == 1) {
-            note = music_data->async_note;
-        } else {
-            note = ((mp_obj_t*)music_data->async_note)[music_data->async_notes_index];
-        }
-        if (note == mp_const_none) {
-            // a rest (is this even used anymore?)
+        const music_event_t *event = &music_data->async_tune->events[music_data->async_notes_index];
+        if (event->period_us == 0) {
             pwm_set_duty_cycle(music_data->async_pin->name, 0);
-            music_data->async_wait_ticks = 60000 / music_data->bpm;
-            music_data->async_state = ASYNC_MUSIC_STATE_NEXT_NOTE;
         } else {
-            // a note
-            mp_uint_t note_len;
-            const char *note_str = mp_obj_str_get_data(note, &note_len);
-            uint32_t delay_on = start_note(note_str, note_len, music_data->async_pin);
-            music_data->async_wait_ticks = ticks + delay_on;
-            music_data->async_notes_index += 1;
-            music_data->async_state = ASYNC_MUSIC_STATE_ARTICULATE;
+            pwm_set_duty_cycle(music_data->async_pin->name, 128);
+            pwm_set_period_us(event->period_us);
+        }
+        // Cut off a short time from end of note so we hear articulation.
+        mp_int_t gap_ms = (music_data->ms_per_tick * event->ticks) - ARTICULATION_MS;
+        if (gap_ms < ARTICULATION_MS) {
+            gap_ms = ARTICULATION_MS;
         }
+        music_data->async_wait_ticks = ticks + gap_ms;
+        music_data->async_notes_index += 1;
+        music_data->async_state = ASYNC_MUSIC_STATE_ARTICULATE;
     }
 }
 
@@ -141,26 +168,33 @@ STATIC void wait_async_music_idle(void) {
     }
 }
 
-STATIC uint32_t start_note(const char *note_str, size_t note_len, const microbit_pin_obj_t *pin) {
-    pwm_set_duty_cycle(pin->name, 128);
+STATIC void update_ms_per_tick(void) {
+    music_data->ms_per_tick = (60000 / music_data->bpm) / music_data->ticks;
+}
+
+// octave and duration carry over from one note to the next
+typedef struct _music_compile_state_t {
+    uint8_t last_octave;
+    uint8_t last_duration;
+} music_compile_state_t;
 
+STATIC void compile_note(const char *note_str, size_t note_len, music_compile_state_t *state, music_event_t *event) {
     // [NOTE](#|b)(octave)(:length)
     // technically, c4 is middle c, so we'll go with that...
     // if we define A as 0 and G as 7, then we can use the following
     // array of us periods
+    // tools/makemusictunes.py compiles the built-in tunes the same way, so
+    // keep the two in step.
 
     // these are the periods of note4 (the octave ascending from middle c) from A->B then C->G
-    STATIC uint16_t periods_us[] = {2273, 2025, 3822, 3405, 3034, 2863, 2551};
+    STATIC const uint16_t periods_us[] = {2273, 2025, 3822, 3405, 3034, 2863, 2551};
     // A#, -, C#, D#, -, F#, G#
-    STATIC uint16_t periods_sharps_us[] = {2145, 0, 3608, 3214, 0, 2703, 2408};
+    STATIC const uint16_t periods_sharps_us[] = {2145, 0, 3608, 3214, 0, 2703, 2408};
 
     // we'll represent the note as an integer (A=0, G=6)
     // TODO: validate the note
     uint8_t note_index = (note_str[0] & 0x1f) - 1;
 
-    // TODO: the duration and bpm should be persistent between notes
-    uint32_t ms_per_tick = (60000 / music_data->bpm) / music_data->ticks;
-
     int8_t octave = 0;
     bool sharp = false;
 
@@ -190,11 +224,11 @@ STATIC uint32_t start_note(const char *note_str, size_t note_len, const microbit
     if (current_position < note_len && note_str[current_position] != ':') {
         // currently this will only work with a one digit number
         // use +=, since the sharp/flat code changes octave to compensate.
-        music_data->last_octave = (note_str[current_position] & 0xf);
+        state->last_octave = (note_str[current_position] & 0xf);
         current_position++;
     }
 
-    octave += music_data->last_octave;
+    octave += state->last_octave;
 
     // parse the duration
     if (current_position < note_len && note_str[current_position] == ':') {
@@ -202,12 +236,12 @@ STATIC uint32_t start_note(const char *note_str, size_t note_len, const microbit
         current_position++;
 
         if (current_position < note_len) {
-            music_data->last_duration = note_str[current_position] & 0xf;
+            state->last_duration = note_str[current_position] & 0xf;
 
             current_position++;
             if (current_position < note_len) {
-                music_data->last_duration *= 10;
-                music_data->last_duration += note_str[current_position] & 0xf;
+                state->last_duration *= 10;
+                state->last_duration += note_str[current_position] & 0xf;
             }
         } else {
             // technically, this should be a syntax error, since this means
@@ -215,47 +249,115 @@ STATIC uint32_t start_note(const char *note_str, size_t note_len, const microbit
             // we'll let you off :D
         }
     }
-    // play the note!
 
     // make the octave relative to octave 4
     octave -= 4;
 
-    // 18 is 'r' or 'R'
-    if (note_index < 10) {
-        uint32_t period;
-        if (sharp) {
-            if (octave >= 0) {
-                period = periods_sharps_us[note_index] >> octave;
-            }
-            else {
-                period = periods_sharps_us[note_index] << -octave;
-            }
+    event->ticks = state->last_duration;
+
+    // anything other than A-G, such as 'r' or 'R', is a rest
+    if (note_index < MP_ARRAY_SIZE(periods_us)) {
+        uint32_t period = sharp ? periods_sharps_us[note_index] : periods_us[note_index];
+        if (octave >= 0) {
+            period >>= octave;
         } else {
-            if (octave >= 0) {
-                period = periods_us[note_index] >> octave;
+            period <<= -octave;
+        }
+        if (period > 0xffff) {
+            period = 0xffff;
+        }
+        event->period_us = period;
+    } else {
+        event->period_us = 0;
+    }
+}
+
+// Turn a note string, a list or tuple of notes, or a Tune into a Tune.
+STATIC const music_tune_obj_t *music_compile_tune(mp_obj_t music) {
+    if (MP_OBJ_IS_TYPE(music, &microbit_music_tune_type)) {
+        return (const music_tune_obj_t*)music;
+    }
+
+    // get either a single note or a list of notes
+    mp_uint_t len;
+    mp_obj_t *items;
+    if (MP_OBJ_IS_STR_OR_BYTES(music)) {
+        len = 1;
+        items = &music;
+    } else {
+        // the built-in tunes are already compiled
+        for (size_t i = 0; i < MP_ARRAY_SIZE(music_builtin_tunes); i++) {
+            if (music == music_builtin_tunes[i].notes) {
+                return &music_builtin_tunes[i].tune;
             }
-            else {
-                period = periods_us[note_index] << -octave;
+        }
+        mp_obj_get_array(music, &len, &items);
+    }
+    if (len > 0xffff) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "too many notes"));
+    }
+
+    music_tune_obj_t *tune = m_new_obj_var(music_tune_obj_t, music_event_t, len);
+    music_event_t *events = (music_event_t*)(tune + 1);
+    tune->base.type = &microbit_music_tune_type;
+    tune->len = len;
+    tune->events = events;
+
+    // reset octave and duration so tunes always play the same
+    music_compile_state_t state = {DEFAULT_OCTAVE, DEFAULT_DURATION};
+    for (mp_uint_t i = 0; i < len; i++) {
+        if (items[i] == mp_const_none) {
+            // a rest of one beat
+            events[i].period_us = 0;
+            events[i].ticks = DEFAULT_TICKS;
+        } else {
+            mp_uint_t note_len;
+            const char *note_str = mp_obj_str_get_data(items[i], &note_len);
+            if (note_len == 0) {
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "empty note"));
             }
+            compile_note(note_str, note_len, &state, &events[i]);
         }
-        pwm_set_period_us(period);
-    } else {
-        pwm_set_duty_cycle(pin->name, 0);
     }
+    return tune;
+}
 
-    // Cut off a short time from end of note so we hear articulation.
-    mp_int_t gap_ms = (ms_per_tick * music_data->last_duration) - ARTICULATION_MS;
-    if (gap_ms < ARTICULATION_MS) {
-        gap_ms = ARTICULATION_MS;
+STATIC mp_obj_t microbit_music_compile(mp_obj_t music) {
+    return (mp_obj_t)music_compile_tune(music);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_music_compile_obj, microbit_music_compile);
+
+STATIC mp_obj_t microbit_music_tune_len(mp_uint_t op, mp_obj_t self_in) {
+    music_tune_obj_t *self = (music_tune_obj_t*)self_in;
+    switch (op) {
+        case MP_UNARY_OP_BOOL: return mp_obj_new_bool(self->len != 0);
+        case MP_UNARY_OP_LEN: return MP_OBJ_NEW_SMALL_INT(self->len);
+        default: return MP_OBJ_NULL; // op not supported
     }
-    return gap_ms;
 }
 
+const mp_obj_type_t microbit_music_tune_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Tune,
+    .print = NULL,
+    .make_new = NULL,
+    .call = NULL,
+    .unary_op = microbit_music_tune_len,
+    .binary_op = NULL,
+    .attr = NULL,
+    .subscr = NULL,
+    .getiter = NULL,
+    .iternext = NULL,
+    .buffer_p = {NULL},
+    .stream_p = NULL,
+    .bases_tuple = NULL,
+    .locals_dict = NULL,
+};
+
 STATIC mp_obj_t microbit_music_reset(void) {
     music_data->bpm = DEFAULT_BPM;
     music_data->ticks = DEFAULT_TICKS;
-    music_data->last_octave = DEFAULT_OCTAVE;
-    music_data->last_duration = DEFAULT_DURATION;
+    update_ms_per_tick();
 
     return mp_const_none;
 }
@@ -301,19 +403,8 @@ STATIC mp_obj_t microbit_music_play(mp_uint_t n_args, const mp_obj_t *pos_args,
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    // reset octave and duration so tunes always play the same
-    music_data->last_octave = DEFAULT_OCTAVE;
-    music_data->last_duration = DEFAULT_DURATION;
-
-    // get either a single note or a list of notes
-    mp_uint_t len;
-    mp_obj_t *items;
-    if (MP_OBJ_IS_STR_OR_BYTES(args[0].u_obj)) {
-        len = 1;
-        items = &args[0].u_obj;
-    } else {
-        mp_obj_get_array(args[0].u_obj, &len, &items);
-    }
+    // compile the notes before touching the running tune, in case they are invalid
+    const music_tune_obj_t *tune = music_compile_tune(args[0].u_obj);
 
     // Release the previous pin
     microbit_obj_pin_free(music_data->async_pin);
@@ -327,16 +418,9 @@ STATIC mp_obj_t microbit_music_play(mp_uint_t n_args, const mp_obj_t *pos_args,
     music_data->async_state = ASYNC_MUSIC_STATE_IDLE;
     music_data->async_wait_ticks = ticks;
     music_data->async_loop = args[3].u_bool;
-    music_data->async_notes_len = len;
+    music_data->async_notes_len = tune->len;
     music_data->async_notes_index = 0;
-    if (len == 1) {
-        // If a string was passed as a single note then we can't store a pointer
-        // to args[0].u_obj, so instead store the single string directly (also
-        // works if a tuple/list of one element was passed).
-        music_data->async_note = items[0];
-    } else {
-        music_data->async_note = items;
-    }
+    music_data->async_tune = tune;
     music_data->async_pin = pin;
     music_data->async_state = ASYNC_MUSIC_STATE_NEXT_NOTE;
 
@@ -385,7 +469,7 @@ STATIC mp_obj_t microbit_music_pitch(mp_uint_t n_args, const mp_obj_t *pos_args,
         music_data->async_loop = false;
         music_data->async_notes_len = 0;
         music_data->async_notes_index = 0;
-        music_data->async_note = NULL;
+        music_data->async_tune = NULL;
         music_data->async_pin = pin;
         music_data->async_state = ASYNC_MUSIC_STATE_ARTICULATE;
 
@@ -419,6 +503,8 @@ STATIC mp_obj_t microbit_music_set_tempo(mp_uint_t n_args, const mp_obj_t *pos_a
         music_data->bpm = args[1].u_int;
     }
 
+    update_ms_per_tick();
+
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(microbit_music_set_tempo_obj, 0, microbit_music_set_tempo);
@@ -428,15 +514,140 @@ static mp_obj_t music_init(void) {
     music_data = m_new_obj(music_data_t);
     music_data->bpm = DEFAULT_BPM;
     music_data->ticks = DEFAULT_TICKS;
-    music_data->last_octave = DEFAULT_OCTAVE;
-    music_data->last_duration = DEFAULT_DURATION;
+    update_ms_per_tick();
     music_data->async_state = ASYNC_MUSIC_STATE_IDLE;
     music_data->async_pin = NULL;
-    music_data->async_note = NULL;
+    music_data->async_tune = NULL;
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_0(music___init___obj, music_init);
 
+typedef struct _microbit_music_synth_obj_t {
+    mp_obj_base_t base;
+    microbit_audio_frame_obj_t *frame;
+    // the voices point into these, so keep them alive
+    const music_tune_obj_t *tunes[SYNTH_MAX_VOICES];
+    synth_voice_t voices[SYNTH_MAX_VOICES];
+    uint8_t voice_count;
+    bool loop;
+    bool finished;
+} microbit_music_synth_obj_t;
+
+extern const mp_obj_type_t microbit_music_synth_type;
+
+STATIC void music_synth_restart(microbit_music_synth_obj_t *self) {
+    for (uint32_t i = 0; i < self->voice_count; i++) {
+        synth_voice_start(&self->voices[i], self->tunes[i]->events, self->tunes[i]->len);
+    }
+    self->finished = false;
+}
+
+STATIC mp_obj_t microbit_music_synth_make_new(const mp_obj_type_t *type_in, mp_uint_t n_args, mp_uint_t n_kw, const mp_obj_t *args) {
+    (void)type_in;
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_loop, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
+    mp_arg_check_num(n_args, n_kw, 1, SYNTH_MAX_VOICES, true);
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
+    mp_arg_val_t kw_vals[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(0, NULL, &kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, kw_vals);
+
+    microbit_music_synth_obj_t *self = m_new_obj(microbit_music_synth_obj_t);
+    self->base.type = &microbit_music_synth_type;
+    self->frame = new_microbit_audio_frame();
+    self->voice_count = n_args;
+    self->loop = kw_vals[0].u_bool;
+    // two voices at full volume fill the output range, so share that out
+    uint32_t volume = 2 * SYNTH_MAX_VOLUME / n_args;
+    if (volume > SYNTH_MAX_VOLUME) {
+        volume = SYNTH_MAX_VOLUME;
+    }
+    for (uint32_t i = 0; i < n_args; i++) {
+        self->tunes[i] = music_compile_tune(args[i]);
+        self->voices[i].waveform = SYNTH_WAVE_SQUARE;
+        self->voices[i].volume = volume;
+    }
+    music_synth_restart(self);
+    return self;
+}
+
+STATIC mp_obj_t microbit_music_synth_set_voice(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_voice,    MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_waveform, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_volume,   MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    microbit_music_synth_obj_t *self = (microbit_music_synth_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_int_t voice = args[0].u_int;
+    if (voice < 0 || voice >= self->voice_count) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_IndexError, "voice index out of range"));
+    }
+    if (args[1].u_obj != mp_const_none) {
+        mp_int_t waveform = mp_obj_get_int(args[1].u_obj);
+        if (waveform < 0 || waveform >= SYNTH_WAVE_COUNT) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid waveform"));
+        }
+        self->voices[voice].waveform = waveform;
+    }
+    if (args[2].u_obj != mp_const_none) {
+        mp_int_t volume = mp_obj_get_int(args[2].u_obj);
+        if (volume < 0 || volume > SYNTH_MAX_VOLUME) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "volume must be 0-255"));
+        }
+        self->voices[voice].volume = volume;
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_music_synth_set_voice_obj, 1, microbit_music_synth_set_voice);
+
+// Iterating a Synth starts the tune again, so it can be passed to audio.play() repeatedly.
+STATIC mp_obj_t microbit_music_synth_getiter(mp_obj_t self_in) {
+    music_synth_restart((microbit_music_synth_obj_t*)self_in);
+    return self_in;
+}
+
+// Called by the audio module in interrupt context, so must not allocate.
+STATIC mp_obj_t microbit_music_synth_iternext(mp_obj_t self_in) {
+    microbit_music_synth_obj_t *self = (microbit_music_synth_obj_t*)self_in;
+    if (self->finished) {
+        if (!self->loop) {
+            return MP_OBJ_STOP_ITERATION;
+        }
+        music_synth_restart(self);
+    }
+    if (synth_render(self->voices, self->voice_count, music_data->ms_per_tick, self->frame->data, AUDIO_CHUNK_SIZE) == 0) {
+        self->finished = true;
+    }
+    return self->frame;
+}
+
+STATIC const mp_map_elem_t microbit_music_synth_locals_dict_table[] = {
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_voice), (mp_obj_t)&microbit_music_synth_set_voice_obj },
+};
+STATIC MP_DEFINE_CONST_DICT(microbit_music_synth_locals_dict, microbit_music_synth_locals_dict_table);
+
+const mp_obj_type_t microbit_music_synth_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_Synth,
+    .print = NULL,
+    .make_new = microbit_music_synth_make_new,
+    .call = NULL,
+    .unary_op = NULL,
+    .binary_op = NULL,
+    .attr = NULL,
+    .subscr = NULL,
+    .getiter = microbit_music_synth_getiter,
+    .iternext = microbit_music_synth_iternext,
+    .buffer_p = {NULL},
+    .stream_p = NULL,
+    .bases_tuple = NULL,
+    .locals_dict = (mp_obj_dict_t*)&microbit_music_synth_locals_dict,
+};
+
 STATIC const mp_map_elem_t microbit_music_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___init__), (mp_obj_t)&music___init___obj },
 
@@ -446,6 +657,13 @@ STATIC const mp_map_elem_t microbit_music_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_play), (mp_obj_t)&microbit_music_play_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_pitch), (mp_obj_t)&microbit_music_pitch_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_stop), (mp_obj_t)&microbit_music_stop_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_compile), (mp_obj_t)&microbit_music_compile_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_Synth), (mp_obj_t)&microbit_music_synth_type },
+
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SQUARE), MP_OBJ_NEW_SMALL_INT(SYNTH_WAVE_SQUARE) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SINE), MP_OBJ_NEW_SMALL_INT(SYNTH_WAVE_SINE) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_TRIANGLE), MP_OBJ_NEW_SMALL_INT(SYNTH_WAVE_TRIANGLE) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SAWTOOTH), MP_OBJ_NEW_SMALL_INT(SYNTH_WAVE_SAWTOOTH) },
 
     { MP_OBJ_NEW_QSTR(MP_QSTR_DADADADUM), (mp_obj_t)&microbit_music_tune_dadadadum_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_ENTERTAINER), (mp_obj_t)&microbit_music_tune_entertainer_obj },
@@ -30,9 +30,16 @@
 extern "C" {
 
 #include "py/runtime.h"
+#include "py/binary.h"
+#include "py/gc.h"
 #include "modmicrobit.h"
 #include "lib/pwm.h"
+#include "lib/edges.h"
+#include "lib/usclock.h"
+#include "lib/adcstream.h"
+#include "lib/ticker.h"
 #include "microbit/microbitpin.h"
+#include "microbit/modaudio.h"
 #include "nrf_gpio.h"
 #include "py/mphal.h"
 
@@ -84,7 +91,9 @@ MP_DEFINE_CONST_FUN_OBJ_2(microbit_pin_write_digital_obj, microbit_pin_write_dig
 
 mp_obj_t microbit_pin_read_digital(mp_obj_t self_in) {
     microbit_pin_obj_t *self = (microbit_pin_obj_t*)self_in;
-    if (microbit_pin_get_mode(self) != microbit_pin_mode_read_digital) {
+    const microbit_pinmode_t *mode = microbit_pin_get_mode(self);
+    // Reading doesn't disturb counting edges.
+    if (mode != microbit_pin_mode_read_digital && mode != microbit_pin_mode_edges) {
         microbit_obj_pin_acquire(self, microbit_pin_mode_read_digital);
         nrf_gpio_cfg_input(self->name, NRF_GPIO_PIN_PULLDOWN);
     }
@@ -102,8 +111,8 @@ mp_obj_t microbit_pin_set_pull(mp_obj_t self_in, mp_obj_t pull_in) {
         nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid pull"));
     }
     const microbit_pinmode_t *mode = microbit_pin_get_mode(self);
-    /* Pull only applies in an read digital mode */
-    if (mode != microbit_pin_mode_read_digital) {
+    /* Pull only applies in an read digital or edges mode */
+    if (mode != microbit_pin_mode_read_digital && mode != microbit_pin_mode_edges) {
         pinmode_error(self);
     }
     nrf_gpio_cfg_input(self->name, (nrf_gpio_pin_pull_t)pull);
@@ -116,8 +125,8 @@ MP_DEFINE_CONST_FUN_OBJ_2(microbit_pin_set_pull_obj, microbit_pin_set_pull);
 mp_obj_t microbit_pin_get_pull(mp_obj_t self_in) {
     microbit_pin_obj_t *self = (microbit_pin_obj_t*)self_in;
     const microbit_pinmode_t *mode = microbit_pin_get_mode(self);
-    /* Pull only applies in an read digital mode */
-    if (mode != microbit_pin_mode_read_digital) {
+    /* Pull only applies in an read digital or edges mode */
+    if (mode != microbit_pin_mode_read_digital && mode != microbit_pin_mode_edges) {
         pinmode_error(self);
     }
     uint32_t pull = (NRF_GPIO->PIN_CNF[self->name] >> GPIO_PIN_CNF_PULL_Pos) & PULL_MASK;
@@ -151,6 +160,9 @@ MP_DEFINE_CONST_FUN_OBJ_2(microbit_pin_write_analog_obj, microbit_pin_write_anal
 mp_obj_t microbit_pin_read_analog(mp_obj_t self_in) {
     microbit_pin_obj_t *self = (microbit_pin_obj_t*)self_in;
     microbit_obj_pin_acquire(self, microbit_pin_mode_unused);
+    if (adcstream_running()) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "ADC in use"));
+    }
     analogin_t obj;
     analogin_init(&obj, (PinName)self->name);
     int val = analogin_read_u16(&obj);
@@ -159,6 +171,149 @@ mp_obj_t microbit_pin_read_analog(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_pin_read_analog_obj, microbit_pin_read_analog);
 
+/* Continuous analog sampling, timed by the hardware (see lib/adcstream.c).
+ * The pin being sampled is in read_analog mode, whose release stops it.
+ */
+static const microbit_pin_obj_t *stream_pin = NULL;
+// Counts the streams started, so that iterators over old ones can stop.
+static uint32_t stream_count = 0;
+
+static void analog_stream_start(const microbit_pin_obj_t *pin, mp_obj_t rate_in) {
+    mp_int_t rate = mp_obj_get_int(rate_in);
+    mp_int_t period = rate > 0 ? (1000000 + rate / 2) / rate : 0;
+    if (period < ADCSTREAM_MIN_PERIOD || period > ADCSTREAM_MAX_PERIOD) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid rate"));
+    }
+    if (stream_pin != NULL && microbit_pin_get_mode(stream_pin) == microbit_pin_mode_read_analog) {
+        microbit_obj_pin_acquire(stream_pin, microbit_pin_mode_unused);
+    }
+    microbit_obj_pin_acquire(pin, microbit_pin_mode_unused);
+    microbit_obj_pin_acquire(pin, microbit_pin_mode_read_analog);
+    stream_pin = pin;
+    stream_count++;
+    adcstream_start(pin->name, period);
+}
+
+// Wait for the next block, unless CTRL-C is pressed.
+static bool analog_stream_wait(uint16_t *block) {
+    while (!adcstream_read(block)) {
+        if (!adcstream_running() || MP_STATE_VM(mp_pending_exception) != MP_OBJ_NULL) {
+            return false;
+        }
+        __WFI();
+    }
+    return true;
+}
+
+mp_obj_t microbit_pin_read_analog_into(mp_obj_t self_in, mp_obj_t buf_in, mp_obj_t rate_in) {
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)self_in;
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    size_t size = mp_binary_get_size('@', bufinfo.typecode, NULL);
+    size_t max = bufinfo.len / size;
+    // Bytes hold 8 bit samples.
+    int shift = size == 1 ? 2 : 0;
+    analog_stream_start(self, rate_in);
+    uint16_t block[ADCSTREAM_BLOCK];
+    size_t count = 0;
+    while (count < max && analog_stream_wait(block)) {
+        for (size_t i = 0; i < ADCSTREAM_BLOCK && count < max; i++) {
+            mp_binary_set_val_array_from_int(bufinfo.typecode, bufinfo.buf, count++, block[i] >> shift);
+        }
+    }
+    microbit_obj_pin_acquire(self, microbit_pin_mode_unused);
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+MP_DEFINE_CONST_FUN_OBJ_3(microbit_pin_read_analog_into_obj, microbit_pin_read_analog_into);
+
+/* An iterator of AudioFrames of 8 bit samples, for as long as the pin is
+ * sampled.  Two frames are used in turn, so that nothing is allocated and
+ * the last frame returned isn't changed while the next is being filled.
+ * audio.play() calls this from an interrupt, so it must not allocate or
+ * wait: if the next block isn't ready, the last frame is returned again.
+ */
+typedef struct _analog_frames_t {
+    mp_obj_base_t base;
+    uint32_t stream;
+    uint32_t underruns;
+    uint8_t next;
+    microbit_audio_frame_obj_t *frames[2];
+} analog_frames_t;
+
+#if AUDIO_CHUNK_SIZE != ADCSTREAM_BLOCK
+#error "Analog frames need a block of samples per audio frame"
+#endif
+
+static mp_obj_t analog_frames_next(mp_obj_t iter_in) {
+    analog_frames_t *iter = (analog_frames_t *)iter_in;
+    uint16_t block[ADCSTREAM_BLOCK];
+    if (iter->stream != stream_count || !adcstream_running()) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    if (!adcstream_read(block)) {
+        // Before the first block, this is a frame of silence.
+        iter->underruns++;
+        return iter->frames[iter->next ^ 1];
+    }
+    microbit_audio_frame_obj_t *frame = iter->frames[iter->next];
+    iter->next ^= 1;
+    for (int i = 0; i < ADCSTREAM_BLOCK; i++) {
+        frame->data[i] = block[i] >> 2;
+    }
+    return frame;
+}
+
+static void analog_frames_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    analog_frames_t *iter = (analog_frames_t *)self_in;
+    if (dest[0] == MP_OBJ_NULL && attr == MP_QSTR_underruns) {
+        dest[0] = mp_obj_new_int_from_uint(iter->underruns);
+    }
+}
+
+const mp_obj_type_t microbit_analog_frames_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_iterator,
+    .print = NULL,
+    .make_new = NULL,
+    .call = NULL,
+    .unary_op = NULL,
+    .binary_op = NULL,
+    .attr = analog_frames_attr,
+    .subscr = NULL,
+    .getiter = mp_identity,
+    .iternext = analog_frames_next,
+    .buffer_p = {NULL},
+    .stream_p = NULL,
+    .bases_tuple = MP_OBJ_NULL,
+    MP_OBJ_NULL
+};
+
+mp_obj_t microbit_pin_read_analog_frames(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_rate, MP_ARG_OBJ, {.u_obj = MP_OBJ_NEW_SMALL_INT(7812)} },
+    };
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    analog_frames_t *iter = m_new_obj(analog_frames_t);
+    iter->base.type = &microbit_analog_frames_type;
+    iter->underruns = 0;
+    iter->next = 0;
+    iter->frames[0] = new_microbit_audio_frame();
+    iter->frames[1] = new_microbit_audio_frame();
+    analog_stream_start(self, args[0].u_obj);
+    iter->stream = stream_count;
+    return iter;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_pin_read_analog_frames_obj, 1, microbit_pin_read_analog_frames);
+
+mp_obj_t microbit_pin_analog_overruns(mp_obj_t self_in) {
+    // The count is kept after sampling stops, until it starts again.
+    uint32_t overruns = self_in == stream_pin ? adcstream_overruns() : 0;
+    return mp_obj_new_int_from_uint(overruns);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_pin_analog_overruns_obj, microbit_pin_analog_overruns);
+
 mp_obj_t microbit_pin_set_analog_period(mp_obj_t self_in, mp_obj_t period_in) {
     (void)self_in;
     int err = pwm_set_period_us(mp_obj_get_int(period_in)*1000);
@@ -198,6 +353,257 @@ mp_obj_t microbit_pin_is_touched(mp_obj_t self_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(microbit_pin_is_touched_obj, microbit_pin_is_touched);
 
+/* Counting edges.  The GPIOTE interrupt counts the edges and keeps their
+ * times (see lib/edges.c); a handler is called afterwards from the low
+ * priority callback, so that it can be Python.
+ */
+typedef struct _pin_edges_t {
+    const microbit_pin_obj_t *pin;
+    mp_obj_t handler;
+    volatile bool pending;
+    uint32_t ring[];
+} pin_edges_t;
+
+#define pin_edges MP_STATE_PORT(pin_edges)
+
+static void pin_edges_call_handlers(void) {
+    for (int i = 0; i < EDGES_CHANNELS; i++) {
+        pin_edges_t *state = pin_edges[i];
+        if (state == NULL || !state->pending) {
+            continue;
+        }
+        state->pending = false;
+        /* WARNING: We are executing in an interrupt handler.
+         * If an exception is raised here then we must hand it to the VM. */
+        gc_lock();
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            mp_call_function_1(state->handler, (mp_obj_t)state->pin);
+            nlr_pop();
+        } else {
+            MP_STATE_VM(mp_pending_exception) = MP_OBJ_FROM_PTR(nlr.ret_val);
+        }
+        gc_unlock();
+    }
+}
+
+// Called in the GPIOTE interrupt.  Edges that arrive before the handler
+// runs are covered by the same call.
+static void pin_edges_event(int channel) {
+    pin_edges_t *state = pin_edges[channel];
+    if (state != NULL && state->handler != mp_const_none) {
+        state->pending = true;
+        set_low_priority_callback(pin_edges_call_handlers, PIN_EDGES_CALLBACK_ID);
+    }
+}
+
+static int pin_edges_channel(const microbit_pin_obj_t *pin) {
+    int channel = edges_channel(pin->name);
+    if (channel < 0 || microbit_pin_get_mode(pin) != microbit_pin_mode_edges) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "not counting"));
+    }
+    return channel;
+}
+
+mp_obj_t microbit_pin_start_counting(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_edges, MP_ARG_INT, {.u_int = EDGES_RISING} },
+        { MP_QSTR_length, MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_handler, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_int_t edges = args[0].u_int;
+    mp_int_t length = args[1].u_int;
+    mp_obj_t handler = args[2].u_obj;
+    if (edges < EDGES_RISING || edges > EDGES_BOTH) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid edges"));
+    }
+    if (length < 0 || length > 4096) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid length"));
+    }
+    if (handler != mp_const_none && !mp_obj_is_callable(handler)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_TypeError, "handler must be callable"));
+    }
+    // Start again if already counting.
+    microbit_obj_pin_acquire(self, microbit_pin_mode_unused);
+    // The ring keeps one slot empty to tell full from empty.
+    size_t len = length > 0 ? length + 1 : 0;
+    pin_edges_t *state = m_new_obj_var(pin_edges_t, uint32_t, len);
+    state->pin = self;
+    state->handler = handler;
+    state->pending = false;
+    microbit_obj_pin_acquire(self, microbit_pin_mode_edges);
+    nrf_gpio_cfg_input(self->name, NRF_GPIO_PIN_PULLDOWN);
+    int channel = edges_start(self->name, edges, len > 0 ? state->ring : NULL, len, pin_edges_event);
+    if (channel < 0) {
+        microbit_obj_pin_acquire(self, microbit_pin_mode_unused);
+        m_del_var(pin_edges_t, uint32_t, len, state);
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "too many pins counting"));
+    }
+    pin_edges[channel] = state;
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_pin_start_counting_obj, 1, microbit_pin_start_counting);
+
+mp_obj_t microbit_pin_stop_counting(mp_obj_t self_in) {
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)self_in;
+    if (microbit_pin_get_mode(self) == microbit_pin_mode_edges) {
+        microbit_obj_pin_acquire(self, microbit_pin_mode_unused);
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_pin_stop_counting_obj, microbit_pin_stop_counting);
+
+mp_obj_t microbit_pin_edge_count(mp_obj_t self_in) {
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)self_in;
+    return mp_obj_new_int_from_uint(edges_count(pin_edges_channel(self)));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_pin_edge_count_obj, microbit_pin_edge_count);
+
+// Python sees times that wrap at 2^29, with the level after the edge in bit
+// 29, so that they are small ints.
+#define PYTHON_TIME_MASK 0x1fffffff
+#define PYTHON_EDGE_HIGH 0x20000000
+
+mp_obj_t microbit_pin_read_edges(mp_obj_t self_in, mp_obj_t buf_in) {
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)self_in;
+    int channel = pin_edges_channel(self);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    size_t max = bufinfo.len / mp_binary_get_size('@', bufinfo.typecode, NULL);
+    size_t count = 0;
+    uint32_t times[16];
+    while (count < max) {
+        size_t n = edges_read(channel, times, max - count < 16 ? max - count : 16);
+        if (n == 0) {
+            break;
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint32_t value = (times[i] & PYTHON_TIME_MASK) | (times[i] & EDGES_HIGH ? PYTHON_EDGE_HIGH : 0);
+            mp_binary_set_val_array_from_int(bufinfo.typecode, bufinfo.buf, count++, value);
+        }
+    }
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(microbit_pin_read_edges_obj, microbit_pin_read_edges);
+
+/* Timing pulses.  The edges are captured as when counting, so their times
+ * are exact to the microsecond, but into a small ring on the stack that is
+ * only needed until the measurement is over.  The timeouts are measured on
+ * the same clock.
+ */
+#define PULSE_RING_LEN 8
+
+static int pulse_start(const microbit_pin_obj_t *pin, uint32_t *ring) {
+    if (microbit_pin_get_mode(pin) != microbit_pin_mode_read_digital) {
+        microbit_obj_pin_acquire(pin, microbit_pin_mode_read_digital);
+        nrf_gpio_cfg_input(pin->name, NRF_GPIO_PIN_PULLDOWN);
+    }
+    int channel = edges_start(pin->name, EDGES_BOTH, ring, PULSE_RING_LEN, NULL);
+    if (channel < 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "too many pins counting"));
+    }
+    return channel;
+}
+
+static mp_int_t pulse_timeout(mp_int_t timeout_us) {
+    // Times wrap at 2^31, so half that is as far apart as they can be told.
+    if (timeout_us < 0 || timeout_us >= 0x40000000) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid timeout"));
+    }
+    return timeout_us;
+}
+
+static bool pulse_after(uint32_t time, uint32_t deadline) {
+    uint32_t since = (time - deadline) & EDGES_TIME_MASK;
+    return since != 0 && since < 0x40000000;
+}
+
+// Wait for the next edge that leaves the pin at the given level, until the
+// deadline or CTRL-C.
+static bool pulse_wait(int channel, bool high, uint32_t deadline, uint32_t *time) {
+    uint32_t edge;
+    do {
+        while (edges_read(channel, &edge, 1) == 0) {
+            if (pulse_after(usclock_now(), deadline) || MP_STATE_VM(mp_pending_exception) != MP_OBJ_NULL) {
+                return false;
+            }
+        }
+        if (pulse_after(edge & EDGES_TIME_MASK, deadline)) {
+            return false;
+        }
+    } while (((edge & EDGES_HIGH) != 0) != high);
+    *time = edge & EDGES_TIME_MASK;
+    return true;
+}
+
+mp_obj_t microbit_pin_time_pulse_us(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_level, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_timeout_us, MP_ARG_INT, {.u_int = 1000000} },
+    };
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    bool high = args[0].u_int != 0;
+    mp_int_t timeout = pulse_timeout(args[1].u_int);
+    uint32_t ring[PULSE_RING_LEN];
+    int channel = pulse_start(self, ring);
+    // If a pulse is already under way, the edge that ends it is skipped.
+    uint32_t start, end;
+    mp_int_t result = -2;
+    if (pulse_wait(channel, high, usclock_now() + timeout, &start)) {
+        result = -1;
+        if (pulse_wait(channel, !high, start + timeout, &end)) {
+            result = (end - start) & EDGES_TIME_MASK;
+        }
+    }
+    edges_stop(channel);
+    return mp_obj_new_int(result);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_pin_time_pulse_us_obj, 2, microbit_pin_time_pulse_us);
+
+mp_obj_t microbit_pin_time_period_us(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_timeout_us, MP_ARG_INT, {.u_int = 1000000} },
+    };
+    microbit_pin_obj_t *self = (microbit_pin_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_int_t timeout = pulse_timeout(args[0].u_int);
+    uint32_t ring[PULSE_RING_LEN];
+    int channel = pulse_start(self, ring);
+    uint32_t deadline = usclock_now() + timeout;
+    uint32_t rise, fall, next_rise;
+    bool timed = pulse_wait(channel, true, deadline, &rise)
+        && pulse_wait(channel, false, deadline, &fall)
+        && pulse_wait(channel, true, deadline, &next_rise);
+    edges_stop(channel);
+    if (!timed) {
+        return mp_const_none;
+    }
+    uint32_t period = (next_rise - rise) & EDGES_TIME_MASK;
+    uint32_t high = (fall - rise) & EDGES_TIME_MASK;
+    // The duty is on the same scale as write_analog().
+    uint32_t duty = ((uint64_t)high * MICROBIT_PIN_MAX_OUTPUT + period / 2) / period;
+    mp_obj_t tuple[2] = { mp_obj_new_int_from_uint(period), MP_OBJ_NEW_SMALL_INT(duty) };
+    return mp_obj_new_tuple(2, tuple);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(microbit_pin_time_period_us_obj, 1, microbit_pin_time_period_us);
+
+#define EDGE_METHODS \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_RISING), MP_OBJ_NEW_SMALL_INT(EDGES_RISING) }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_FALLING), MP_OBJ_NEW_SMALL_INT(EDGES_FALLING) }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_BOTH), MP_OBJ_NEW_SMALL_INT(EDGES_BOTH) }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_start_counting), (mp_obj_t)&microbit_pin_start_counting_obj }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_stop_counting), (mp_obj_t)&microbit_pin_stop_counting_obj }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_edge_count), (mp_obj_t)&microbit_pin_edge_count_obj }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_edges), (mp_obj_t)&microbit_pin_read_edges_obj }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_time_pulse_us), (mp_obj_t)&microbit_pin_time_pulse_us_obj }, \
+    { MP_OBJ_NEW_QSTR(MP_QSTR_time_period_us), (mp_obj_t)&microbit_pin_time_period_us_obj }
+
 #define PULL_CONSTANTS \
     { MP_OBJ_NEW_QSTR(MP_QSTR_PULL_UP), MP_OBJ_NEW_SMALL_INT(NRF_GPIO_PIN_PULLUP) }, \
     { MP_OBJ_NEW_QSTR(MP_QSTR_PULL_DOWN), MP_OBJ_NEW_SMALL_INT(NRF_GPIO_PIN_PULLDOWN) }, \
@@ -214,6 +620,7 @@ STATIC const mp_map_elem_t microbit_dig_pin_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_pull),(mp_obj_t)&microbit_pin_get_pull_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_pull),(mp_obj_t)&microbit_pin_set_pull_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_mode), (mp_obj_t)&microbit_pin_get_mode_obj },
+    EDGE_METHODS,
 };
 
 STATIC const mp_map_elem_t microbit_ann_pin_locals_dict_table[] = {
@@ -221,12 +628,16 @@ STATIC const mp_map_elem_t microbit_ann_pin_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_read_digital), (mp_obj_t)&microbit_pin_read_digital_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_write_analog), (mp_obj_t)&microbit_pin_write_analog_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_read_analog), (mp_obj_t)&microbit_pin_read_analog_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_analog_into), (mp_obj_t)&microbit_pin_read_analog_into_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_analog_frames), (mp_obj_t)&microbit_pin_read_analog_frames_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_analog_overruns), (mp_obj_t)&microbit_pin_analog_overruns_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_analog_period), (mp_obj_t)&microbit_pin_set_analog_period_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_analog_period_microseconds), (mp_obj_t)&microbit_pin_set_analog_period_microseconds_obj },
     PULL_CONSTANTS,
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_pull),(mp_obj_t)&microbit_pin_get_pull_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_pull),(mp_obj_t)&microbit_pin_set_pull_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_mode), (mp_obj_t)&microbit_pin_get_mode_obj },
+    EDGE_METHODS,
 };
 
 STATIC const mp_map_elem_t microbit_touch_pin_locals_dict_table[] = {
@@ -234,6 +645,9 @@ STATIC const mp_map_elem_t microbit_touch_pin_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_read_digital), (mp_obj_t)&microbit_pin_read_digital_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_write_analog), (mp_obj_t)&microbit_pin_write_analog_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_read_analog), (mp_obj_t)&microbit_pin_read_analog_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_analog_into), (mp_obj_t)&microbit_pin_read_analog_into_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_analog_frames), (mp_obj_t)&microbit_pin_read_analog_frames_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_analog_overruns), (mp_obj_t)&microbit_pin_analog_overruns_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_analog_period), (mp_obj_t)&microbit_pin_set_analog_period_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_analog_period_microseconds), (mp_obj_t)&microbit_pin_set_analog_period_microseconds_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_is_touched), (mp_obj_t)&microbit_pin_is_touched_obj },
@@ -241,6 +655,7 @@ STATIC const mp_map_elem_t microbit_touch_pin_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_pull),(mp_obj_t)&microbit_pin_get_pull_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_set_pull),(mp_obj_t)&microbit_pin_set_pull_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_mode), (mp_obj_t)&microbit_pin_get_mode_obj },
+    EDGE_METHODS,
 };
 
 STATIC MP_DEFINE_CONST_DICT(microbit_dig_pin_locals_dict, microbit_dig_pin_locals_dict_table);
@@ -27,6 +27,8 @@
 #include "py/runtime.h"
 #include "microbit/microbitpin.h"
 #include "lib/pwm.h"
+#include "lib/edges.h"
+#include "lib/adcstream.h"
 
 uint8_t microbit_pinmode_indices[32] = { 0 };
 
@@ -93,6 +95,19 @@ static void analog_release(const microbit_pin_obj_t *pin) {
     pwm_release(pin->name);
 }
 
+static void edges_release(const microbit_pin_obj_t *pin) {
+    int channel = edges_channel(pin->name);
+    if (channel >= 0) {
+        edges_stop(channel);
+        MP_STATE_PORT(pin_edges)[channel] = NULL;
+    }
+}
+
+static void read_analog_release(const microbit_pin_obj_t *pin) {
+    (void)pin;
+    adcstream_stop();
+}
+
 const microbit_pinmode_t microbit_pinmodes[] = {
     [MODE_UNUSED]        = { MP_QSTR_unused, noop },
     [MODE_WRITE_ANALOG]  = { MP_QSTR_write_analog, analog_release },
@@ -104,5 +119,7 @@ const microbit_pinmode_t microbit_pinmodes[] = {
     [MODE_AUDIO_PLAY]    = { MP_QSTR_audio, noop },
     [MODE_TOUCH]         = { MP_QSTR_touch, pinmode_error },
     [MODE_I2C]           = { MP_QSTR_i2c, pinmode_error },
-    [MODE_SPI]           = { MP_QSTR_spi, pinmode_error }
+    [MODE_SPI]           = { MP_QSTR_spi, pinmode_error },
+    [MODE_EDGES]         = { MP_QSTR_edges, edges_release },
+    [MODE_READ_ANALOG]   = { MP_QSTR_read_analog, read_analog_release }
 };
@@ -42,6 +42,8 @@ extern "C" {
 #include "py/objstr.h"
 #include "py/mphal.h"
 #include "py/gc.h"
+#include "py/stream.h"
+#include "lib/adpcm.h"
 #include "microbit/modaudio.h"
 #include "microbit/microbitobj.h"
 #include "microbit/microbitpin.h"
@@ -650,12 +652,107 @@ microbit_audio_frame_obj_t *new_microbit_audio_frame(void) {
     return res;
 }
 
+/* ADPCM source. Decodes 4-bit IMA-ADPCM from a file or buffer into a single AudioFrame
+ * which is reused for every frame, so no allocation takes place during playback. */
+
+#define ADPCM_BYTES_PER_FRAME (AUDIO_CHUNK_SIZE/2)
+
+typedef struct _microbit_adpcm_source_obj_t {
+    mp_obj_base_t base;
+    mp_obj_t source;
+    /* NULL if source is a buffer rather than a stream */
+    const mp_stream_p_t *stream;
+    uint32_t offset;
+    adpcm_state_t state;
+    microbit_audio_frame_obj_t *frame;
+} microbit_adpcm_source_obj_t;
+
+static mp_uint_t adpcm_source_read(microbit_adpcm_source_obj_t *self, uint8_t *dest, mp_uint_t size) {
+    if (self->stream != NULL) {
+        int errcode;
+        mp_uint_t len = self->stream->read(self->source, dest, size, &errcode);
+        if (len == MP_STREAM_ERROR) {
+            return 0;
+        }
+        return len;
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(self->source, &bufinfo, MP_BUFFER_READ);
+    if (self->offset >= bufinfo.len) {
+        return 0;
+    }
+    mp_uint_t len = bufinfo.len - self->offset;
+    if (len > size) {
+        len = size;
+    }
+    memcpy(dest, ((uint8_t *)bufinfo.buf) + self->offset, len);
+    self->offset += len;
+    return len;
+}
+
+STATIC mp_obj_t microbit_adpcm_source_new(const mp_obj_type_t *type_in, mp_uint_t n_args, mp_uint_t n_kw, const mp_obj_t *args) {
+    (void)type_in;
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    microbit_adpcm_source_obj_t *self = m_new_obj(microbit_adpcm_source_obj_t);
+    self->base.type = &microbit_adpcm_source_type;
+    self->source = args[0];
+    self->offset = 0;
+    const mp_stream_p_t *stream = mp_obj_get_type(args[0])->stream_p;
+    if (stream != NULL && stream->read != NULL) {
+        if (stream->is_text) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "file must be opened in binary mode"));
+        }
+        self->stream = stream;
+    } else {
+        self->stream = NULL;
+    }
+    uint8_t header[ADPCM_HEADER_SIZE];
+    if (adpcm_source_read(self, header, ADPCM_HEADER_SIZE) != ADPCM_HEADER_SIZE ||
+        adpcm_read_header(&self->state, header) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid ADPCM header"));
+    }
+    self->frame = new_microbit_audio_frame();
+    return self;
+}
+
+static mp_obj_t microbit_adpcm_source_iter_next(mp_obj_t self_in) {
+    microbit_adpcm_source_obj_t *self = (microbit_adpcm_source_obj_t *)self_in;
+    uint8_t data[ADPCM_BYTES_PER_FRAME];
+    mp_uint_t len = adpcm_source_read(self, data, ADPCM_BYTES_PER_FRAME);
+    if (len == 0) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    adpcm_decode(&self->state, data, self->frame->data, len);
+    // Pad a short final frame with silence.
+    memset(self->frame->data + len*2, 128, AUDIO_CHUNK_SIZE - len*2);
+    return self->frame;
+}
+
+const mp_obj_type_t microbit_adpcm_source_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_ADPCM,
+    .print = NULL,
+    .make_new = microbit_adpcm_source_new,
+    .call = NULL,
+    .unary_op = NULL,
+    .binary_op = NULL,
+    .attr = NULL,
+    .subscr = NULL,
+    .getiter = mp_identity,
+    .iternext = microbit_adpcm_source_iter_next,
+    .buffer_p = {NULL},
+    .stream_p = NULL,
+    .bases_tuple = NULL,
+    .locals_dict = NULL,
+};
+
 STATIC const mp_map_elem_t audio_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_audio) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_stop), (mp_obj_t)&microbit_audio_stop_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_play), (mp_obj_t)&microbit_audio_play_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_is_playing), (mp_obj_t)&microbit_audio_is_playing_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_AudioFrame), (mp_obj_t)&microbit_audio_frame_type },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_ADPCM), (mp_obj_t)&microbit_adpcm_source_type },
 };
 
 STATIC MP_DEFINE_CONST_DICT(audio_module_globals, audio_globals_table);
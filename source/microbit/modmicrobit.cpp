@@ -31,7 +31,9 @@ extern "C" {
 #include "py/nlr.h"
 #include "py/obj.h"
 #include "py/mphal.h"
+#include "py/binary.h"
 #include "modmicrobit.h"
+#include "microbitobj.h"
 #include "microbitdisplay.h"
 #include "microbitimage.h"
 
@@ -62,6 +64,66 @@ STATIC mp_obj_t microbit_running_time(void) {
 }
 MP_DEFINE_CONST_FUN_OBJ_0(microbit_running_time_obj, microbit_running_time);
 
+mp_obj_t microbit_obj_store_values(mp_obj_t buf_in, const int *values, size_t n) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    if (bufinfo.len / mp_binary_get_size('@', bufinfo.typecode, NULL) < n) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "buffer too small"));
+    }
+    for (size_t i = 0; i < n; i++) {
+        mp_binary_set_val_array_from_int(bufinfo.typecode, bufinfo.buf, i, values[i]);
+    }
+    return buf_in;
+}
+
+// The pins whose levels read_sensors() reports, as bit `number` of the mask.
+static const microbit_pin_obj_t *const sensor_pins[] = {
+    &microbit_p0_obj, &microbit_p1_obj, &microbit_p2_obj, &microbit_p3_obj,
+    &microbit_p4_obj, &microbit_p5_obj, &microbit_p6_obj, &microbit_p7_obj,
+    &microbit_p8_obj, &microbit_p9_obj, &microbit_p10_obj, &microbit_p11_obj,
+    &microbit_p12_obj, &microbit_p13_obj, &microbit_p14_obj, &microbit_p15_obj,
+    &microbit_p16_obj, &microbit_p19_obj, &microbit_p20_obj,
+};
+
+#define SENSOR_VALUES 9
+
+STATIC mp_obj_t microbit_read_sensors(mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    size_t n = bufinfo.len / mp_binary_get_size('@', bufinfo.typecode, NULL);
+    if (n > SENSOR_VALUES) {
+        n = SENSOR_VALUES;
+    }
+    // Only read the sensors there is room for, since the accelerometer and
+    // compass each take an I2C transfer.
+    int values[SENSOR_VALUES];
+    if (n > 0) {
+        microbit_accelerometer_get_values(&microbit_accelerometer_obj, &values[0], &values[1], &values[2]);
+    }
+    if (n > 3) {
+        microbit_compass_get_values(&microbit_compass_obj, &values[3], &values[4], &values[5]);
+    }
+    if (n > 6) {
+        values[6] = microbit_button_is_pressed(&microbit_button_a_obj)
+            | microbit_button_is_pressed(&microbit_button_b_obj) << 1;
+    }
+    if (n > 7) {
+        // Read all the pins at the same instant.
+        uint32_t in = NRF_GPIO->IN;
+        uint32_t pins = 0;
+        for (size_t i = 0; i < MP_ARRAY_SIZE(sensor_pins); i++) {
+            pins |= ((in >> sensor_pins[i]->name) & 1) << sensor_pins[i]->number;
+        }
+        values[7] = pins & 0xffff;
+        values[8] = pins >> 16;
+    }
+    for (size_t i = 0; i < n; i++) {
+        mp_binary_set_val_array_from_int(bufinfo.typecode, bufinfo.buf, i, values[i]);
+    }
+    return MP_OBJ_NEW_SMALL_INT(n);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(microbit_read_sensors_obj, microbit_read_sensors);
+
 static const monochrome_5by5_t panic = SMALL_IMAGE(
     1,1,0,1,1,
     1,1,0,1,1,
@@ -125,6 +187,8 @@ STATIC const mp_map_elem_t microbit_module_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_running_time), (mp_obj_t)&microbit_running_time_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_panic), (mp_obj_t)&microbit_panic_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_temperature), (mp_obj_t)&microbit_temperature_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_read_sensors), (mp_obj_t)&microbit_read_sensors_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_orientation), (mp_obj_t)&microbit_orientation_obj },
     
     { MP_OBJ_NEW_QSTR(MP_QSTR_pin0), (mp_obj_t)&microbit_p0_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_pin1), (mp_obj_t)&microbit_p1_obj },
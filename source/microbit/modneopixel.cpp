@@ -27,6 +27,7 @@
 extern "C" {
 
 #include <stdio.h>
+#include <string.h>
 #include "gpio_api.h"
 #include "py/runtime0.h"
 #include "py/runtime.h"
@@ -38,6 +39,7 @@ extern const mp_obj_type_t neopixel_type;
 typedef struct _neopixel_obj_t {
     mp_obj_base_t base;
     neopixel_strip_t strip;
+    uint8_t *gamma; // a copy of the last user supplied gamma table, or NULL
 } neopixel_obj_t;
 
 STATIC mp_obj_t neopixel_make_new(const mp_obj_type_t *type_in, mp_uint_t n_args, mp_uint_t n_kw, const mp_obj_t *args) {
@@ -53,7 +55,10 @@ STATIC mp_obj_t neopixel_make_new(const mp_obj_type_t *type_in, mp_uint_t n_args
 
     neopixel_obj_t *self = m_new_obj(neopixel_obj_t);
     self->base.type = &neopixel_type;
-    neopixel_init(&self->strip, pin, num_pixels);
+    if (neopixel_init(&self->strip, pin, num_pixels) != 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError, "not enough memory for pixels"));
+    }
+    self->gamma = NULL;
 
     return self;
 }
@@ -66,8 +71,48 @@ STATIC mp_obj_t neopixel_unary_op(mp_uint_t op, mp_obj_t self_in) {
     }
 }
 
+STATIC void neopixel_get_colour(mp_obj_t colour, uint8_t *rgb) {
+    mp_obj_t *items;
+    mp_obj_get_array_fixed_n(colour, 3, &items);
+    for (int i = 0; i < 3; i++) {
+        mp_int_t c = mp_obj_get_int(items[i]);
+        if (c < 0 || c > 255) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid colour"));
+        }
+        rgb[i] = c;
+    }
+}
+
 STATIC mp_obj_t neopixel_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_obj_t value) {
     neopixel_obj_t *self = (neopixel_obj_t*)self_in;
+    if (MP_OBJ_IS_TYPE(index_in, &mp_type_slice) && value != MP_OBJ_NULL && value != MP_OBJ_SENTINEL) {
+        // store a slice, either from a buffer of GRB bytes or a sequence of colours
+        mp_bound_slice_t slice;
+        if (!mp_seq_get_fast_slice_indexes(self->strip.num_leds, index_in, &slice)) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_NotImplementedError, "only slices with step=1 are supported"));
+        }
+        mp_uint_t len = slice.stop > slice.start ? slice.stop - slice.start : 0;
+        mp_buffer_info_t bufinfo;
+        if (mp_get_buffer(value, &bufinfo, MP_BUFFER_READ)) {
+            if (bufinfo.len != len * sizeof(color_t)) {
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "buffer must have 3 bytes per pixel"));
+            }
+            memmove(&self->strip.leds[slice.start], bufinfo.buf, bufinfo.len);
+        } else {
+            mp_uint_t n;
+            mp_obj_t *items;
+            mp_obj_get_array(value, &n, &items);
+            if (n != len) {
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "wrong number of colours"));
+            }
+            for (mp_uint_t i = 0; i < n; i++) {
+                uint8_t rgb[3];
+                neopixel_get_colour(items[i], rgb);
+                neopixel_set_color(&self->strip, slice.start + i, rgb[0], rgb[1], rgb[2]);
+            }
+        }
+        return mp_const_none;
+    }
     mp_uint_t index = mp_get_index(self->base.type, self->strip.num_leds, index_in, false);
     if (value == MP_OBJ_NULL) {
         // delete item
@@ -82,19 +127,160 @@ STATIC mp_obj_t neopixel_subscr(mp_obj_t self_in, mp_obj_t index_in, mp_obj_t va
         return mp_obj_new_tuple(3, rgb);
     } else {
         // store
-        mp_obj_t *rgb;
-        mp_obj_get_array_fixed_n(value, 3, &rgb);
-        mp_int_t r = mp_obj_get_int(rgb[0]);
-        mp_int_t g = mp_obj_get_int(rgb[1]);
-        mp_int_t b = mp_obj_get_int(rgb[2]);
-        if (r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255) {
-            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid colour"));
-        }
-        neopixel_set_color(&self->strip, index, r, g, b);
+        uint8_t rgb[3];
+        neopixel_get_colour(value, rgb);
+        neopixel_set_color(&self->strip, index, rgb[0], rgb[1], rgb[2]);
         return mp_const_none;
     }
 }
 
+STATIC mp_int_t neopixel_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
+    (void)flags;
+    // the colours as stored, in green, red, blue order
+    neopixel_obj_t *self = (neopixel_obj_t*)self_in;
+    bufinfo->buf = self->strip.leds;
+    bufinfo->len = self->strip.num_leds * sizeof(color_t);
+    bufinfo->typecode = 'B';
+    return 0;
+}
+
+// Get the start and stop of a range of pixels from optional arguments,
+// clipped to the strip like a slice.
+STATIC void neopixel_get_range(neopixel_obj_t *self, mp_obj_t start_in, mp_obj_t stop_in, uint16_t *start, uint16_t *stop) {
+    mp_int_t len = self->strip.num_leds;
+    mp_int_t range[2] = {0, len};
+    mp_obj_t args[2] = {start_in, stop_in};
+    for (int i = 0; i < 2; i++) {
+        if (args[i] != mp_const_none) {
+            mp_int_t value = mp_obj_get_int(args[i]);
+            if (value < 0) {
+                value += len;
+            }
+            range[i] = value < 0 ? 0 : value > len ? len : value;
+        }
+    }
+    *start = range[0];
+    *stop = range[1] > range[0] ? range[1] : range[0];
+}
+
+STATIC mp_obj_t neopixel_fill_(mp_obj_t self_in, mp_obj_t colour) {
+    neopixel_obj_t *self = (neopixel_obj_t*)self_in;
+    uint8_t rgb[3];
+    neopixel_get_colour(colour, rgb);
+    neopixel_fill(&self->strip, 0, self->strip.num_leds, rgb[0], rgb[1], rgb[2]);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(neopixel_fill_obj, neopixel_fill_);
+
+STATIC mp_obj_t neopixel_gradient_(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_from,  MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_to,    MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_start, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_stop,  MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    neopixel_obj_t *self = (neopixel_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    uint8_t from[3], to[3];
+    neopixel_get_colour(args[0].u_obj, from);
+    neopixel_get_colour(args[1].u_obj, to);
+    uint16_t start, stop;
+    neopixel_get_range(self, args[2].u_obj, args[3].u_obj, &start, &stop);
+    neopixel_gradient(&self->strip, start, stop, from, to);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(neopixel_gradient_obj, 1, neopixel_gradient_);
+
+STATIC mp_obj_t neopixel_hsv_(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_hue,        MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_end_hue,    MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_saturation, MP_ARG_INT, {.u_int = 255} },
+        { MP_QSTR_value,      MP_ARG_INT, {.u_int = 255} },
+        { MP_QSTR_start,      MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_stop,       MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+    neopixel_obj_t *self = (neopixel_obj_t*)pos_args[0];
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_int_t hue = args[0].u_int;
+    mp_int_t end_hue = args[1].u_obj == mp_const_none ? hue : mp_obj_get_int(args[1].u_obj);
+    mp_int_t saturation = args[2].u_int;
+    mp_int_t value = args[3].u_int;
+    if (saturation < 0 || saturation > 255 || value < 0 || value > 255) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid colour"));
+    }
+    uint16_t start, stop;
+    neopixel_get_range(self, args[4].u_obj, args[5].u_obj, &start, &stop);
+    neopixel_hsv(&self->strip, start, stop, hue, end_hue, saturation, value);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(neopixel_hsv_obj, 1, neopixel_hsv_);
+
+STATIC mp_obj_t neopixel_rotate_(mp_uint_t n_args, const mp_obj_t *args) {
+    neopixel_obj_t *self = (neopixel_obj_t*)args[0];
+    neopixel_rotate(&self->strip, n_args > 1 ? mp_obj_get_int(args[1]) : 1);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(neopixel_rotate_obj, 1, 2, neopixel_rotate_);
+
+STATIC mp_obj_t neopixel_shift_(mp_uint_t n_args, const mp_obj_t *args) {
+    neopixel_obj_t *self = (neopixel_obj_t*)args[0];
+    neopixel_shift(&self->strip, n_args > 1 ? mp_obj_get_int(args[1]) : 1);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(neopixel_shift_obj, 1, 2, neopixel_shift_);
+
+STATIC mp_obj_t neopixel_scale_(mp_obj_t self_in, mp_obj_t level_in) {
+    neopixel_obj_t *self = (neopixel_obj_t*)self_in;
+    mp_int_t level = mp_obj_get_int(level_in);
+    if (level < 0 || level > 255) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "level must be between 0 and 255"));
+    }
+    neopixel_scale(&self->strip, level);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(neopixel_scale_obj, neopixel_scale_);
+
+STATIC mp_obj_t neopixel_set_brightness_(mp_obj_t self_in, mp_obj_t level_in) {
+    neopixel_obj_t *self = (neopixel_obj_t*)self_in;
+    mp_int_t level = mp_obj_get_int(level_in);
+    if (level < 0 || level > 255) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "level must be between 0 and 255"));
+    }
+    neopixel_set_brightness(&self->strip, level);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(neopixel_set_brightness_obj, neopixel_set_brightness_);
+
+STATIC mp_obj_t neopixel_get_brightness_(mp_obj_t self_in) {
+    neopixel_obj_t *self = (neopixel_obj_t*)self_in;
+    return MP_OBJ_NEW_SMALL_INT(self->strip.brightness);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(neopixel_get_brightness_obj, neopixel_get_brightness_);
+
+STATIC mp_obj_t neopixel_set_gamma_(mp_obj_t self_in, mp_obj_t table_in) {
+    neopixel_obj_t *self = (neopixel_obj_t*)self_in;
+    mp_buffer_info_t bufinfo;
+    if (table_in == mp_const_true) {
+        neopixel_set_gamma(&self->strip, neopixel_gamma_table);
+    } else if (table_in == mp_const_none || table_in == mp_const_false) {
+        neopixel_set_gamma(&self->strip, NULL);
+    } else if (mp_get_buffer(table_in, &bufinfo, MP_BUFFER_READ) && bufinfo.len == 256) {
+        // copy it, so that the table can't be resized or freed under the strip
+        if (self->gamma == NULL) {
+            self->gamma = m_new(uint8_t, 256);
+        }
+        memcpy(self->gamma, bufinfo.buf, 256);
+        neopixel_set_gamma(&self->strip, self->gamma);
+    } else {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "gamma table must be 256 bytes"));
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_2(neopixel_set_gamma_obj, neopixel_set_gamma_);
+
 STATIC mp_obj_t neopixel_clear_(mp_obj_t self_in) {
     neopixel_obj_t *self = (neopixel_obj_t*)self_in;
     neopixel_clear(&self->strip);
@@ -112,6 +298,15 @@ MP_DEFINE_CONST_FUN_OBJ_1(neopixel_show_obj, neopixel_show_);
 STATIC const mp_map_elem_t neopixel_locals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_clear), (mp_obj_t)&neopixel_clear_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_show), (mp_obj_t)&neopixel_show_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_fill), (mp_obj_t)&neopixel_fill_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_gradient), (mp_obj_t)&neopixel_gradient_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_hsv), (mp_obj_t)&neopixel_hsv_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_rotate), (mp_obj_t)&neopixel_rotate_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_shift), (mp_obj_t)&neopixel_shift_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_scale), (mp_obj_t)&neopixel_scale_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_brightness), (mp_obj_t)&neopixel_set_brightness_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_brightness), (mp_obj_t)&neopixel_get_brightness_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_gamma), (mp_obj_t)&neopixel_set_gamma_obj },
 };
 
 STATIC MP_DEFINE_CONST_DICT(neopixel_locals_dict, neopixel_locals_dict_table);
@@ -128,7 +323,7 @@ const mp_obj_type_t neopixel_type = {
     .subscr = neopixel_subscr,
     .getiter = NULL,
     .iternext = NULL,
-    .buffer_p = {NULL},
+    .buffer_p = { .get_buffer = neopixel_get_buffer },
     .stream_p = NULL,
     .bases_tuple = NULL,
     .locals_dict = (mp_obj_dict_t*)&neopixel_locals_dict,
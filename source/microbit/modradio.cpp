@@ -31,62 +31,22 @@ extern "C" {
 
 #include "py/runtime0.h"
 #include "py/runtime.h"
+#include "py/binary.h"
 #include "microbitobj.h"
+#include "lib/radio.h"
 
 #define RADIO_DEFAULT_MAX_PAYLOAD   (32)
 #define RADIO_DEFAULT_QUEUE_LEN     (3)
+#define RADIO_DEFAULT_TX_QUEUE_LEN  (2)
 #define RADIO_DEFAULT_CHANNEL       (7)
 #define RADIO_DEFAULT_POWER_DBM     (0)
 #define RADIO_DEFAULT_BASE0         (0x75626974) // "uBit"
 #define RADIO_DEFAULT_PREFIX0       (0)
 #define RADIO_DEFAULT_DATA_RATE     (RADIO_MODE_MODE_Nrf_1Mbit)
-
-typedef struct _radio_state_t {
-    uint8_t max_payload;    // 1-251 inclusive
-    uint8_t queue_len;      // 1-254 inclusive
-    uint8_t channel;        // 0-100 inclusive
-    int8_t power_dbm;       // one of: -30, -20, -16, -12, -8, -4, 0, 4
-    uint32_t base0;         // for BASE0 register
-    uint8_t prefix0;        // for PREFIX0 register (lower 8 bits only)
-    uint8_t data_rate;      // one of: RADIO_MODE_MODE_Nrf_{250Kbit,1Mbit,2Mbit}
-} radio_state_t;
+#define RADIO_DEFAULT_LARGE_LEN     (0)
+#define RADIO_DEFAULT_SLOT_TIME     (18)
 
 static radio_state_t radio_state;
-static uint8_t *buf_end = NULL;
-static uint8_t *rx_buf = NULL;
-
-void RADIO_IRQHandler(void) {
-    if (NRF_RADIO->EVENTS_READY) {
-        NRF_RADIO->EVENTS_READY = 0;
-        NRF_RADIO->TASKS_START = 1;
-    }
-
-    if (NRF_RADIO->EVENTS_END) {
-        NRF_RADIO->EVENTS_END = 0;
-
-        size_t max_len = NRF_RADIO->PCNF1 & 0xff;
-        size_t len = rx_buf[0];
-        if (len > max_len) {
-            len = max_len;
-            rx_buf[0] = len;
-        }
-
-        //printf("radio end pos=%d len=%d [%d %d %d %d]\r\n", rx_buf - MP_STATE_PORT(radio_buf), len, rx_buf[0], rx_buf[1], rx_buf[2], rx_buf[3]);
-
-        // if the CRC was valid then accept the packet
-        if (NRF_RADIO->CRCSTATUS == 1) {
-            //printf("rssi: %d\r\n", -NRF_RADIO->RSSISAMPLE);
-
-            // only move the rx_buf pointer if there is enough room for another full packet
-            if (rx_buf + 1 + len + 1 + max_len <= buf_end) {
-                rx_buf += 1 + len;
-                NRF_RADIO->PACKETPTR = (uint32_t)rx_buf;
-            }
-        }
-
-        NRF_RADIO->TASKS_START = 1;
-    }
-}
 
 static void ensure_enabled(void) {
     if (MP_STATE_PORT(radio_buf) == NULL) {
@@ -95,13 +55,10 @@ static void ensure_enabled(void) {
 }
 
 static void radio_disable(void) {
-    NVIC_DisableIRQ(RADIO_IRQn);
-    NRF_RADIO->EVENTS_DISABLED = 0;
-    NRF_RADIO->TASKS_DISABLE = 1;
-    while (NRF_RADIO->EVENTS_DISABLED == 0);
+    radio_deinit();
     // free any old buffers
     if (MP_STATE_PORT(radio_buf) != NULL) {
-        m_del(uint8_t, MP_STATE_PORT(radio_buf), buf_end - MP_STATE_PORT(radio_buf));
+        m_del(uint8_t, MP_STATE_PORT(radio_buf), radio_buffer_size(&radio_state));
         MP_STATE_PORT(radio_buf) = NULL;
     }
 }
@@ -110,184 +67,83 @@ static void radio_enable(void) {
     radio_disable();
 
     // allocate tx and rx buffers
-    size_t max_payload = radio_state.max_payload + 1; // an extra byte to store the length
-    size_t queue_len = radio_state.queue_len + 1; // one extra for tx buffer
-    MP_STATE_PORT(radio_buf) = m_new(uint8_t, max_payload * queue_len);
-    buf_end = MP_STATE_PORT(radio_buf) + max_payload * queue_len;
-    rx_buf = MP_STATE_PORT(radio_buf) + max_payload; // start is tx buffer
-
-    // Enable the High Frequency clock on the processor. This is a pre-requisite for
-    // the RADIO module. Without this clock, no communication is possible.
-    NRF_CLOCK->EVENTS_HFCLKSTARTED = 0;
-    NRF_CLOCK->TASKS_HFCLKSTART = 1;
-    while (NRF_CLOCK->EVENTS_HFCLKSTARTED == 0);
-
-    // power should be one of: -30, -20, -16, -12, -8, -4, 0, 4
-    NRF_RADIO->TXPOWER = radio_state.power_dbm;
-
-    // should be between 0 and 100 inclusive (actual physical freq is 2400MHz + this register)
-    NRF_RADIO->FREQUENCY = radio_state.channel;
-
-    // configure data rate
-    NRF_RADIO->MODE = radio_state.data_rate;
-
-    // The radio supports filtering packets at the hardware level based on an address.
-    // We use a 5-byte address comprised of 4 bytes (set by BALEN=4 below) from the BASEx
-    // register, plus 1 byte from PREFIXm.APn.
-    // The (x,m,n) values are selected by the logical address.  We use logical address 0
-    // which means using BASE0 with PREFIX0.AP0.
-    NRF_RADIO->BASE0 = radio_state.base0;
-    NRF_RADIO->PREFIX0 = radio_state.prefix0;
-    NRF_RADIO->TXADDRESS = 0; // transmit on logical address 0
-    NRF_RADIO->RXADDRESSES = 1; // a bit mask, listen only to logical address 0
-
-    // LFLEN=8 bits, S0LEN=0, S1LEN=0
-    NRF_RADIO->PCNF0 = 0x00000008;
-    // STATLEN=0, BALEN=4, ENDIAN=0 (little), WHITEEN=1
-    NRF_RADIO->PCNF1 = 0x02040000 | radio_state.max_payload;
-
-    // Enable automatic 16bit CRC generation and checking, and configure how the CRC is calculated.
-    NRF_RADIO->CRCCNF = RADIO_CRCCNF_LEN_Two;
-    NRF_RADIO->CRCINIT = 0xFFFF;
-    NRF_RADIO->CRCPOLY = 0x11021;
-
-    // Set the start random value of the data whitening algorithm. This can be any non zero number.
-    NRF_RADIO->DATAWHITEIV = 0x18;
-
-    // set receive buffer
-    NRF_RADIO->PACKETPTR = (uint32_t)rx_buf;
-
-    // configure interrupts
-    NRF_RADIO->INTENSET = 0x00000008;
-    NVIC_ClearPendingIRQ(RADIO_IRQn);
-    NVIC_EnableIRQ(RADIO_IRQn);
-
-    NRF_RADIO->SHORTS |= RADIO_SHORTS_ADDRESS_RSSISTART_Msk;
-
-    // enable receiver
-    NRF_RADIO->EVENTS_READY = 0;
-    NRF_RADIO->TASKS_RXEN = 1;
-    while (NRF_RADIO->EVENTS_READY == 0);
-
-    NRF_RADIO->EVENTS_END = 0;
-    NRF_RADIO->TASKS_START = 1;
-}
-
-void radio_send(const void *buf, size_t len, const void *buf2, size_t len2) {
-    ensure_enabled();
-
-    // construct the packet
-    // note: we must send from RAM
-    size_t max_len = NRF_RADIO->PCNF1 & 0xff;
-    if (len + len2 > max_len) {
-        if (len > max_len) {
-            len = max_len;
-            len2 = 0;
-        } else {
-            len2 = max_len - len;
-        }
-    }
-    MP_STATE_PORT(radio_buf)[0] = len + len2;
-    memcpy(MP_STATE_PORT(radio_buf) + 1, buf, len);
-    if (len2 != 0) {
-        memcpy(MP_STATE_PORT(radio_buf) + 1 + len, buf2, len2);
-    }
-
-    // transmission will occur synchronously
-    NVIC_DisableIRQ(RADIO_IRQn);
-
-    // Turn off the transceiver.
-    NRF_RADIO->EVENTS_DISABLED = 0;
-    NRF_RADIO->TASKS_DISABLE = 1;
-    while (NRF_RADIO->EVENTS_DISABLED == 0);
-
-    // Configure the radio to send the buffer provided.
-    NRF_RADIO->PACKETPTR = (uint32_t)MP_STATE_PORT(radio_buf);
-
-    // Turn on the transmitter, and wait for it to signal that it's ready to use.
-    NRF_RADIO->EVENTS_READY = 0;
-    NRF_RADIO->TASKS_TXEN = 1;
-    while (NRF_RADIO->EVENTS_READY == 0);
-
-    // Start transmission and wait for end of packet.
-    NRF_RADIO->TASKS_START = 1;
-    NRF_RADIO->EVENTS_END = 0;
-    while (NRF_RADIO->EVENTS_END == 0);
-
-    // Return the radio to using the default receive buffer
-    NRF_RADIO->PACKETPTR = (uint32_t)rx_buf;
-
-    // Turn off the transmitter.
-    NRF_RADIO->EVENTS_DISABLED = 0;
-    NRF_RADIO->TASKS_DISABLE = 1;
-    while (NRF_RADIO->EVENTS_DISABLED == 0);
-
-    // Start listening for the next packet
-    NRF_RADIO->EVENTS_READY = 0;
-    NRF_RADIO->TASKS_RXEN = 1;
-    while (NRF_RADIO->EVENTS_READY == 0);
-
-    NRF_RADIO->EVENTS_END = 0;
-    NRF_RADIO->TASKS_START = 1;
-
-    NVIC_ClearPendingIRQ(RADIO_IRQn);
-    NVIC_EnableIRQ(RADIO_IRQn);
+    MP_STATE_PORT(radio_buf) = m_new(uint8_t, radio_buffer_size(&radio_state));
+    radio_init(&radio_state, MP_STATE_PORT(radio_buf));
 }
 
 static mp_obj_t radio_receive(bool typed_packet, mp_buffer_info_t *bufinfo) {
     ensure_enabled();
 
-    // disable the radio irq while we receive the packet
-    NVIC_DisableIRQ(RADIO_IRQn);
-
-    // get the pointer to the next packet
-    uint8_t *buf = MP_STATE_PORT(radio_buf) + (NRF_RADIO->PCNF1 & 0xff) + 1; // skip tx buf
-
     // return None if there are no packets waiting
-    if (rx_buf == buf) {
-        NVIC_EnableIRQ(RADIO_IRQn);
+    radio_packet_t *packet = radio_peek();
+    if (packet == NULL) {
         return mp_const_none;
     }
 
-    // convert the packet data into a Python object
-    size_t len = buf[0];
+    // Convert the packet data into a Python object.  The radio doesn't touch
+    // the packet until it is popped, so there's no need to disable the IRQ,
+    // and if this raises then the packet stays queued.
+    size_t len = packet->len;
+    uint8_t *buf = packet->data;
     mp_obj_t ret;
     if (!typed_packet) {
         if (bufinfo == NULL) {
-            ret = mp_obj_new_bytes(buf + 1, len); // if it raises the radio irq remains disabled...
+            ret = mp_obj_new_bytes(buf, len);
         } else {
-            memmove(bufinfo->buf, buf+1, len < bufinfo->len ? len : bufinfo->len);
+            memcpy(bufinfo->buf, buf, len < bufinfo->len ? len : bufinfo->len);
             ret = MP_OBJ_NEW_SMALL_INT(len);
         }
-    } else if (len >= 3 && buf[1] == 1 && buf[2] == 0 && buf[3] == 1) {
-        ret = mp_obj_new_str((char*)buf + 4, len - 3, false); // if it raises the radio irq remains disabled...
+    } else if (len >= 3 && buf[0] == 1 && buf[1] == 0 && buf[2] == 1) {
+        ret = mp_obj_new_str((char*)buf + 3, len - 3, false);
     } else {
-        NVIC_EnableIRQ(RADIO_IRQn);
+        radio_pop();
         nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "received packet is not a string"));
     }
 
-    // copy the rest of the packets down and restart the radio
-    memmove(buf, buf + 1 + len, rx_buf - (buf + 1 + len));
-    rx_buf -= 1 + len;
-    NRF_RADIO->PACKETPTR = (uint32_t)rx_buf;
-    NRF_RADIO->EVENTS_END = 0;
-    NRF_RADIO->TASKS_START = 1;
-    NVIC_EnableIRQ(RADIO_IRQn);
-
+    radio_pop();
     return ret;
 }
 
+static mp_obj_t radio_receive_full(void) {
+    ensure_enabled();
+
+    radio_packet_t *packet = radio_peek();
+    if (packet == NULL) {
+        return mp_const_none;
+    }
+
+    mp_obj_t tuple[4] = {
+        mp_obj_new_bytes(packet->data, packet->len),
+        MP_OBJ_NEW_SMALL_INT(packet->rssi),
+        MP_OBJ_NEW_SMALL_INT(packet->ticks),
+        MP_OBJ_NEW_SMALL_INT(radio_state.prefix[packet->match]),
+    };
+    radio_pop();
+    return mp_obj_new_tuple(4, tuple);
+}
+
 /*****************************************************************************/
 // MicroPython bindings and module
 
 STATIC mp_obj_t mod_radio_reset(void) {
+    memset(&radio_stats, 0, sizeof(radio_stats));
     radio_state.max_payload = RADIO_DEFAULT_MAX_PAYLOAD;
     radio_state.queue_len = RADIO_DEFAULT_QUEUE_LEN;
+    radio_state.tx_queue_len = RADIO_DEFAULT_TX_QUEUE_LEN;
     radio_state.channel = RADIO_DEFAULT_CHANNEL;
     radio_state.power_dbm = RADIO_DEFAULT_POWER_DBM;
     radio_state.base0 = RADIO_DEFAULT_BASE0;
-    radio_state.prefix0 = RADIO_DEFAULT_PREFIX0;
+    memset(radio_state.prefix, 0, sizeof(radio_state.prefix));
+    radio_state.prefix[0] = RADIO_DEFAULT_PREFIX0;
+    radio_state.num_addresses = 1;
     radio_state.data_rate = RADIO_DEFAULT_DATA_RATE;
+    radio_state.large_len = RADIO_DEFAULT_LARGE_LEN;
+    radio_state.node_id = NRF_FICR->DEVICEID[0];
+    radio_state.reliable = false;
+    radio_state.tdma_slots = 0;
+    radio_state.tdma_slot = 0;
+    radio_state.slot_ticks = RADIO_DEFAULT_SLOT_TIME / RADIO_TDMA_TICK_MS;
+    radio_state.hops = 1;
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_reset_obj, mod_radio_reset);
@@ -305,8 +161,26 @@ STATIC mp_obj_t mod_radio_config(size_t n_args, const mp_obj_t *pos_args, mp_map
     qstr arg_name = MP_QSTR_;
     for (size_t i = 0; i < kw_args->alloc; ++i) {
         if (MP_MAP_SLOT_IS_FILLED(kw_args, i)) {
-            mp_int_t value = mp_obj_get_int_truncated(kw_args->table[i].value);
             arg_name = mp_obj_str_get_qstr(kw_args->table[i].key);
+            if (arg_name == MP_QSTR_addresses) {
+                mp_uint_t len;
+                mp_obj_t *items;
+                mp_obj_get_array(kw_args->table[i].value, &len, &items);
+                if (!(1 <= len && len <= RADIO_MAX_ADDRESSES)) {
+                    goto value_error;
+                }
+                memset(new_state.prefix, 0, sizeof(new_state.prefix));
+                for (mp_uint_t j = 0; j < len; j++) {
+                    mp_int_t group = mp_obj_get_int(items[j]);
+                    if (!(0 <= group && group <= 255)) {
+                        goto value_error;
+                    }
+                    new_state.prefix[j] = group;
+                }
+                new_state.num_addresses = len;
+                continue;
+            }
+            mp_int_t value = mp_obj_get_int_truncated(kw_args->table[i].value);
             switch (arg_name) {
                 case MP_QSTR_length:
                     if (!(1 <= value && value <= 251)) {
@@ -322,6 +196,53 @@ STATIC mp_obj_t mod_radio_config(size_t n_args, const mp_obj_t *pos_args, mp_map
                     new_state.queue_len = value;
                     break;
 
+                case MP_QSTR_tx_queue:
+                    if (!(1 <= value && value <= 254)) {
+                        goto value_error;
+                    }
+                    new_state.tx_queue_len = value;
+                    break;
+
+                case MP_QSTR_large_length:
+                    if (!(0 <= value && value <= 65535)) {
+                        goto value_error;
+                    }
+                    new_state.large_len = value;
+                    break;
+
+                case MP_QSTR_reliable:
+                    new_state.reliable = value != 0;
+                    break;
+
+                case MP_QSTR_tdma:
+                    if (!(value == 0 || (2 <= value && value <= 32))) {
+                        goto value_error;
+                    }
+                    new_state.tdma_slots = value;
+                    break;
+
+                case MP_QSTR_slot:
+                    if (!(0 <= value && value <= 31)) {
+                        goto value_error;
+                    }
+                    new_state.tdma_slot = value;
+                    break;
+
+                case MP_QSTR_slot_time:
+                    // in milliseconds, rounded down to a whole number of ticks
+                    if (!(3 * RADIO_TDMA_TICK_MS <= value && value <= 255 * RADIO_TDMA_TICK_MS)) {
+                        goto value_error;
+                    }
+                    new_state.slot_ticks = value / RADIO_TDMA_TICK_MS;
+                    break;
+
+                case MP_QSTR_hops:
+                    if (!(1 <= value && value <= 16)) {
+                        goto value_error;
+                    }
+                    new_state.hops = value;
+                    break;
+
                 case MP_QSTR_channel:
                     if (!(0 <= value && value <= 100)) {
                         goto value_error;
@@ -355,7 +276,7 @@ STATIC mp_obj_t mod_radio_config(size_t n_args, const mp_obj_t *pos_args, mp_map
                     if (!(0 <= value && value <= 255)) {
                         goto value_error;
                     }
-                    new_state.prefix0 = value;
+                    new_state.prefix[0] = value;
                     break;
 
                 default:
@@ -365,6 +286,10 @@ STATIC mp_obj_t mod_radio_config(size_t n_args, const mp_obj_t *pos_args, mp_map
         }
     }
 
+    if (new_state.tdma_slots != 0 && new_state.tdma_slot >= new_state.tdma_slots) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "slot must be less than tdma"));
+    }
+
     // reconfigure the radio with the new state
 
     if (MP_STATE_PORT(radio_buf) == NULL) {
@@ -372,39 +297,17 @@ STATIC mp_obj_t mod_radio_config(size_t n_args, const mp_obj_t *pos_args, mp_map
         radio_state = new_state;
     } else {
         // radio eabled
-        if (new_state.max_payload != radio_state.max_payload || new_state.queue_len != radio_state.queue_len) {
+        if (new_state.max_payload != radio_state.max_payload || new_state.queue_len != radio_state.queue_len
+            || new_state.tx_queue_len != radio_state.tx_queue_len || new_state.large_len != radio_state.large_len) {
             // tx/rx buffer size changed which requires reallocating the buffers
+            radio_flush_tx();
             radio_disable();
             radio_state = new_state;
             radio_enable();
         } else {
             // only registers changed so make the changes go through efficiently
-
-            // disable radio
-            NVIC_DisableIRQ(RADIO_IRQn);
-            NRF_RADIO->EVENTS_DISABLED = 0;
-            NRF_RADIO->TASKS_DISABLE = 1;
-            while (NRF_RADIO->EVENTS_DISABLED == 0);
-
-            // change state
             radio_state = new_state;
-            NRF_RADIO->TXPOWER = radio_state.power_dbm;
-            NRF_RADIO->FREQUENCY = radio_state.channel;
-            NRF_RADIO->MODE = radio_state.data_rate;
-            NRF_RADIO->BASE0 = radio_state.base0;
-            NRF_RADIO->PREFIX0 = radio_state.prefix0;
-
-            // need to set RXEN for FREQUENCY decision point
-            NRF_RADIO->EVENTS_READY = 0;
-            NRF_RADIO->TASKS_RXEN = 1;
-            while (NRF_RADIO->EVENTS_READY == 0);
-
-            // need to set START for BASE0 and PREFIX0 decision point
-            NRF_RADIO->EVENTS_END = 0;
-            NRF_RADIO->TASKS_START = 1;
-
-            NVIC_ClearPendingIRQ(RADIO_IRQn);
-            NVIC_EnableIRQ(RADIO_IRQn);
+            radio_set_config(&radio_state);
         }
     }
 
@@ -417,6 +320,7 @@ MP_DEFINE_CONST_FUN_OBJ_KW(mod_radio_config_obj, 0, mod_radio_config);
 
 STATIC mp_obj_t mod_radio_on(void) {
     radio_enable();
+    memset(&radio_stats, 0, sizeof(radio_stats));
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_on_obj, mod_radio_on);
@@ -428,6 +332,7 @@ STATIC mp_obj_t mod_radio_off(void) {
 MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_off_obj, mod_radio_off);
 
 STATIC mp_obj_t mod_radio_send_bytes(mp_obj_t buf_in) {
+    ensure_enabled();
     mp_buffer_info_t bufinfo;
     mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
     radio_send(bufinfo.buf, bufinfo.len, NULL, 0);
@@ -441,6 +346,7 @@ STATIC mp_obj_t mod_radio_receive_bytes(void) {
 MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_receive_bytes_obj, mod_radio_receive_bytes);
 
 STATIC mp_obj_t mod_radio_send(mp_obj_t buf_in) {
+    ensure_enabled();
     mp_uint_t len;
     const char *data = mp_obj_str_get_data(buf_in, &len);
     radio_send("\x01\x00\x01", 3, data, len);
@@ -460,6 +366,193 @@ STATIC mp_obj_t mod_radio_receive_bytes_into(mp_obj_t buf_in) {
 }
 MP_DEFINE_CONST_FUN_OBJ_1(mod_radio_receive_bytes_into_obj, mod_radio_receive_bytes_into);
 
+STATIC mp_obj_t mod_radio_receive_many(mp_obj_t buf_in, mp_obj_t offsets_in) {
+    mp_buffer_info_t bufinfo;
+    mp_buffer_info_t offsetsinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_WRITE);
+    mp_get_buffer_raise(offsets_in, &offsetsinfo, MP_BUFFER_WRITE);
+    ensure_enabled();
+
+    // Copy packets back to back into buf for as long as they fit, and there
+    // is room for their end offsets.  The radio doesn't touch the packets
+    // until they're popped, so this doesn't stop it receiving, and nothing
+    // here allocates.
+    size_t offset_size = mp_binary_get_size('@', offsetsinfo.typecode, NULL);
+    if (offset_size < sizeof(uint32_t)) {
+        // the offsets go up to the length of buf, so they must be able to
+        // hold it; lower case typecodes are signed
+        size_t bits = offset_size * 8 - (offsetsinfo.typecode >= 'a' ? 1 : 0);
+        if (bufinfo.len >= (size_t)1 << bits) {
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "offsets too small for buffer"));
+        }
+    }
+    size_t max_offsets = offsetsinfo.len / offset_size;
+    size_t count = 0;
+    size_t end = 0;
+    if (max_offsets > 0) {
+        mp_binary_set_val_array_from_int(offsetsinfo.typecode, offsetsinfo.buf, 0, 0);
+    }
+    radio_packet_t *packet;
+    while (count + 1 < max_offsets && (packet = radio_peek()) != NULL
+        && end + packet->len <= bufinfo.len) {
+        memcpy((uint8_t*)bufinfo.buf + end, packet->data, packet->len);
+        end += packet->len;
+        count += 1;
+        mp_binary_set_val_array_from_int(offsetsinfo.typecode, offsetsinfo.buf, count, end);
+        radio_pop();
+    }
+    return MP_OBJ_NEW_SMALL_INT(count);
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mod_radio_receive_many_obj, mod_radio_receive_many);
+
+STATIC mp_obj_t mod_radio_send_large(mp_obj_t buf_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    ensure_enabled();
+    if (bufinfo.len > radio_large_max_len(radio_state.max_payload)) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "message too long"));
+    }
+    radio_send_large(bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(mod_radio_send_large_obj, mod_radio_send_large);
+
+STATIC mp_obj_t mod_radio_receive_large(void) {
+    ensure_enabled();
+    size_t len;
+    const uint8_t *buf = radio_peek_large(&len);
+    if (buf == NULL) {
+        return mp_const_none;
+    }
+    mp_obj_t ret = mp_obj_new_bytes(buf, len);
+    radio_pop_large();
+    return ret;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_receive_large_obj, mod_radio_receive_large);
+
+STATIC mp_obj_t mod_radio_send_reliable(mp_obj_t buf_in, mp_obj_t to_in) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    mp_int_t to = mp_obj_get_int(to_in);
+    ensure_enabled();
+    if (!radio_state.reliable) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "reliable mode is not enabled"));
+    }
+    if (to < 0 || to > 0xffff) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid node id"));
+    }
+    // the reliable header comes out of each packet
+    if (bufinfo.len + RADIO_RELIABLE_HEADER_LEN > radio_state.max_payload) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "message too long"));
+    }
+    return mp_obj_new_bool(radio_send_reliable(to, bufinfo.buf, bufinfo.len));
+}
+MP_DEFINE_CONST_FUN_OBJ_2(mod_radio_send_reliable_obj, mod_radio_send_reliable);
+
+STATIC mp_obj_t mod_radio_node_id(void) {
+    return MP_OBJ_NEW_SMALL_INT(radio_state.node_id);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_node_id_obj, mod_radio_node_id);
+
+STATIC mp_obj_t mod_radio_synced(void) {
+    ensure_enabled();
+    return mp_obj_new_bool(radio_tdma_synced());
+}
+MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_synced_obj, mod_radio_synced);
+
+STATIC mp_obj_t mod_radio_stats(void) {
+    mp_obj_t rssi[RADIO_RSSI_BUCKETS];
+    for (size_t i = 0; i < RADIO_RSSI_BUCKETS; i++) {
+        rssi[i] = mp_obj_new_int_from_uint(radio_stats.rssi[i]);
+    }
+    mp_obj_t dict = mp_obj_new_dict(11);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_received), mp_obj_new_int_from_uint(radio_stats.received));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_crc_errors), mp_obj_new_int_from_uint(radio_stats.crc_errors));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_rx_dropped), mp_obj_new_int_from_uint(radio_stats.rx_dropped));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_rx_lost), mp_obj_new_int_from_uint(radio_stats.rx_lost));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_sent), mp_obj_new_int_from_uint(radio_stats.sent));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_tx_dropped), mp_obj_new_int_from_uint(radio_stats.tx_dropped));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_tx_time), mp_obj_new_int_from_uint(radio_stats.tx_time_us));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_tx_retries), mp_obj_new_int_from_uint(radio_stats.tx_retries));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_tx_failed), mp_obj_new_int_from_uint(radio_stats.tx_failed));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_beacons), mp_obj_new_int_from_uint(radio_stats.beacons));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_rssi), mp_obj_new_tuple(RADIO_RSSI_BUCKETS, rssi));
+    return dict;
+}
+MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_stats_obj, mod_radio_stats);
+
+enum {
+    RADIO_BENCH_FLOOD,
+    RADIO_BENCH_SINK,
+    RADIO_BENCH_PING,
+    RADIO_BENCH_ECHO,
+};
+
+// stop a benchmark on CTRL-C
+STATIC bool radio_bench_poll(void) {
+    return MP_STATE_VM(mp_pending_exception) == MP_OBJ_NULL;
+}
+
+STATIC mp_obj_t mod_radio_benchmark(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_mode,    MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0} },
+        { MP_QSTR_count,   MP_ARG_INT, {.u_int = 100} },
+        { MP_QSTR_length,  MP_ARG_INT, {.u_int = RADIO_DEFAULT_MAX_PAYLOAD} },
+        { MP_QSTR_timeout, MP_ARG_INT, {.u_int = 1000} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    ensure_enabled();
+    mp_int_t count = args[1].u_int;
+    mp_int_t length = args[2].u_int;
+    mp_int_t timeout = args[3].u_int;
+    if (count < 0 || length < 0 || length > radio_state.max_payload || timeout < 0) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "value out of range"));
+    }
+    if (radio_state.max_payload < RADIO_BENCH_HEADER_LEN) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "length too short for benchmark"));
+    }
+
+    radio_bench_result_t result;
+    switch (args[0].u_int) {
+        case RADIO_BENCH_FLOOD:
+            radio_bench_flood(count, length, &result, radio_bench_poll);
+            break;
+        case RADIO_BENCH_SINK:
+            radio_bench_sink(timeout, &result, radio_bench_poll);
+            break;
+        case RADIO_BENCH_PING:
+            radio_bench_ping(count, length, timeout, &result, radio_bench_poll);
+            break;
+        case RADIO_BENCH_ECHO:
+            radio_bench_echo(timeout, &result, radio_bench_poll);
+            break;
+        default:
+            nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "invalid mode"));
+    }
+
+    mp_obj_t dict = mp_obj_new_dict(6);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_packets), mp_obj_new_int_from_uint(result.packets));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_received), mp_obj_new_int_from_uint(result.received));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_lost), mp_obj_new_int_from_uint(result.lost));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_time), mp_obj_new_int_from_uint(result.time_ms));
+    // packets per second and the mean round trip time in microseconds
+    uint32_t time_ms = result.time_ms == 0 ? 1 : result.time_ms;
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_pps), mp_obj_new_int_from_uint((uint64_t)result.packets * 1000 / time_ms));
+    if (args[0].u_int == RADIO_BENCH_PING) {
+        uint32_t replies = result.received == 0 ? 1 : result.received;
+        mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_latency), mp_obj_new_int_from_uint((uint64_t)result.rtt_ms * 1000 / replies));
+    }
+    return dict;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(mod_radio_benchmark_obj, 1, mod_radio_benchmark);
+
+STATIC mp_obj_t mod_radio_receive_full(void) {
+    return radio_receive_full();
+}
+MP_DEFINE_CONST_FUN_OBJ_0(mod_radio_receive_full_obj, mod_radio_receive_full);
+
 STATIC const mp_map_elem_t radio_module_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_radio) },
     { MP_OBJ_NEW_QSTR(MP_QSTR___init__), (mp_obj_t)&mod_radio_reset_obj },
@@ -473,10 +566,24 @@ STATIC const mp_map_elem_t radio_module_globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_send), (mp_obj_t)&mod_radio_send_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_receive), (mp_obj_t)&mod_radio_receive_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_receive_bytes_into), (mp_obj_t)&mod_radio_receive_bytes_into_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_receive_full), (mp_obj_t)&mod_radio_receive_full_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_receive_many), (mp_obj_t)&mod_radio_receive_many_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_send_large), (mp_obj_t)&mod_radio_send_large_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_receive_large), (mp_obj_t)&mod_radio_receive_large_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_send_reliable), (mp_obj_t)&mod_radio_send_reliable_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_node_id), (mp_obj_t)&mod_radio_node_id_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_synced), (mp_obj_t)&mod_radio_synced_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_stats), (mp_obj_t)&mod_radio_stats_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_benchmark), (mp_obj_t)&mod_radio_benchmark_obj },
 
     { MP_OBJ_NEW_QSTR(MP_QSTR_RATE_250KBIT), MP_OBJ_NEW_SMALL_INT(RADIO_MODE_MODE_Nrf_250Kbit) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_RATE_1MBIT), MP_OBJ_NEW_SMALL_INT(RADIO_MODE_MODE_Nrf_1Mbit) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_RATE_2MBIT), MP_OBJ_NEW_SMALL_INT(RADIO_MODE_MODE_Nrf_2Mbit) },
+
+    { MP_OBJ_NEW_QSTR(MP_QSTR_FLOOD), MP_OBJ_NEW_SMALL_INT(RADIO_BENCH_FLOOD) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_SINK), MP_OBJ_NEW_SMALL_INT(RADIO_BENCH_SINK) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_PING), MP_OBJ_NEW_SMALL_INT(RADIO_BENCH_PING) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_ECHO), MP_OBJ_NEW_SMALL_INT(RADIO_BENCH_ECHO) },
 };
 
 STATIC MP_DEFINE_CONST_DICT(radio_module_globals, radio_module_globals_table);
@@ -24,72 +24,115 @@
  * THE SOFTWARE.
  */
 #include<stdio.h>
+#include <string.h>
 
 #include "py/obj.h"
 #include "filesystem.h"
 #include "py/objtuple.h"
 #include "py/objstr.h"
+#include "py/stream.h"
 #include "microbit/modaudio.h"
 #include "lib/sam/render.h"
 #include "lib/sam/reciter.h"
 #include "lib/sam/sam.h"
 
-/** Called by SAM to output byte `b` at `pos` */
+/* Rendered samples are written into a ring of SPEECH_FRAMES AudioFrames.
+ * Rendering is done a step at a time by the iterator, which audio calls from
+ * the low priority callback, so that the ring stays nearly full.
+ * Sample positions (`pos`) are absolute, counted from the start of the utterance. */
+
+#define LOG_SPEECH_FRAMES 3
+#define SPEECH_FRAMES (1<<LOG_SPEECH_FRAMES)
+#define SPEECH_BUFFER_SIZE (SPEECH_FRAMES*AUDIO_CHUNK_SIZE)
+
+/* The most that the last sample written can move on in one SAMRender() step,
+ * allowing for rounding and the samples written in advance. */
+#define RENDER_STEP (SCALE_RATE(SAM_RENDER_STEP_MAX)+5)
 
-static microbit_audio_frame_obj_t *buf;
+typedef struct _speech_iterator_t {
+    mp_obj_base_t base;
+    sam_memory *sam;
+    microbit_audio_frame_obj_t *frames[SPEECH_FRAMES];
+    microbit_audio_frame_obj_t *empty;
+    /* True if the frame at buf_start_pos has been handed to the audio module. */
+    bool played;
+} speech_iterator_t;
+
+static speech_iterator_t *speech_iter;
+/* Position of the first sample that has not yet been played. Only advanced by the iterator. */
 static volatile unsigned int buf_start_pos = 0;
 static volatile unsigned int last_pos = 0;
-volatile bool rendering = false;
-volatile bool last_frame = false;
-volatile bool exhausted = false;
+static volatile bool finished = false;
 static unsigned int glitches;
+static unsigned int underruns;
+
+/* When not NULL, samples are written into this buffer of render_size bytes,
+ * for render(), instead of the ring. */
+static uint8_t *render_buf;
+static unsigned int render_size;
 
+/** Called by SAM to output byte `b` at `pos` */
 void SamOutputByte(unsigned int pos, unsigned char b) {
-    //printf("%d, %d, %d\r\n", pos, SCALE_RATE(pos), b);
     unsigned int actual_pos = SCALE_RATE(pos);
-    if (buf_start_pos > actual_pos) {
-        glitches++;
-        buf_start_pos -= 32;
-    }
-    while ((actual_pos & (-32)) > buf_start_pos) {
-        // We have filled buffer
-        rendering = true;
-        /* XXX - Busy wait */
+    uint8_t *data;
+    unsigned int offset, size;
+    if (render_buf != NULL) {
+        if (actual_pos >= render_size) {
+            glitches++;
+            return;
+        }
+        data = render_buf;
+        offset = actual_pos;
+        size = render_size;
+    } else {
+        if (actual_pos < buf_start_pos || actual_pos >= buf_start_pos + SPEECH_BUFFER_SIZE) {
+            // Too late, that frame has already been played, or (which render_ahead()
+            // prevents) too early for the ring.
+            glitches++;
+            return;
+        }
+        data = speech_iter->frames[(actual_pos>>LOG_AUDIO_CHUNK_SIZE)&(SPEECH_FRAMES-1)]->data;
+        offset = actual_pos & (AUDIO_CHUNK_SIZE-1);
+        size = AUDIO_CHUNK_SIZE;
     }
-    unsigned int offset = actual_pos & 31;
     // write a little bit in advance
-    unsigned int end = min(offset+4, 32);
+    unsigned int end = min(offset+4, size);
     while (offset < end) {
-        buf->data[offset] = b;
+        data[offset] = b;
         offset++;
     }
     last_pos = actual_pos;
-    return;
 }
 
-typedef struct _speech_iterator_t {
-    mp_obj_base_t base;
-    microbit_audio_frame_obj_t *buf;
-    microbit_audio_frame_obj_t *empty;
-} speech_iterator_t;
+/* Render until the ring is as full as it can be without a step overrunning it. */
+static void render_ahead(speech_iterator_t *self) {
+    while (!finished && last_pos + RENDER_STEP < buf_start_pos + SPEECH_BUFFER_SIZE) {
+        if (!SAMRender(self->sam)) {
+            finished = true;
+        }
+    }
+}
 
-/** This iterator assumes that the speech renderer can generate samples
- * at least as fast as we can consume them */
 static mp_obj_t next(mp_obj_t iter) {
-    if (exhausted) {
-        return MP_OBJ_STOP_ITERATION;
-    }
-    if (last_frame) {
-        exhausted = true;
-        last_frame = false;
+    speech_iterator_t *self = (speech_iterator_t *)iter;
+    if (self->played) {
+        // Audio has copied the frame, so it can be reused.
+        memset(self->frames[(buf_start_pos>>LOG_AUDIO_CHUNK_SIZE)&(SPEECH_FRAMES-1)]->data, 128, AUDIO_CHUNK_SIZE);
+        buf_start_pos += AUDIO_CHUNK_SIZE;
+        self->played = false;
     }
-    // May need to wait for reciter to do its job before renderer generate samples.
-    if (rendering) {
-        buf_start_pos += 32;
-        return buf;
-    } else {
-        return ((speech_iterator_t *)iter)->empty;
+    render_ahead(self);
+    if (finished) {
+        if (buf_start_pos > last_pos) {
+            return MP_OBJ_STOP_ITERATION;
+        }
+    } else if (last_pos < buf_start_pos + AUDIO_CHUNK_SIZE - 1) {
+        // Frame is not complete yet.
+        underruns++;
+        return self->empty;
     }
+    self->played = true;
+    return self->frames[(buf_start_pos>>LOG_AUDIO_CHUNK_SIZE)&(SPEECH_FRAMES-1)];
 }
 
 const mp_obj_type_t speech_iterator_type = {
@@ -110,14 +153,180 @@ const mp_obj_type_t speech_iterator_type = {
     .locals_dict = NULL,
 };
 
-static mp_obj_t make_speech_iter(void) {
+static speech_iterator_t *make_speech_iter(sam_memory *sam) {
     speech_iterator_t *result = m_new_obj(speech_iterator_t);
     result->base.type = &speech_iterator_type;
+    result->sam = sam;
     result->empty = new_microbit_audio_frame();
-    result->buf = new_microbit_audio_frame();
+    for (int i = 0; i < SPEECH_FRAMES; i++) {
+        result->frames[i] = new_microbit_audio_frame();
+    }
+    result->played = false;
     return result;
 }
 
+/* Plays a buffer of pre-rendered samples, reusing a single frame. */
+typedef struct _speech_buffer_iterator_t {
+    mp_obj_base_t base;
+    mp_obj_t buffer;
+    mp_uint_t offset;
+    microbit_audio_frame_obj_t *frame;
+} speech_buffer_iterator_t;
+
+static mp_obj_t buffer_next(mp_obj_t iter) {
+    speech_buffer_iterator_t *self = (speech_buffer_iterator_t *)iter;
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(self->buffer, &bufinfo, MP_BUFFER_READ);
+    if (self->offset >= bufinfo.len) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    mp_uint_t len = min(bufinfo.len - self->offset, AUDIO_CHUNK_SIZE);
+    memcpy(self->frame->data, ((uint8_t *)bufinfo.buf) + self->offset, len);
+    memset(self->frame->data + len, 128, AUDIO_CHUNK_SIZE - len);
+    self->offset += len;
+    return self->frame;
+}
+
+const mp_obj_type_t speech_buffer_iterator_type = {
+    { &mp_type_type },
+    .name = MP_QSTR_iterator,
+    .print = NULL,
+    .make_new = NULL,
+    .call = NULL,
+    .unary_op = NULL,
+    .binary_op = NULL,
+    .attr = NULL,
+    .subscr = NULL,
+    .getiter = mp_identity,
+    .iternext = buffer_next,
+    .buffer_p = {NULL},
+    .stream_p = NULL,
+    .bases_tuple = NULL,
+    .locals_dict = NULL,
+};
+
+static void play_buffer(mp_obj_t buffer, bool wait) {
+    speech_buffer_iterator_t *src = m_new_obj(speech_buffer_iterator_t);
+    src->base.type = &speech_buffer_iterator_type;
+    src->buffer = buffer;
+    src->offset = 0;
+    src->frame = new_microbit_audio_frame();
+    audio_play_source(src, mp_const_none, mp_const_none, wait);
+}
+
+/* Cache of text to phoneme translations, so that repeated phrases skip the reciter.
+ * Entries are packed into `data`, most recently used first. Each entry is a key made
+ * from the text, the length of the phonemes and then the phonemes themselves.
+ * The key is two different 32 bit hashes of the text and its length, so two texts
+ * would have to collide in both hashes to be mistaken for each other. */
+
+#define DEFAULT_CACHE_SIZE 256
+#define CACHE_KEY_SIZE 9
+#define CACHE_ENTRY_HEADER (CACHE_KEY_SIZE+1)
+#define CACHE_FILE_HEADER 4
+#define CACHE_FILE_FORMAT 1
+
+typedef struct _speech_cache_t {
+    uint16_t size;
+    uint16_t used;
+    uint8_t data[];
+} speech_cache_t;
+
+/* NULL until the cache is first used, when one of the default size is made.
+ * Cleared on soft reboot, which also restores the default size. */
+#define speech_cache MP_STATE_PORT(speech_cache)
+
+static void cache_key(const char *txt, mp_uint_t len, uint8_t *key) {
+    // FNV-1a and Jenkins' one-at-a-time
+    uint32_t fnv = 2166136261u;
+    uint32_t oaat = 0;
+    for (mp_uint_t i = 0; i < len; i++) {
+        fnv = (fnv ^ (uint8_t)txt[i]) * 16777619u;
+        oaat += (uint8_t)txt[i];
+        oaat += oaat << 10;
+        oaat ^= oaat >> 6;
+    }
+    oaat += oaat << 3;
+    oaat ^= oaat >> 11;
+    oaat += oaat << 15;
+    for (int i = 0; i < 4; i++) {
+        key[i] = fnv >> (i*8);
+        key[i+4] = oaat >> (i*8);
+    }
+    key[8] = len;
+}
+
+static inline unsigned int cache_entry_size(const uint8_t *entry) {
+    return CACHE_ENTRY_HEADER + entry[CACHE_KEY_SIZE];
+}
+
+static void reverse(uint8_t *start, uint8_t *end) {
+    while (start < --end) {
+        uint8_t tmp = *start;
+        *start++ = *end;
+        *end = tmp;
+    }
+}
+
+/* Move the `len` bytes at `start+offset` to `start`, shifting the bytes before them up. */
+static void rotate_to_front(uint8_t *start, unsigned int offset, unsigned int len) {
+    reverse(start, start+offset+len);
+    reverse(start, start+len);
+    reverse(start+len, start+offset+len);
+}
+
+static const uint8_t *cache_lookup(const uint8_t *key, mp_uint_t *len) {
+    if (speech_cache == NULL) {
+        return NULL;
+    }
+    unsigned int offset = 0;
+    while (offset < speech_cache->used) {
+        uint8_t *entry = speech_cache->data + offset;
+        unsigned int entry_size = cache_entry_size(entry);
+        if (memcmp(entry, key, CACHE_KEY_SIZE) == 0) {
+            rotate_to_front(speech_cache->data, offset, entry_size);
+            *len = speech_cache->data[CACHE_KEY_SIZE];
+            return speech_cache->data + CACHE_ENTRY_HEADER;
+        }
+        offset += entry_size;
+    }
+    return NULL;
+}
+
+static speech_cache_t *cache_new(unsigned int size) {
+    speech_cache_t *cache = (speech_cache_t *)m_malloc_maybe(sizeof(speech_cache_t) + size);
+    if (cache != NULL) {
+        cache->size = size;
+        cache->used = 0;
+    }
+    return cache;
+}
+
+static speech_cache_t *cache_alloc(void) {
+    if (speech_cache == NULL) {
+        speech_cache = cache_new(DEFAULT_CACHE_SIZE);
+    }
+    return speech_cache;
+}
+
+static void cache_insert(const uint8_t *key, const uint8_t *phonemes, mp_uint_t len) {
+    speech_cache_t *cache = cache_alloc();
+    unsigned int entry_size = CACHE_ENTRY_HEADER + len;
+    if (cache == NULL || entry_size > cache->size) {
+        return;
+    }
+    // Evict least recently used entries from the end.
+    unsigned int keep = 0;
+    while (keep < cache->used && keep + cache_entry_size(cache->data + keep) + entry_size <= cache->size) {
+        keep += cache_entry_size(cache->data + keep);
+    }
+    memmove(cache->data + entry_size, cache->data, keep);
+    memcpy(cache->data, key, CACHE_KEY_SIZE);
+    cache->data[CACHE_KEY_SIZE] = len;
+    memcpy(cache->data + CACHE_ENTRY_HEADER, phonemes, len);
+    cache->used = keep + entry_size;
+}
+
 static mp_obj_t translate(mp_obj_t words) {
     mp_uint_t len, outlen;
     const char *txt = mp_obj_str_get_data(words, &len);
@@ -126,6 +335,12 @@ static mp_obj_t translate(mp_obj_t words) {
     if (len > 80) {
         nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "text too long."));
     }
+    uint8_t key[CACHE_KEY_SIZE];
+    cache_key(txt, len, key);
+    const uint8_t *cached = cache_lookup(key, &outlen);
+    if (cached != NULL) {
+        return mp_obj_new_str_of_type(&mp_type_str, cached, outlen);
+    }
     reciter_memory *mem = m_new(reciter_memory, 1);
     MP_STATE_PORT(speech_data) = mem;
     for (mp_uint_t i = 0; i < len; i++) {
@@ -142,13 +357,114 @@ static mp_obj_t translate(mp_obj_t words) {
         }
     }
     mp_obj_t res = mp_obj_new_str_of_type(&mp_type_str, (byte *)mem->input, outlen);
+    cache_insert(key, (byte *)mem->input, outlen);
     // Prevent input becoming invisible to GC due to tail-call optimisation.
     MP_STATE_PORT(speech_data) = NULL;
     return res;
 }MP_DEFINE_CONST_FUN_OBJ_1(translate_obj, translate);
 
+static mp_obj_t cache(mp_obj_t size_in) {
+    mp_int_t size = mp_obj_get_int(size_in);
+    if (size < 0 || size > 0xffff) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, "value out of range"));
+    }
+    speech_cache = NULL;
+    speech_cache_t *cache = cache_new(size);
+    if (cache == NULL) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError, "not enough memory for cache"));
+    }
+    speech_cache = cache;
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(cache_obj, cache);
+
+/* The cache file is the used length (16 bits, little endian), the format of the
+ * entries, a reserved byte, then the entries. */
+static mp_obj_t save_cache(mp_obj_t filename) {
+    mp_uint_t name_len;
+    const char *name = mp_obj_str_get_data(filename, &name_len);
+    file_descriptor_obj *fd = microbit_file_open(name, name_len, true, true);
+    if (fd == NULL) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "could not open file"));
+    }
+    uint16_t used = speech_cache == NULL ? 0 : speech_cache->used;
+    uint8_t header[CACHE_FILE_HEADER] = { used & 255, used >> 8, CACHE_FILE_FORMAT, 0 };
+    int errcode;
+    mp_uint_t written = microbit_file_write(fd, header, CACHE_FILE_HEADER, &errcode);
+    if (written != MP_STREAM_ERROR && used) {
+        written = microbit_file_write(fd, speech_cache->data, used, &errcode);
+    }
+    microbit_file_close(fd);
+    if (written == MP_STREAM_ERROR) {
+        // The filesystem is probably full.
+        nlr_raise(mp_obj_new_exception_arg1(&mp_type_OSError, MP_OBJ_NEW_SMALL_INT(errcode)));
+    }
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(save_cache_obj, save_cache);
+
+static mp_obj_t load_cache(mp_obj_t filename) {
+    mp_uint_t name_len;
+    const char *name = mp_obj_str_get_data(filename, &name_len);
+    file_descriptor_obj *fd = microbit_file_open(name, name_len, false, true);
+    if (fd == NULL) {
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_OSError, "file not found"));
+    }
+    speech_cache_t *cache = cache_alloc();
+    int errcode;
+    uint8_t header[CACHE_FILE_HEADER];
+    if (cache == NULL) {
+        microbit_file_close(fd);
+        return mp_const_none;
+    }
+    cache->used = 0;
+    if (microbit_file_read(fd, header, CACHE_FILE_HEADER, &errcode) != CACHE_FILE_HEADER ||
+        header[2] != CACHE_FILE_FORMAT) {
+        microbit_file_close(fd);
+        return mp_const_none;
+    }
+    unsigned int used = header[0] | (header[1] << 8);
+    unsigned int len = microbit_file_read(fd, cache->data, min(used, cache->size), &errcode);
+    microbit_file_close(fd);
+    if (len == MP_STREAM_ERROR) {
+        len = 0;
+    }
+    // Keep only whole entries, in case the cache is now smaller than when it was saved.
+    unsigned int keep = 0;
+    while (keep + CACHE_ENTRY_HEADER <= len && keep + cache_entry_size(cache->data + keep) <= len) {
+        keep += cache_entry_size(cache->data + keep);
+    }
+    cache->used = keep;
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_1(load_cache_obj, load_cache);
+
 extern int debug;
 
+/* Make the SAM state for `phonemes` and prepare it for rendering.  The state
+ * is kept in MP_STATE_PORT(speech_data), which the caller must clear. */
+static sam_memory *sam_prepare(mp_obj_t phonemes, bool sing, const mp_arg_val_t *voice) {
+    sam_memory *sam = m_new(sam_memory, 1);
+    MP_STATE_PORT(speech_data) = sam;
+
+    // set the current saved speech state
+    sam->common.singmode = sing;
+    sam->common.pitch  = voice[0].u_int;
+    sam->common.speed  = voice[1].u_int;
+    sam->common.mouth  = voice[2].u_int;
+    sam->common.throat = voice[3].u_int;
+
+    mp_uint_t len;
+    const char *input = mp_obj_str_get_data(phonemes, &len);
+    SetInput(sam, input, len);
+    if (!SAMPrepare(sam))
+    {
+        MP_STATE_PORT(speech_data) = NULL;
+        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, sam_error));
+    }
+    return sam;
+}
+
 static mp_obj_t articulate(mp_obj_t phonemes, mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, bool sing) {
 
     static const mp_arg_t allowed_args[] = {
@@ -157,48 +473,45 @@ static mp_obj_t articulate(mp_obj_t phonemes, mp_uint_t n_args, const mp_obj_t *
         { MP_QSTR_mouth,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = DEFAULT_MOUTH} },
         { MP_QSTR_throat,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = DEFAULT_THROAT} },
         { MP_QSTR_debug,   MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+        { MP_QSTR_wait,    MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = true} },
     };
 
     // parse args
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    sam_memory *sam = m_new(sam_memory, 1);
-    MP_STATE_PORT(speech_data) = sam;
-
-    // set the current saved speech state
-    sam->common.singmode = sing;
-    sam->common.pitch  = args[0].u_int;
-    sam->common.speed  = args[1].u_int;
-    sam->common.mouth  = args[2].u_int;
-    sam->common.throat = args[3].u_int;
     debug = args[4].u_bool;
+    bool wait = args[5].u_bool;
 
-    mp_uint_t len;
-    const char *input = mp_obj_str_get_data(phonemes, &len);
-    buf_start_pos = 0;
-    speech_iterator_t *src = make_speech_iter();
-    buf = src->buf;
-    /* We need to wait for reciter to do its job */
-    rendering = false;
-    exhausted = false;
-    glitches = 0;
-    audio_play_source(src, mp_const_none, mp_const_none, false);
-
-    SetInput(sam, input, len);
-    if (!SAMMain(sam))
-    {
+    // The renderer's state is shared, so any speech still playing must stop.
+    if (microbit_audio_is_playing()) {
         audio_stop();
-        MP_STATE_PORT(speech_data) = NULL;
-        nlr_raise(mp_obj_new_exception_msg(&mp_type_ValueError, sam_error));
     }
+    sam_memory *sam = sam_prepare(phonemes, sing, args);
+    speech_iterator_t *iter = make_speech_iter(sam);
+    MP_STATE_PORT(speech_data) = NULL;
 
-    last_frame = true;
+    speech_iter = iter;
+    buf_start_pos = 0;
+    last_pos = 0;
+    finished = false;
+    glitches = 0;
+    underruns = 0;
+    // Fill the ring before playing starts; the iterator renders the rest.
+    render_ahead(iter);
+    audio_play_source(iter, mp_const_none, mp_const_none, false);
+    if (!wait) {
+        return mp_const_none;
+    }
     /* Wait for audio finish before returning */
-    while (microbit_audio_is_playing());
-    MP_STATE_PORT(speech_data) = NULL;
+    while (microbit_audio_is_playing()) {
+        if (MP_STATE_VM(mp_pending_exception) != MP_OBJ_NULL) {
+            return mp_const_none;
+        }
+        __WFE();
+    }
     if (debug) {
-        printf("Glitches: %d\r\n", glitches);
+        printf("Glitches: %d, underruns: %d\r\n", glitches, underruns);
     }
     return mp_const_none;
 }
@@ -219,12 +532,91 @@ static mp_obj_t sing(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_ar
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(sing_obj, 1, sing);
 
+/* Render what say() would speak into a bytearray, for play().  The buffer
+ * grows as SAM renders, always leaving room for a whole step. */
+static mp_obj_t render(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_pitch,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = DEFAULT_PITCH} },
+        { MP_QSTR_speed,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = DEFAULT_SPEED} },
+        { MP_QSTR_mouth,    MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = DEFAULT_MOUTH} },
+        { MP_QSTR_throat,   MP_ARG_KW_ONLY | MP_ARG_INT, {.u_int = DEFAULT_THROAT} },
+    };
+    mp_obj_t phonemes = translate(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args-1, pos_args+1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // The renderer's state is shared, so any speech still playing must stop.
+    if (microbit_audio_is_playing()) {
+        audio_stop();
+    }
+    sam_memory *sam = sam_prepare(phonemes, false, args);
+    unsigned int size = SPEECH_BUFFER_SIZE;
+    uint8_t *buf = m_new(uint8_t, size);
+    memset(buf, 128, size);
+    render_buf = buf;
+    render_size = size;
+    last_pos = 0;
+    glitches = 0;
+    bool more = true;
+    while (more) {
+        if (last_pos + RENDER_STEP >= size) {
+            render_buf = NULL;
+            uint8_t *bigger = m_renew_maybe(uint8_t, buf, size, size*2, true);
+            if (bigger == NULL) {
+                MP_STATE_PORT(speech_data) = NULL;
+                nlr_raise(mp_obj_new_exception_msg(&mp_type_MemoryError, "not enough memory for speech"));
+            }
+            buf = bigger;
+            memset(buf + size, 128, size);
+            size *= 2;
+            render_buf = buf;
+            render_size = size;
+        }
+        more = SAMRender(sam);
+    }
+    render_buf = NULL;
+    MP_STATE_PORT(speech_data) = NULL;
+    unsigned int len = last_pos + 1;
+    buf = m_renew(uint8_t, buf, size, len);
+    return mp_obj_new_bytearray_by_ref(len, buf);
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(render_obj, 1, render);
+
+static mp_obj_t play(mp_uint_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_samples, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_wait,  MP_ARG_BOOL, {.u_bool = true} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0].u_obj, &bufinfo, MP_BUFFER_READ);
+    play_buffer(args[0].u_obj, args[1].u_bool);
+    return mp_const_none;
+}
+MP_DEFINE_CONST_FUN_OBJ_KW(play_obj, 1, play);
+
+static mp_obj_t stats(void) {
+    mp_obj_t tuple[2] = {
+        MP_OBJ_NEW_SMALL_INT(glitches),
+        MP_OBJ_NEW_SMALL_INT(underruns),
+    };
+    return mp_obj_new_tuple(2, tuple);
+}
+MP_DEFINE_CONST_FUN_OBJ_0(stats_obj, stats);
+
 static const mp_map_elem_t _globals_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR_speech) },
     { MP_OBJ_NEW_QSTR(MP_QSTR_say), (mp_obj_t)&say_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_sing), (mp_obj_t)&sing_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_pronounce), (mp_obj_t)&pronounce_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_translate), (mp_obj_t)&translate_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_render), (mp_obj_t)&render_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_play), (mp_obj_t)&play_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_stats), (mp_obj_t)&stats_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_cache), (mp_obj_t)&cache_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_save_cache), (mp_obj_t)&save_cache_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_load_cache), (mp_obj_t)&load_cache_obj },
 };
 static MP_DEFINE_CONST_DICT(_globals, _globals_table);
 
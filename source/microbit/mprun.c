@@ -10,6 +10,9 @@
 #include "py/gc.h"
 #include "py/mphal.h"
 #include "lib/readline.h"
+#include "lib/edges.h"
+#include "lib/adcstream.h"
+#include "lib/radio.h"
 #include "lib/utils/pyexec.h"
 #include "filesystem.h"
 #include "memory.h"
@@ -98,6 +101,22 @@ void mp_run(void) {
     mp_stack_ctrl_init();
     mp_stack_set_limit(1800); // stack is 2k
 
+    // the ticker must not write to buffers left on the old heap
+    MP_STATE_PORT(accelerometer_sampler) = NULL;
+    MP_STATE_PORT(accelerometer_motion) = NULL;
+    MP_STATE_PORT(compass_calibration_data) = NULL;
+    MP_STATE_PORT(compass_fit) = NULL;
+    MP_STATE_PORT(orientation) = NULL;
+    edges_stop_all();
+    adcstream_stop();
+    MP_STATE_PORT(pin_edges)[0] = NULL;
+    MP_STATE_PORT(pin_edges)[1] = NULL;
+    if (MP_STATE_PORT(radio_buf) != NULL) {
+        // stop the radio IRQ and TDMA ticks using its queues
+        radio_deinit();
+        MP_STATE_PORT(radio_buf) = NULL;
+    }
+
     // allocate the uPy heap statically in the available RAM between heap and stack
     extern uint32_t __HeapLimit;
     extern uint32_t __StackLimit;
@@ -141,6 +160,7 @@ void mp_run(void) {
 
     memset(&MP_STATE_PORT(async_data)[0], 0, sizeof(MP_STATE_PORT(async_data)));
     MP_STATE_PORT(music_data) = NULL;
+    MP_STATE_PORT(speech_cache) = NULL;
 
     mp_deinit();
 }
@@ -0,0 +1,101 @@
+#This tests counting and timing edges. Connect pin0 to pin1 with a wire first.
+
+from microbit import *
+from array import array
+
+def pins_connected(p0, p1):
+    for i in 0,1,0,1,0,1,0,1:
+        p0.write_digital(i)
+        if p1.read_digital() != i:
+            return False
+    return True
+
+handled = 0
+
+def handler(pin):
+    global handled
+    handled += 1
+
+def pulses(p, n):
+    for i in range(n):
+        p.write_digital(1)
+        sleep(2)
+        p.write_digital(0)
+        sleep(2)
+
+def test_counting(p0, p1):
+    print("Counting edges")
+    global handled
+    p0.write_digital(0)
+    for edges, count in (p1.RISING, 10), (p1.FALLING, 10), (p1.BOTH, 20):
+        handled = 0
+        p1.start_counting(edges, handler=handler)
+        pulses(p0, 10)
+        sleep(10)
+        assert p1.edge_count() == count
+        assert 1 <= handled <= count
+        # The pin can still be read while counting.
+        assert p1.read_digital() == 0
+        p1.stop_counting()
+    # Only one pin can count both edges.
+    p1.start_counting(p1.BOTH)
+    try:
+        pin2.start_counting(pin2.BOTH)
+        assert False, "two pins counting both edges"
+    except ValueError:
+        pass
+    p1.stop_counting()
+
+def test_read_edges(p0, p1):
+    print("Reading edge times")
+    p0.write_digital(0)
+    p1.start_counting(p1.RISING, 8)
+    pulses(p0, 10)
+    times = array('i', [0] * 10)
+    # Only the first 8 times were kept, but all the edges were counted.
+    assert p1.read_edges(times) == 8
+    assert p1.edge_count() == 10
+    for i in range(1, 8):
+        # Rising edges have the level bit set.
+        assert times[i] & 0x20000000
+        gap = (times[i] - times[i - 1]) & 0x1fffffff
+        assert 3500 < gap < 6000, gap
+    assert p1.read_edges(times) == 0
+    p1.stop_counting()
+    # Counting both edges, the levels alternate.
+    p1.start_counting(p1.BOTH, 4)
+    pulses(p0, 2)
+    assert p1.read_edges(times) == 4
+    for i in range(4):
+        assert bool(times[i] & 0x20000000) == (i % 2 == 0)
+    p1.stop_counting()
+
+def test_timing(p0, p1):
+    print("Timing a PWM signal")
+    p0.set_analog_period_microseconds(1000)
+    p0.write_analog(256)
+    high = p1.time_pulse_us(1)
+    assert 230 < high < 270, high
+    low = p1.time_pulse_us(0)
+    assert 730 < low < 770, low
+    period, duty = p1.time_period_us()
+    assert 980 < period < 1020, period
+    assert 236 < duty < 276, duty
+    p0.write_digital(0)
+    # Nothing changes now, so both time out.
+    assert p1.time_pulse_us(1, 10000) == -2
+    assert p1.time_period_us(10000) is None
+
+try:
+    if pins_connected(pin0, pin1):
+        test_counting(pin0, pin1)
+        test_read_edges(pin0, pin1)
+        test_timing(pin0, pin1)
+        print("Edges test: PASS")
+        display.show(Image.HAPPY)
+    else:
+        print("Connect pin0 to pin1")
+        display.show("?")
+except Exception as ae:
+    display.show(Image.SAD)
+    raise
@@ -27,6 +27,48 @@ def test_repeated_set_tempo():
     for i in range(20):
         music.set_tempo(ticks=i%4+1, bpm=i+100)
 
+def test_compile():
+    tune = music.compile(['c4:4', 'e', None, 'g', 'c5:8'])
+    assert len(tune) == 5
+    assert len(music.compile('c4')) == 1
+    assert len(music.compile(music.NYAN)) == len(music.NYAN)
+    try:
+        music.compile(['c4', ''])
+        assert False, "empty note compiled"
+    except ValueError:
+        pass
+    for i in range(20):
+        music.play(tune, wait=False)
+    music.play(tune, loop=True, wait=False)
+    music.stop()
+
+def test_synth():
+    music.reset()
+    # 4 ticks of 125ms is a little over 122 frames of 4.096ms.
+    synth = music.Synth(['c4:4'], music.compile(['e4:2', 'g4:2']))
+    count = 0
+    for frame in synth:
+        count += 1
+    assert 122 <= count <= 124
+    # Each time a Synth is iterated, it starts again.
+    assert len([frame for frame in synth]) == count
+    # Silent voices sit in the middle of the range.
+    synth.set_voice(0, volume=0)
+    synth.set_voice(1, waveform=music.SINE, volume=0)
+    for frame in synth:
+        for i in range(len(frame)):
+            assert frame[i] == 128
+    for bad in {'voice': 2}, {'voice': 0, 'waveform': 4}, {'voice': 0, 'volume': 256}:
+        try:
+            synth.set_voice(**bad)
+            assert False, "set_voice(%s) accepted" % bad
+        except (IndexError, ValueError):
+            pass
+    looped = music.Synth('c4:1', loop=True)
+    frames = iter(looped)
+    for i in range(100):
+        next(frames)
+
 def test_all_pins_free():
     for pin in PINS:
         pin.read_digital()
@@ -38,6 +80,8 @@ try:
     test_repeated_stop()
     test_repeated_reset()
     test_repeated_set_tempo()
+    test_compile()
+    test_synth()
     test_all_pins_free()
     print("File test: PASS")
     display.show(Image.HAPPY)
@@ -0,0 +1,80 @@
+#This tests the bulk operations on a NeoPixel strip. No strip needs to be connected.
+
+from microbit import display, Image, pin0
+import neopixel
+
+LEN = 8
+RED = (255, 0, 0)
+GREEN = (0, 255, 0)
+BLUE = (0, 0, 255)
+OFF = (0, 0, 0)
+
+np = neopixel.NeoPixel(pin0, LEN)
+
+def colours():
+    return [np[i] for i in range(LEN)]
+
+def test_fill():
+    np.fill(RED)
+    assert colours() == [RED] * LEN
+    np.clear()
+    assert colours() == [OFF] * LEN
+
+def test_slices():
+    np.clear()
+    np[2:5] = [RED, GREEN, BLUE]
+    assert colours() == [OFF, OFF, RED, GREEN, BLUE, OFF, OFF, OFF]
+    np[-2:] = [GREEN, GREEN]
+    assert np[6] == GREEN and np[7] == GREEN
+    try:
+        np[0:3] = [RED]
+        assert False, "wrong number of colours accepted"
+    except ValueError:
+        pass
+
+def test_buffer():
+    np.clear()
+    np[0] = (1, 2, 3)
+    saved = bytearray(np)
+    assert len(saved) == LEN * 3
+    # Stored in green, red, blue order.
+    assert saved[0:3] == bytearray((2, 1, 3))
+    np.fill(BLUE)
+    np[:] = saved
+    assert np[0] == (1, 2, 3)
+    assert np[1] == OFF
+    np[1:2] = bytes((255, 0, 0))
+    assert np[1] == GREEN
+    try:
+        np[0:2] = bytes(3)
+        assert False, "short buffer accepted"
+    except ValueError:
+        pass
+
+def test_kernels():
+    np.gradient(OFF, (70, 0, 0))
+    assert [c[0] for c in colours()] == [0, 10, 20, 30, 40, 50, 60, 70]
+    np.rotate()
+    assert np[0] == (70, 0, 0) and np[1] == OFF
+    np.rotate(-1)
+    assert np[0] == OFF and np[7] == (70, 0, 0)
+    np.shift(2)
+    assert np[0] == OFF and np[1] == OFF and np[2] == OFF and np[7] == (50, 0, 0)
+    np.fill((200, 100, 0))
+    np.scale(128)
+    assert np[0] == (100, 50, 0)
+    np.hsv(0, 240, start=0, stop=3)
+    assert np[0] == RED and np[1] == GREEN and np[2] == BLUE
+    assert np[3] == (100, 50, 0)
+
+display.clear()
+try:
+    test_fill()
+    test_slices()
+    test_buffer()
+    test_kernels()
+    print("NeoPixel test: PASS")
+    display.show(Image.HAPPY)
+except Exception as ae:
+    display.show(Image.SAD)
+    raise
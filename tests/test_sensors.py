@@ -0,0 +1,61 @@
+#This tests reading the sensors into buffers. Leave the micro:bit lying still and don't press the buttons.
+
+from microbit import *
+from array import array
+import gc
+
+def close(a, b, error, start=0):
+    for i in range(3):
+        if abs(a[start + i] - b[i]) > error:
+            return False
+    return True
+
+def test_get_values_into():
+    for sensor, error in (accelerometer, 100), (compass, 2000):
+        buf = array('h', [0, 0, 0, 99])
+        assert sensor.get_values(into=buf) is buf
+        assert close(buf, sensor.get_values(), error)
+        # Only the first three elements are written.
+        assert buf[3] == 99
+        try:
+            sensor.get_values(into=array('h', [0, 0]))
+            assert False, "short buffer accepted"
+        except ValueError:
+            pass
+
+def test_no_allocation():
+    buf = array('h', [0, 0, 0])
+    gc.collect()
+    free = gc.mem_free()
+    for i in range(100):
+        accelerometer.get_values(into=buf)
+        compass.get_values(into=buf)
+    assert gc.mem_free() == free
+
+def test_read_sensors():
+    buf = array('h', [0] * 9)
+    assert read_sensors(buf) == 9
+    assert close(buf, accelerometer.get_values(), 100)
+    assert close(buf, compass.get_values(), 2000, 3)
+    assert buf[6] == 0
+    short = array('h', [0] * 4)
+    assert read_sensors(short) == 4
+    # Leave pin0 unconnected, so the pulls decide its level.
+    pin0.read_digital()
+    pin0.set_pull(pin0.PULL_UP)
+    read_sensors(buf)
+    assert buf[7] & 1
+    pin0.set_pull(pin0.PULL_DOWN)
+    read_sensors(buf)
+    assert not buf[7] & 1
+    pin0.set_pull(pin0.NO_PULL)
+
+try:
+    test_get_values_into()
+    test_no_allocation()
+    test_read_sensors()
+    print("Sensor test: PASS")
+    display.show(Image.HAPPY)
+except Exception as ae:
+    display.show(Image.SAD)
+    raise
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+
+'''
+Convert a WAV file (or raw unsigned 8-bit samples) into the 4-bit IMA-ADPCM
+format played by audio.ADPCM on the micro:bit.
+
+Usage: ./adpcmencode.py <sound.wav> [-o <sound.adpcm>]
+       ./adpcmencode.py --raw <sound.raw> [-o <sound.adpcm>]
+
+The output is resampled to the audio module's rate of 7812.5 samples per
+second and is a quarter of the size of the equivalent raw 8-bit samples.
+It can be copied onto the micro:bit filesystem with upload.py.
+'''
+
+import sys
+import struct
+import wave
+import argparse
+
+SAMPLE_RATE = 7812.5
+# 32 samples per AudioFrame, two samples per byte
+BYTES_PER_FRAME = 16
+
+STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+    19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+    130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+    337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+    2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+    5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+]
+
+INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8]
+
+
+def read_wav(filename):
+    '''Return a list of signed 16-bit mono samples and the sample rate.'''
+    with wave.open(filename, 'rb') as wav:
+        channels = wav.getnchannels()
+        width = wav.getsampwidth()
+        rate = wav.getframerate()
+        data = wav.readframes(wav.getnframes())
+    if width == 1:
+        values = [(b - 128) << 8 for b in data]
+    elif width == 2:
+        values = list(struct.unpack('<%dh' % (len(data) // 2), data))
+    else:
+        raise ValueError('only 8 and 16 bit WAV files are supported')
+    # Mix down to mono
+    samples = [sum(values[i:i+channels]) // channels for i in range(0, len(values), channels)]
+    return samples, rate
+
+
+def read_raw(filename):
+    '''Raw files are unsigned 8-bit samples, already at SAMPLE_RATE.'''
+    with open(filename, 'rb') as f:
+        return [(b - 128) << 8 for b in f.read()], SAMPLE_RATE
+
+
+def resample(samples, rate):
+    '''Linear interpolation to SAMPLE_RATE.'''
+    if rate == SAMPLE_RATE or not samples:
+        return samples
+    step = rate / SAMPLE_RATE
+    count = int(len(samples) / step)
+    result = []
+    for i in range(count):
+        pos = i * step
+        index = int(pos)
+        frac = pos - index
+        nxt = samples[min(index + 1, len(samples) - 1)]
+        result.append(int(samples[index] * (1 - frac) + nxt * frac))
+    return result
+
+
+def encode(samples):
+    '''Encode signed 16-bit samples, returning the header and nibble data.
+    The encoder tracks the decoder's reconstruction so the two never drift.'''
+    predictor = samples[0] if samples else 0
+    index = 0
+    header = b'AD' + struct.pack('<hBB', predictor, index, 0)
+    nibbles = []
+    for sample in samples:
+        step = STEP_TABLE[index]
+        diff = sample - predictor
+        nibble = 0
+        if diff < 0:
+            nibble = 8
+            diff = -diff
+        if diff >= step:
+            nibble |= 4
+            diff -= step
+        if diff >= step >> 1:
+            nibble |= 2
+            diff -= step >> 1
+        if diff >= step >> 2:
+            nibble |= 1
+        # Reconstruct exactly as source/lib/adpcm.c does
+        delta = step >> 3
+        if nibble & 4:
+            delta += step
+        if nibble & 2:
+            delta += step >> 1
+        if nibble & 1:
+            delta += step >> 2
+        if nibble & 8:
+            predictor = max(predictor - delta, -32768)
+        else:
+            predictor = min(predictor + delta, 32767)
+        index = min(max(index + INDEX_TABLE[nibble & 7], 0), len(STEP_TABLE) - 1)
+        nibbles.append(nibble)
+    if len(nibbles) & 1:
+        nibbles.append(0)
+    data = bytes(nibbles[i] | (nibbles[i+1] << 4) for i in range(0, len(nibbles), 2))
+    return header + data
+
+
+if __name__ == '__main__':
+    arg_parser = argparse.ArgumentParser(description='Encode audio as IMA-ADPCM for the micro:bit audio module.')
+    arg_parser.add_argument('-o', '--output', default=None, help='output file (default is stdout)')
+    arg_parser.add_argument('--raw', action='store_true', help='input is raw unsigned 8-bit samples at 7812.5Hz')
+    arg_parser.add_argument('input', nargs=1, help='input WAV file')
+    args = arg_parser.parse_args()
+
+    if args.raw:
+        samples, rate = read_raw(args.input[0])
+    else:
+        samples, rate = read_wav(args.input[0])
+    encoded = encode(resample(samples, rate))
+
+    if args.output is None:
+        sys.stdout.buffer.write(encoded)
+    else:
+        with open(args.output, 'wb') as f:
+            f.write(encoded)
@@ -0,0 +1,84 @@
+/*
+ * Host check for the background compass calibration in
+ * source/lib/compassfit.c.
+ *
+ * Samples an axis aligned ellipsoid, offset from the origin, with +/-8
+ * counts of noise: first along a slow spiral, as the board might be turned
+ * by hand, then from random directions. Solves the fit every 200 samples,
+ * as the compass does when it is read, and checks that the final fit finds
+ * the centre within 3 counts and the relative scale of each axis within 2%.
+ * Build and run on the host with:
+ *
+ *   cc -O2 -Iinc tools/compassfitcheck.c source/lib/compassfit.c -lm -o compassfitcheck && ./compassfitcheck
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lib/compassfit.h"
+
+#define SAMPLES 6000
+#define SOLVE_EVERY 200
+
+static const double centre[3] = { -700, 350, 1200 };
+// A raw sample is the centre plus a unit vector times radius / scale.
+static const double radius = 480;
+static const double scale[3] = { 1.15, 0.9, 1.0 };
+
+static double uniform(void) {
+    return rand() / (double)RAND_MAX;
+}
+
+int main(void) {
+    static compass_fit_t fit;
+    compass_fit_result_t result;
+    int fitted = 0;
+    int failures = 0;
+
+    srand(1);
+    compass_fit_init(&fit);
+    for (int i = 0; i < SAMPLES; i++) {
+        double theta, phi;
+        if (i < SAMPLES / 2) {
+            theta = 0.3 + 2.5 * i / (SAMPLES / 2);
+            phi = i * 0.05;
+        } else {
+            theta = acos(2 * uniform() - 1);
+            phi = 2 * M_PI * uniform();
+        }
+        double u[3] = { sin(theta) * cos(phi), sin(theta) * sin(phi), cos(theta) };
+        int p[3];
+        for (int a = 0; a < 3; a++) {
+            p[a] = (int)(centre[a] + u[a] * radius / scale[a] + (uniform() - 0.5) * 16);
+        }
+        compass_fit_add(&fit, p[0], p[1], p[2]);
+        if (i % SOLVE_EVERY == SOLVE_EVERY - 1) {
+            fitted = compass_fit_solve(&fit, &result);
+            if (fitted) {
+                printf("%4d samples: centre (%d, %d, %d), scale (%.3f, %.3f, %.3f), error %u, %u buckets\n",
+                       i + 1, result.centre[0], result.centre[1], result.centre[2],
+                       result.scale[0] / (double)COMPASS_FIT_ONE, result.scale[1] / (double)COMPASS_FIT_ONE,
+                       result.scale[2] / (double)COMPASS_FIT_ONE, result.error, result.buckets);
+            } else {
+                printf("%4d samples: no fit yet\n", i + 1);
+            }
+        }
+    }
+
+    if (!fitted) {
+        printf("FAIL: no fit from %d samples\n", SAMPLES);
+        return 1;
+    }
+    // The fit can only find the scales relative to each other.
+    double mean_scale = (scale[0] + scale[1] + scale[2]) / 3;
+    for (int a = 0; a < 3; a++) {
+        double expected = scale[a] / mean_scale;
+        double found = result.scale[a] / (double)COMPASS_FIT_ONE;
+        int ok = fabs(result.centre[a] - centre[a]) <= 3 && fabs(found / expected - 1) <= 0.02;
+        printf("%s: axis %d centre %d, expected %.0f; scale %.3f, expected %.3f\n",
+               ok ? "OK" : "FAIL", a, result.centre[a], centre[a], found, expected);
+        failures += !ok;
+    }
+    return failures != 0;
+}
@@ -0,0 +1,85 @@
+"""
+Compile the built-in tunes in microbitmusictunes.c into tables of
+(period, duration) events, so that music.play() does not need to parse
+their note strings when it plays them.
+
+The note parsing here must match compile_note() in microbitmusic.cpp.
+
+Usage: makemusictunes.py source/microbit/microbitmusictunes.c > inc/genhdr/musictunes.generated.h
+"""
+
+from __future__ import print_function
+
+import re
+import sys
+
+DEFAULT_OCTAVE = 4
+DEFAULT_DURATION = 4
+
+# Periods of the octave ascending from middle C, from A->B then C->G
+PERIODS_US = [2273, 2025, 3822, 3405, 3034, 2863, 2551]
+# A#, -, C#, D#, -, F#, G#
+PERIODS_SHARPS_US = [2145, 0, 3608, 3214, 0, 2703, 2408]
+
+ESCAPES = {'colon': ':', 'hash': '#'}
+
+
+def qstr_to_note(ident):
+    return re.sub(r'_(colon|hash)_', lambda m: ESCAPES[m.group(1)], ident)
+
+
+def compile_note(note, state):
+    '''Return (period_us, duration) for a note string, where a period of 0 is a rest.
+    `state` is [octave, duration] carried over from the previous note.'''
+    note_index = (ord(note[0]) & 0x1f) - 1
+    octave = 0
+    sharp = False
+    pos = 1
+    if pos < len(note) and note[pos] in '#b':
+        if note[pos] == 'b':
+            note_index = 6 if note_index == 0 else note_index - 1
+            if note_index == 1:
+                octave -= 1
+        sharp = True
+        pos += 1
+    if pos < len(note) and note[pos] != ':':
+        state[0] = ord(note[pos]) & 0xf
+        pos += 1
+    octave += state[0]
+    if pos < len(note) and note[pos] == ':':
+        pos += 1
+        if pos < len(note):
+            state[1] = ord(note[pos]) & 0xf
+            pos += 1
+            if pos < len(note):
+                state[1] = state[1] * 10 + (ord(note[pos]) & 0xf)
+    octave -= 4
+    if note_index < 0 or note_index >= len(PERIODS_US):
+        return 0, state[1]
+    period = (PERIODS_SHARPS_US if sharp else PERIODS_US)[note_index]
+    period = period >> octave if octave >= 0 else period << -octave
+    return min(period, 0xffff), state[1]
+
+
+def do_work(infile):
+    with open(infile, 'rt') as f:
+        source = f.read()
+    print('// This file was automatically generated by makemusictunes.py')
+    print('')
+    for match in re.finditer(r'^T\((\w+),(.*?)\);', source, re.M | re.S):
+        name = match.group(1)
+        notes = [qstr_to_note(ident) for ident in re.findall(r'N\((\w+)\)', match.group(2))]
+        state = [DEFAULT_OCTAVE, DEFAULT_DURATION]
+        events = ['{%d, %d}' % compile_note(note, state) for note in notes]
+        lines = []
+        line = ''
+        for event in events:
+            if len(line) + len(event) > 70:
+                lines.append(line.rstrip())
+                line = ''
+            line += event + ', '
+        lines.append(line.rstrip(', '))
+        print('MUSIC_TUNE(%s,\n    %s)' % (name, '\n    '.join(lines)))
+
+if __name__ == "__main__":
+    do_work(sys.argv[1])
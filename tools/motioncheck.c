@@ -0,0 +1,87 @@
+/*
+ * Host check for the accelerometer motion features in source/lib/motion.c.
+ *
+ * Feeds synthetic signals sampled every 20ms through a 50 sample window,
+ * and checks the features against what each signal should give: a 2Hz,
+ * 400mg walk for 10s, the board at rest with +/-20mg of noise, and a 10Hz
+ * vibration whose peaks are too close together to be steps. Build and run
+ * on the host with:
+ *
+ *   cc -O2 -Iinc tools/motioncheck.c source/lib/motion.c -lm -o motioncheck && ./motioncheck
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lib/motion.h"
+
+#define WINDOW 50
+#define THRESHOLD 200
+#define PERIOD_MS 20
+#define SAMPLES 500 // 10s
+
+static int failures;
+
+static void check(const char *signal, const char *feature, long value, long low, long high) {
+    int ok = value >= low && value <= high;
+    printf("%s: %s: %s is %ld, expected %ld to %ld\n", ok ? "OK" : "FAIL", signal, feature, value, low, high);
+    failures += !ok;
+}
+
+static int noise(void) {
+    return rand() % 41 - 20;
+}
+
+typedef int (*signal_t)(double t);
+
+static int walk(double t) {
+    return 1000 + (int)(400 * sin(2 * M_PI * 2 * t)) + noise();
+}
+
+static int rest(double t) {
+    (void)t;
+    return 1000 + noise();
+}
+
+static int vibration(double t) {
+    return 1000 + (int)(300 * sin(2 * M_PI * 10 * t + 0.3));
+}
+
+static motion_t *run(signal_t signal) {
+    static motion_t *m;
+    if (m == NULL) {
+        m = malloc(sizeof(motion_t) + WINDOW * sizeof(uint16_t));
+    }
+    motion_init(m, WINDOW, THRESHOLD);
+    for (uint32_t i = 0, ms = 0; i < SAMPLES; i++, ms += PERIOD_MS) {
+        // The board is tilted a little, so the magnitude isn't just z.
+        motion_update(m, 30, -20, signal(ms / 1000.0), ms);
+    }
+    return m;
+}
+
+int main(void) {
+    srand(1);
+
+    motion_t *m = run(walk);
+    check("walk", "steps", m->steps, 20, 20);
+    check("walk", "crossing rate", motion_crossing_rate(m, PERIOD_MS), 4, 4);
+    check("walk", "mean", motion_mean(m), 980, 1020);
+    // A sine of amplitude A has a variance of A^2/2.
+    check("walk", "variance", motion_variance(m), 400 * 400 / 2 * 9 / 10, 400 * 400 / 2 * 11 / 10);
+
+    m = run(rest);
+    check("rest", "mean", motion_mean(m), 995, 1005);
+    check("rest", "variance", motion_variance(m), 0, 20 * 20);
+    check("rest", "peaks", m->peaks, 0, 0);
+    check("rest", "steps", m->steps, 0, 0);
+
+    m = run(vibration);
+    check("vibration", "peaks", m->peaks, 100, 100);
+    check("vibration", "crossing rate", motion_crossing_rate(m, PERIOD_MS), 20, 20);
+    // At most one step every MOTION_MIN_STEP_MS.
+    check("vibration", "steps", m->steps, 0, SAMPLES * PERIOD_MS / MOTION_MIN_STEP_MS);
+
+    return failures != 0;
+}
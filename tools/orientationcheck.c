@@ -0,0 +1,132 @@
+/*
+ * Host check for the integer orientation in source/lib/orientation.c.
+ *
+ * Rotates gravity and a magnetic field dipping down towards north through
+ * a grid of headings, pitches and rolls, turns them into the device's axes,
+ * and checks the angles and quaternion that orientation_update() works out
+ * against the rotation they came from. The angles must be within half a
+ * degree, and each component of the quaternion within 32/16384. Build and
+ * run on the host with:
+ *
+ *   cc -O2 -Iinc tools/orientationcheck.c source/lib/orientation.c -lm -o orientationcheck && ./orientationcheck
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lib/orientation.h"
+
+#define MAX_ANGLE_ERROR 5 // tenths of a degree
+#define MAX_QUATERNION_ERROR 32
+
+static void multiply(double a[3][3], double b[3][3], double out[3][3]) {
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            out[i][j] = 0;
+            for (int k = 0; k < 3; k++) {
+                out[i][j] += a[i][k] * b[k][j];
+            }
+        }
+    }
+}
+
+// The difference between two angles in tenths of a degree, from 0 to 1800.
+static int angle_error(int found, int expected) {
+    int error = (found - expected) % 3600;
+    if (error > 1800) {
+        error -= 3600;
+    } else if (error < -1800) {
+        error += 3600;
+    }
+    return abs(error);
+}
+
+int main(void) {
+    const double degree = M_PI / 180;
+    // North, east, down, in milli-g and in the compass's units.
+    const double gravity[3] = { 0, 0, 1000 };
+    const double field[3] = { 200, 0, 450 };
+    // The device's axes in terms of forward, right and down: forward is -y,
+    // right is -x and down is -z. This is its own inverse.
+    const double device[3][3] = { { 0, -1, 0 }, { -1, 0, 0 }, { 0, 0, -1 } };
+    int worst_heading = 0, worst_pitch = 0, worst_roll = 0, worst_quaternion = 0;
+    int failures = 0;
+
+    for (int yaw = -170; yaw <= 180; yaw += 37) {
+        for (int pitch = -80; pitch <= 80; pitch += 20) {
+            for (int roll = -170; roll <= 180; roll += 35) {
+                double cy = cos(yaw * degree), sy = sin(yaw * degree);
+                double cp = cos(pitch * degree), sp = sin(pitch * degree);
+                double cr = cos(roll * degree), sr = sin(roll * degree);
+                double rz[3][3] = { { cy, -sy, 0 }, { sy, cy, 0 }, { 0, 0, 1 } };
+                double ry[3][3] = { { cp, 0, sp }, { 0, 1, 0 }, { -sp, 0, cp } };
+                double rx[3][3] = { { 1, 0, 0 }, { 0, cr, -sr }, { 0, sr, cr } };
+                // c rotates the body's axes to north, east, down.
+                double t[3][3], c[3][3];
+                multiply(rz, ry, t);
+                multiply(t, rx, c);
+
+                double body_gravity[3], body_field[3];
+                for (int i = 0; i < 3; i++) {
+                    body_gravity[i] = body_field[i] = 0;
+                    for (int k = 0; k < 3; k++) {
+                        body_gravity[i] += c[k][i] * gravity[k];
+                        body_field[i] += c[k][i] * field[k];
+                    }
+                }
+                int accel[3], compass[3];
+                for (int i = 0; i < 3; i++) {
+                    double a = 0, m = 0;
+                    for (int k = 0; k < 3; k++) {
+                        a += device[i][k] * body_gravity[k];
+                        m += device[i][k] * body_field[k];
+                    }
+                    accel[i] = (int)lround(a);
+                    compass[i] = (int)lround(m);
+                }
+
+                orientation_t o;
+                memset(&o, 0, sizeof(o));
+                orientation_update(&o, accel, compass);
+
+                int heading_error = angle_error(o.heading, yaw * ORIENTATION_DEGREE);
+                int pitch_error = angle_error(o.pitch, pitch * ORIENTATION_DEGREE);
+                int roll_error = angle_error(o.roll, roll * ORIENTATION_DEGREE);
+
+                double q[4] = {
+                    sqrt(fmax(0, 1 + c[0][0] + c[1][1] + c[2][2])) / 2,
+                    copysign(sqrt(fmax(0, 1 + c[0][0] - c[1][1] - c[2][2])) / 2, c[2][1] - c[1][2]),
+                    copysign(sqrt(fmax(0, 1 - c[0][0] + c[1][1] - c[2][2])) / 2, c[0][2] - c[2][0]),
+                    copysign(sqrt(fmax(0, 1 - c[0][0] - c[1][1] + c[2][2])) / 2, c[1][0] - c[0][1]),
+                };
+                // q and -q are the same rotation.
+                int error = 0, negated_error = 0;
+                for (int i = 0; i < 4; i++) {
+                    int expected = (int)lround(q[i] * ORIENTATION_ONE);
+                    int e = abs(o.quaternion[i] - expected);
+                    int n = abs(o.quaternion[i] + expected);
+                    error = e > error ? e : error;
+                    negated_error = n > negated_error ? n : negated_error;
+                }
+                int quaternion_error = error < negated_error ? error : negated_error;
+
+                if (heading_error > MAX_ANGLE_ERROR || pitch_error > MAX_ANGLE_ERROR ||
+                    roll_error > MAX_ANGLE_ERROR || quaternion_error > MAX_QUATERNION_ERROR) {
+                    printf("FAIL: yaw %d pitch %d roll %d gives %d %d %d, quaternion %d %d %d %d\n",
+                           yaw, pitch, roll, o.heading, o.pitch, o.roll,
+                           o.quaternion[0], o.quaternion[1], o.quaternion[2], o.quaternion[3]);
+                    failures++;
+                }
+                worst_heading = heading_error > worst_heading ? heading_error : worst_heading;
+                worst_pitch = pitch_error > worst_pitch ? pitch_error : worst_pitch;
+                worst_roll = roll_error > worst_roll ? roll_error : worst_roll;
+                worst_quaternion = quaternion_error > worst_quaternion ? quaternion_error : worst_quaternion;
+            }
+        }
+    }
+    printf("%s: worst errors in tenths of a degree: heading %d, pitch %d, roll %d; quaternion %d/%d\n",
+           failures ? "FAIL" : "OK", worst_heading, worst_pitch, worst_roll, worst_quaternion, ORIENTATION_ONE);
+    return failures != 0;
+}
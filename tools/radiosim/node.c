@@ -0,0 +1,56 @@
+/*
+ * One simulated device: the radio driver compiled with its external symbols
+ * renamed after SIM_NODE, so that several copies can be linked together.
+ */
+
+#include "radiosim.h"
+
+#define SIM_NAME2(n, name) node ## n ## _ ## name
+#define SIM_NAME(n, name) SIM_NAME2(n, name)
+
+#define radio_buffer_size   SIM_NAME(SIM_NODE, radio_buffer_size)
+#define radio_init          SIM_NAME(SIM_NODE, radio_init)
+#define radio_deinit        SIM_NAME(SIM_NODE, radio_deinit)
+#define radio_set_config    SIM_NAME(SIM_NODE, radio_set_config)
+#define radio_send          SIM_NAME(SIM_NODE, radio_send)
+#define radio_flush_tx      SIM_NAME(SIM_NODE, radio_flush_tx)
+#define radio_peek          SIM_NAME(SIM_NODE, radio_peek)
+#define radio_pop           SIM_NAME(SIM_NODE, radio_pop)
+#define radio_large_max_len SIM_NAME(SIM_NODE, radio_large_max_len)
+#define radio_send_large    SIM_NAME(SIM_NODE, radio_send_large)
+#define radio_peek_large    SIM_NAME(SIM_NODE, radio_peek_large)
+#define radio_pop_large     SIM_NAME(SIM_NODE, radio_pop_large)
+#define radio_send_reliable SIM_NAME(SIM_NODE, radio_send_reliable)
+#define radio_tdma_tick     SIM_NAME(SIM_NODE, radio_tdma_tick)
+#define radio_tdma_synced   SIM_NAME(SIM_NODE, radio_tdma_synced)
+#define radio_bench_flood   SIM_NAME(SIM_NODE, radio_bench_flood)
+#define radio_bench_sink    SIM_NAME(SIM_NODE, radio_bench_sink)
+#define radio_bench_ping    SIM_NAME(SIM_NODE, radio_bench_ping)
+#define radio_bench_echo    SIM_NAME(SIM_NODE, radio_bench_echo)
+#define radio_stats         SIM_NAME(SIM_NODE, radio_stats)
+#define RADIO_IRQHandler    SIM_NAME(SIM_NODE, RADIO_IRQHandler)
+
+#include "lib/radio.c"
+
+const sim_radio_api_t SIM_NAME(SIM_NODE, api) = {
+    .buffer_size = radio_buffer_size,
+    .init = radio_init,
+    .deinit = radio_deinit,
+    .set_config = radio_set_config,
+    .send = radio_send,
+    .flush_tx = radio_flush_tx,
+    .peek = radio_peek,
+    .pop = radio_pop,
+    .send_large = radio_send_large,
+    .peek_large = radio_peek_large,
+    .pop_large = radio_pop_large,
+    .send_reliable = radio_send_reliable,
+    .tdma_tick = radio_tdma_tick,
+    .tdma_synced = radio_tdma_synced,
+    .bench_flood = radio_bench_flood,
+    .bench_sink = radio_bench_sink,
+    .bench_ping = radio_bench_ping,
+    .bench_echo = radio_bench_echo,
+    .irq_handler = RADIO_IRQHandler,
+    .stats = &radio_stats,
+};
@@ -0,0 +1,21 @@
+/*
+ * Stands in for the nRF51 device header when source/lib/radio.c is compiled
+ * for the simulator, pointing its peripherals at node SIM_NODE's registers.
+ */
+#ifndef RADIOSIM_NRF_H
+#define RADIOSIM_NRF_H
+
+#include "radiosim.h"
+
+#define NRF_RADIO (&sim_nodes[SIM_NODE].radio)
+#define NRF_CLOCK (&sim_nodes[SIM_NODE].clock)
+#define NRF_RNG (&sim_nodes[SIM_NODE].rng)
+
+#define NVIC_EnableIRQ(irq) (sim_nodes[SIM_NODE].irq_enabled = true)
+#define NVIC_DisableIRQ(irq) (sim_nodes[SIM_NODE].irq_enabled = false)
+#define NVIC_ClearPendingIRQ(irq) ((void)0)
+
+#define __WFI() sim_step()
+#define RADIO_WAIT_FOR(event) while ((event) == 0) sim_step()
+
+#endif // RADIOSIM_NRF_H
@@ -0,0 +1,928 @@
+/*
+ * Host simulation of micro:bits talking over the radio.
+ *
+ * Each node runs the real driver from source/lib/radio.c (see node.c) against
+ * a model of the nRF51 RADIO peripheral, in simulated time with a resolution
+ * of 1us. The model covers ramp-up and disable times, time on air at each
+ * data rate, address matching, collisions, injected packet loss and CRC
+ * errors, and delivering the RADIO interrupt. Each node's ticker calls
+ * radio_tdma_tick() every 6ms, out of step with the others. Each node's program runs as a
+ * coroutine that gives way to the others whenever the driver waits, and
+ * interrupts are only taken at those points.
+ *
+ * Runs the radio benchmarks between pairs of nodes, checks the results and
+ * statistics against what was sent, and prints the simulated throughput and
+ * latency. Build and run on the host (Linux) with:
+ *
+ *   for n in 0 1 2 3; do cc -O2 -fno-pie -Wno-pointer-to-int-cast -Wno-int-to-pointer-cast \
+ *      -DSIM_NODE=$n -Itools/radiosim -Iinc -Isource -c tools/radiosim/node.c \
+ *      -o radiosim-node$n.o; done
+ *   cc -O2 -fno-pie -no-pie -Itools/radiosim -Iinc tools/radiosim/radiosim.c \
+ *      radiosim-node?.o -o radiosim && ./radiosim
+ *
+ * The driver gives the radio the addresses of its buffers in 32 bit
+ * registers, so the program must not be position independent, and the
+ * buffers are allocated below 4GB.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+
+#include "radiosim.h"
+
+// Timings of the nRF51 radio, in microseconds.
+#define RAMP_UP_US          (130)
+#define DISABLE_US          (5)
+
+// Bits sent before the ADDRESS event: the preamble and a 5 byte address.
+#define ADDRESS_BITS        ((1 + 5) * 8)
+
+#define STACK_SIZE          (256 * 1024)
+
+#define TICK_US             (RADIO_TDMA_TICK_MS * 1000)
+
+enum {
+    STATE_DISABLED,
+    STATE_RXRU,
+    STATE_RXIDLE,
+    STATE_RX,
+    STATE_TXRU,
+    STATE_TXIDLE,
+    STATE_TX,
+    STATE_DISABLING,
+};
+
+typedef struct {
+    uint64_t address;       // prefix byte and base of the logical address
+    uint32_t frequency;
+    uint32_t mode;
+    uint64_t start;
+    uint64_t address_time;
+    uint64_t end;
+    uint8_t packet[256];    // length byte and payload
+} transmission_t;
+
+typedef struct {
+    int state;
+    uint64_t timer;         // when ramping up or disabling completes
+    uint32_t events;        // events raised in this step, for the shortcuts
+    // the packet being sent
+    transmission_t tx;
+    // the packet being received
+    int rx_from;            // the node sending it, or -1 when not locked on
+    uint64_t rx_address_time;
+    uint64_t rx_end;
+    uint32_t rx_match;
+    bool rx_corrupt;
+    uint8_t *rx_ptr;
+} radio_model_t;
+
+extern const sim_radio_api_t node0_api, node1_api, node2_api, node3_api;
+
+static const sim_radio_api_t *const node_api[SIM_MAX_NODES] = {
+    &node0_api, &node1_api, &node2_api, &node3_api,
+};
+
+sim_node_t sim_nodes[SIM_MAX_NODES];
+static radio_model_t models[SIM_MAX_NODES];
+static uint64_t now_us;
+uint32_t ticks;
+
+// Percentages of packets that a receiver misses entirely, or receives with a
+// bad CRC, on top of any that are lost to collisions.
+static unsigned int loss_percent;
+static unsigned int corrupt_percent;
+
+// The channels that packets have been sent on.
+static bool channel_used[101];
+
+static uint32_t random_state = 1;
+
+static unsigned int random_percent(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state % 100;
+}
+
+/*****************************************************************************/
+// The RADIO peripheral
+
+static uint32_t bit_us_x2(uint32_t mode) {
+    switch (mode) {
+        case RADIO_MODE_MODE_Nrf_2Mbit: return 1;
+        case RADIO_MODE_MODE_Nrf_250Kbit: return 8;
+        default: return 2;
+    }
+}
+
+static uint64_t logical_address(const NRF_RADIO_Type *radio, uint32_t index) {
+    uint32_t base = index == 0 ? radio->BASE0 : radio->BASE1;
+    uint32_t prefix = index < 4 ? radio->PREFIX0 >> (8 * index) : radio->PREFIX1 >> (8 * (index - 4));
+    return (uint64_t)(prefix & 0xff) << 32 | base;
+}
+
+static void raise_event(int n, uint32_t bit) {
+    NRF_RADIO_Type *radio = &sim_nodes[n].radio;
+    switch (bit) {
+        case RADIO_INTENSET_READY_Msk: radio->EVENTS_READY = 1; break;
+        case RADIO_INTENSET_ADDRESS_Msk: radio->EVENTS_ADDRESS = 1; break;
+        case RADIO_INTENSET_END_Msk: radio->EVENTS_END = 1; break;
+        case RADIO_INTENSET_DISABLED_Msk: radio->EVENTS_DISABLED = 1; break;
+    }
+    models[n].events |= bit;
+}
+
+static void abort_tx(int n) {
+    // anyone receiving the packet gets a truncated one
+    for (int i = 0; i < SIM_MAX_NODES; i++) {
+        if (models[i].rx_from == n) {
+            models[i].rx_corrupt = true;
+        }
+    }
+    models[n].tx.end = now_us;
+}
+
+static void task_start(int n) {
+    NRF_RADIO_Type *radio = &sim_nodes[n].radio;
+    radio_model_t *model = &models[n];
+    if (model->state == STATE_RXIDLE) {
+        model->state = STATE_RX;
+        model->rx_from = -1;
+        model->rx_ptr = (uint8_t*)(uintptr_t)radio->PACKETPTR;
+    } else if (model->state == STATE_TXIDLE) {
+        transmission_t *tx = &model->tx;
+        const uint8_t *packet = (const uint8_t*)(uintptr_t)radio->PACKETPTR;
+        uint32_t max_len = radio->PCNF1 & 0xff;
+        uint32_t len = packet[0] < max_len ? packet[0] : max_len;
+        memcpy(tx->packet, packet, 1 + len);
+        tx->address = logical_address(radio, radio->TXADDRESS);
+        tx->frequency = radio->FREQUENCY;
+        channel_used[tx->frequency] = true;
+        tx->mode = radio->MODE;
+        tx->start = now_us;
+        tx->address_time = now_us + ADDRESS_BITS * bit_us_x2(tx->mode) / 2;
+        tx->end = now_us + (ADDRESS_BITS + (1 + len + 2) * 8) * bit_us_x2(tx->mode) / 2;
+        model->state = STATE_TX;
+    }
+}
+
+static void task_disable(int n) {
+    radio_model_t *model = &models[n];
+    if (model->state == STATE_TX) {
+        abort_tx(n);
+    }
+    model->rx_from = -1;
+    model->state = STATE_DISABLING;
+    model->timer = now_us + DISABLE_US;
+}
+
+static void do_tasks(int n) {
+    NRF_RADIO_Type *radio = &sim_nodes[n].radio;
+    NRF_CLOCK_Type *clock = &sim_nodes[n].clock;
+    NRF_RNG_Type *rng = &sim_nodes[n].rng;
+    radio_model_t *model = &models[n];
+
+    if (clock->TASKS_HFCLKSTART) {
+        clock->TASKS_HFCLKSTART = 0;
+        clock->EVENTS_HFCLKSTARTED = 1;
+    }
+    if (rng->TASKS_START) {
+        rng->TASKS_START = 0;
+        rng->VALUE = rand() & 0xff;
+        rng->EVENTS_VALRDY = 1;
+    }
+    rng->TASKS_STOP = 0;
+    if (radio->INTENCLR) {
+        radio->INTENSET &= ~radio->INTENCLR;
+        radio->INTENCLR = 0;
+    }
+    if (radio->TASKS_DISABLE) {
+        radio->TASKS_DISABLE = 0;
+        task_disable(n);
+    }
+    if (radio->TASKS_RXEN) {
+        radio->TASKS_RXEN = 0;
+        if (model->state == STATE_DISABLED) {
+            model->state = STATE_RXRU;
+            model->timer = now_us + RAMP_UP_US;
+        }
+    }
+    if (radio->TASKS_TXEN) {
+        radio->TASKS_TXEN = 0;
+        if (model->state == STATE_DISABLED) {
+            model->state = STATE_TXRU;
+            model->timer = now_us + RAMP_UP_US;
+        }
+    }
+    if (radio->TASKS_START) {
+        radio->TASKS_START = 0;
+        task_start(n);
+    }
+    radio->TASKS_STOP = 0;
+    radio->TASKS_RSSISTART = 0;
+    radio->TASKS_RSSISTOP = 0;
+}
+
+// Lock receivers on to packets whose preamble starts now, and corrupt any
+// packets being received that another transmission on the channel overlaps.
+static void do_air(void) {
+    for (int r = 0; r < SIM_MAX_NODES; r++) {
+        NRF_RADIO_Type *radio = &sim_nodes[r].radio;
+        radio_model_t *rx = &models[r];
+        if (rx->state != STATE_RX) {
+            continue;
+        }
+        for (int t = 0; t < SIM_MAX_NODES; t++) {
+            const transmission_t *tx = &models[t].tx;
+            if (t == r || models[t].state != STATE_TX || tx->frequency != radio->FREQUENCY) {
+                continue;
+            }
+            if (rx->rx_from >= 0) {
+                if (tx->start == now_us && rx->rx_from != t) {
+                    rx->rx_corrupt = true;
+                }
+                continue;
+            }
+            if (tx->start != now_us || tx->mode != radio->MODE) {
+                continue;
+            }
+            for (uint32_t i = 0; i < 8; i++) {
+                if ((radio->RXADDRESSES & (1 << i)) && logical_address(radio, i) == tx->address) {
+                    if (random_percent() < loss_percent) {
+                        break;
+                    }
+                    rx->rx_from = t;
+                    rx->rx_match = i;
+                    rx->rx_address_time = tx->address_time;
+                    rx->rx_end = tx->end;
+                    rx->rx_corrupt = random_percent() < corrupt_percent;
+                    break;
+                }
+            }
+            if (rx->rx_from >= 0) {
+                // a packet already on the air garbles this one
+                for (int o = 0; o < SIM_MAX_NODES; o++) {
+                    if (o != r && o != t && models[o].state == STATE_TX
+                        && models[o].tx.frequency == radio->FREQUENCY) {
+                        rx->rx_corrupt = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void do_timers(int n) {
+    NRF_RADIO_Type *radio = &sim_nodes[n].radio;
+    radio_model_t *model = &models[n];
+
+    switch (model->state) {
+        case STATE_RXRU:
+        case STATE_TXRU:
+            if (now_us >= model->timer) {
+                model->state = model->state == STATE_RXRU ? STATE_RXIDLE : STATE_TXIDLE;
+                raise_event(n, RADIO_INTENSET_READY_Msk);
+                if (radio->SHORTS & RADIO_SHORTS_READY_START_Msk) {
+                    task_start(n);
+                }
+            }
+            break;
+        case STATE_DISABLING:
+            if (now_us >= model->timer) {
+                model->state = STATE_DISABLED;
+                raise_event(n, RADIO_INTENSET_DISABLED_Msk);
+            }
+            break;
+        case STATE_TX:
+            if (now_us == model->tx.address_time) {
+                raise_event(n, RADIO_INTENSET_ADDRESS_Msk);
+            }
+            if (now_us == model->tx.end) {
+                model->state = STATE_TXIDLE;
+                raise_event(n, RADIO_INTENSET_END_Msk);
+            }
+            break;
+        case STATE_RX:
+            if (model->rx_from < 0) {
+                break;
+            }
+            if (now_us == model->rx_address_time) {
+                raise_event(n, RADIO_INTENSET_ADDRESS_Msk);
+                if (radio->SHORTS & RADIO_SHORTS_ADDRESS_RSSISTART_Msk) {
+                    // signal strength falls off with the distance between node numbers
+                    int distance = abs(n - model->rx_from);
+                    radio->RSSISAMPLE = 40 + 10 * distance;
+                }
+            }
+            if (now_us == model->rx_end) {
+                const uint8_t *packet = models[model->rx_from].tx.packet;
+                uint32_t max_len = radio->PCNF1 & 0xff;
+                model->rx_ptr[0] = packet[0];
+                memcpy(model->rx_ptr + 1, packet + 1, packet[0] < max_len ? packet[0] : max_len);
+                radio->CRCSTATUS = !model->rx_corrupt;
+                radio->RXMATCH = model->rx_match;
+                model->rx_from = -1;
+                model->state = STATE_RXIDLE;
+                raise_event(n, RADIO_INTENSET_END_Msk);
+            }
+            break;
+    }
+
+    if (model->events & RADIO_INTENSET_END_Msk) {
+        if (radio->SHORTS & RADIO_SHORTS_END_DISABLE_Msk) {
+            task_disable(n);
+        } else if (radio->SHORTS & RADIO_SHORTS_END_START_Msk) {
+            task_start(n);
+        }
+    }
+    if (model->events & RADIO_INTENSET_DISABLED_Msk) {
+        if (radio->SHORTS & RADIO_SHORTS_DISABLED_TXEN_Msk) {
+            model->state = STATE_TXRU;
+            model->timer = now_us + RAMP_UP_US;
+        } else if (radio->SHORTS & RADIO_SHORTS_DISABLED_RXEN_Msk) {
+            model->state = STATE_RXRU;
+            model->timer = now_us + RAMP_UP_US;
+        }
+    }
+    model->events = 0;
+}
+
+static bool irq_pending(int n) {
+    const NRF_RADIO_Type *radio = &sim_nodes[n].radio;
+    uint32_t events = (radio->EVENTS_READY ? RADIO_INTENSET_READY_Msk : 0)
+        | (radio->EVENTS_ADDRESS ? RADIO_INTENSET_ADDRESS_Msk : 0)
+        | (radio->EVENTS_END ? RADIO_INTENSET_END_Msk : 0)
+        | (radio->EVENTS_DISABLED ? RADIO_INTENSET_DISABLED_Msk : 0);
+    return (events & radio->INTENSET) != 0;
+}
+
+static void advance(void) {
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        do_tasks(n);
+    }
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        do_timers(n);
+    }
+    do_air();
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        if (sim_nodes[n].irq_enabled && irq_pending(n)) {
+            node_api[n]->irq_handler();
+        }
+    }
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        if ((now_us + n * TICK_US / 3 + 500) % TICK_US == 0) {
+            node_api[n]->tdma_tick();
+        }
+    }
+    now_us += 1;
+    ticks = now_us / 1000;
+}
+
+/*****************************************************************************/
+// Running the nodes' programs
+
+typedef void (*program_t)(int node);
+
+static ucontext_t scheduler_context;
+static ucontext_t node_context[SIM_MAX_NODES];
+static program_t node_program[SIM_MAX_NODES];
+static bool node_running[SIM_MAX_NODES];
+static int current_node = -1;
+
+void sim_step(void) {
+    if (current_node < 0) {
+        advance();
+    } else {
+        swapcontext(&node_context[current_node], &scheduler_context);
+    }
+}
+
+static void run_program(int n) {
+    node_program[n](n);
+    node_running[n] = false;
+}
+
+// Run a program on each of the nodes, until they have all returned.
+static void run(program_t programs[SIM_MAX_NODES]) {
+    static char stacks[SIM_MAX_NODES][STACK_SIZE];
+    int running = 0;
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        node_program[n] = programs[n];
+        node_running[n] = programs[n] != NULL;
+        if (node_running[n]) {
+            getcontext(&node_context[n]);
+            node_context[n].uc_stack.ss_sp = stacks[n];
+            node_context[n].uc_stack.ss_size = STACK_SIZE;
+            node_context[n].uc_link = &scheduler_context;
+            makecontext(&node_context[n], (void (*)(void))run_program, 1, n);
+            running++;
+        }
+    }
+    while (running > 0) {
+        for (int n = 0; n < SIM_MAX_NODES; n++) {
+            if (node_running[n]) {
+                current_node = n;
+                swapcontext(&scheduler_context, &node_context[n]);
+                current_node = -1;
+                if (!node_running[n]) {
+                    running--;
+                }
+            }
+        }
+        advance();
+    }
+}
+
+/*****************************************************************************/
+// Scenarios
+
+static radio_state_t config;
+static uint8_t *buffers[SIM_MAX_NODES];
+static radio_bench_result_t results[SIM_MAX_NODES];
+static uint32_t bench_count;
+
+static bool poll(void) {
+    sim_step();
+    return true;
+}
+
+#define NODE_ID(n) (0x100 + (n))
+
+static void start_radio_with(int n, radio_state_t *state) {
+    const sim_radio_api_t *api = node_api[n];
+    api->deinit();
+    memset(api->stats, 0, sizeof(radio_stats_t));
+    state->node_id = NODE_ID(n);
+    api->init(state, buffers[n]);
+}
+
+static void start_radio(int n) {
+    radio_state_t state = config;
+    start_radio_with(n, &state);
+}
+
+static void program_flood(int n) {
+    start_radio(n);
+    // give the receiver time to start listening
+    while (ticks < 1) {
+        sim_step();
+    }
+    node_api[n]->bench_flood(bench_count, config.max_payload, &results[n], poll);
+}
+
+static void program_sink(int n) {
+    start_radio(n);
+    node_api[n]->bench_sink(50, &results[n], poll);
+}
+
+static void program_ping(int n) {
+    start_radio(n);
+    while (ticks < 1) {
+        sim_step();
+    }
+    node_api[n]->bench_ping(bench_count, config.max_payload, 20, &results[n], poll);
+}
+
+static void program_echo(int n) {
+    start_radio(n);
+    node_api[n]->bench_echo(200, &results[n], poll);
+}
+
+static const char *const rate_names[] = {"1Mbit", "2Mbit", "250Kbit"};
+
+static void print_stats(int n) {
+    const radio_stats_t *s = node_api[n]->stats;
+    printf("    node %d: received %u, crc_errors %u, rx_dropped %u, rx_lost %u, sent %u, tx_time %ums\n",
+        n, s->received, s->crc_errors, s->rx_dropped, s->rx_lost, s->sent, s->tx_time_us / 1000);
+}
+
+static int failures;
+
+static void check(bool ok, const char *what) {
+    if (!ok) {
+        printf("    FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static void run_nodes(program_t a, program_t b, program_t c, program_t d) {
+    program_t programs[SIM_MAX_NODES] = {a, b, c, d};
+    now_us = 0;
+    memset(models, 0, sizeof(models));
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        models[n].rx_from = -1;
+    }
+    ticks = 0;
+    run(programs);
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        if (programs[n] != NULL) {
+            node_api[n]->deinit();
+        }
+    }
+}
+
+static void run_pair(program_t a, program_t b) {
+    run_nodes(a, b, NULL, NULL);
+}
+
+static void flood(uint32_t data_rate, uint32_t count) {
+    config.data_rate = data_rate;
+    bench_count = count;
+    run_pair(program_flood, program_sink);
+    const radio_bench_result_t *sent = &results[0];
+    const radio_bench_result_t *got = &results[1];
+    const radio_stats_t *tx_stats = node_api[0]->stats;
+    const radio_stats_t *rx_stats = node_api[1]->stats;
+    printf("flood %s, %u%% loss, %u%% bad CRC: %u/%u packets in %ums, %u lost, %.0f packets/s\n",
+        rate_names[data_rate], loss_percent, corrupt_percent, got->received, sent->packets,
+        got->time_ms, got->lost, got->time_ms ? got->received * 1000.0 / got->time_ms : 0.0);
+    print_stats(0);
+    print_stats(1);
+    check(sent->packets == count && tx_stats->sent == count, "all packets sent");
+    check(rx_stats->received == got->received + rx_stats->rx_dropped, "received count");
+    if (loss_percent == 0 && corrupt_percent == 0) {
+        check(got->received == count && got->lost == 0, "no packets lost");
+        check(rx_stats->crc_errors == 0, "no CRC errors");
+    } else {
+        // only packets lost at the very end go unnoticed by the sink
+        check(got->received + got->lost <= count && got->received + got->lost + 5 >= count, "lost count");
+        check(corrupt_percent == 0 || rx_stats->crc_errors > 0, "CRC errors counted");
+    }
+}
+
+static void ping(uint32_t data_rate, uint32_t count) {
+    config.data_rate = data_rate;
+    bench_count = count;
+    run_pair(program_ping, program_echo);
+    const radio_bench_result_t *res = &results[0];
+    printf("ping %s, %u%% loss, %u%% bad CRC: %u/%u replies in %ums, %.2fms round trip\n",
+        rate_names[data_rate], loss_percent, corrupt_percent, res->received, res->packets,
+        res->time_ms, res->received ? (double)res->rtt_ms / res->received : 0.0);
+    print_stats(0);
+    print_stats(1);
+    check(res->packets == count, "all pings sent");
+    check(results[1].packets <= count, "pings echoed");
+    if (loss_percent == 0 && corrupt_percent == 0) {
+        check(res->received == count && results[1].packets == count, "all replies received");
+    } else {
+        check(res->received < count, "some replies lost");
+    }
+}
+
+static uint8_t large_message[30000];
+static size_t large_received_len;
+static uint32_t large_time_ms;
+
+static void program_send_large(int n) {
+    start_radio(n);
+    while (ticks < 1) {
+        sim_step();
+    }
+    node_api[n]->send_large(large_message, sizeof(large_message));
+    node_api[n]->flush_tx();
+}
+
+static void program_receive_large(int n) {
+    start_radio(n);
+    large_received_len = 0;
+    const uint8_t *buf = NULL;
+    while (buf == NULL && ticks < 5000) {
+        sim_step();
+        buf = node_api[n]->peek_large(&large_received_len);
+    }
+    large_time_ms = ticks - 1;
+    if (buf == NULL) {
+        large_received_len = 0;
+    } else if (memcmp(buf, large_message, sizeof(large_message)) != 0) {
+        large_received_len = 1;
+    }
+    node_api[n]->pop_large();
+}
+
+static void large(uint32_t data_rate) {
+    for (size_t i = 0; i < sizeof(large_message); i++) {
+        large_message[i] = i * 7 + (i >> 8);
+    }
+    config.data_rate = data_rate;
+    config.max_payload = 251;
+    config.large_len = sizeof(large_message);
+    run_pair(program_send_large, program_receive_large);
+    config.max_payload = 32;
+    config.large_len = 0;
+    printf("large %s, %u%% loss, %u%% bad CRC: ", rate_names[data_rate], loss_percent, corrupt_percent);
+    if (large_received_len == sizeof(large_message)) {
+        printf("%u bytes in %ums, %.0f bytes/s\n", (unsigned)sizeof(large_message),
+            large_time_ms, sizeof(large_message) * 1000.0 / large_time_ms);
+    } else {
+        printf("not received\n");
+    }
+    print_stats(0);
+    print_stats(1);
+    if (loss_percent == 0 && corrupt_percent == 0) {
+        check(large_received_len == sizeof(large_message), "large message received intact");
+    } else {
+        // a lost fragment loses the whole message
+        check(large_received_len == 0, "incomplete large message discarded");
+    }
+}
+
+// Nodes 0 and 2 send reliable packets to node 1.
+static uint32_t reliable_acked[SIM_MAX_NODES];
+static uint32_t reliable_delivered[SIM_MAX_NODES];
+static uint32_t reliable_out_of_order;
+static uint32_t reliable_time_ms;
+
+static void program_send_reliable(int n) {
+    start_radio(n);
+    while (ticks < 1) {
+        sim_step();
+    }
+    reliable_acked[n] = 0;
+    for (uint32_t seq = 0; seq < bench_count; seq++) {
+        uint8_t packet[8] = {n, seq, seq >> 8, seq >> 16, seq >> 24};
+        reliable_acked[n] += node_api[n]->send_reliable(NODE_ID(1), packet, sizeof(packet));
+    }
+}
+
+static void program_receive_reliable(int n) {
+    start_radio(n);
+    uint32_t next_seq[SIM_MAX_NODES] = {0};
+    memset(reliable_delivered, 0, sizeof(reliable_delivered));
+    reliable_out_of_order = 0;
+    uint32_t last = 0;
+    while (ticks - last < 2000) {
+        sim_step();
+        radio_packet_t *packet = node_api[n]->peek();
+        if (packet == NULL) {
+            continue;
+        }
+        uint8_t from = packet->data[0];
+        uint32_t seq = packet->data[1] | packet->data[2] << 8 | packet->data[3] << 16 | (uint32_t)packet->data[4] << 24;
+        if (packet->len == 8 && from < SIM_MAX_NODES) {
+            // repeats are dropped, and packets that were given up on are skipped
+            if (seq < next_seq[from]) {
+                reliable_out_of_order++;
+            } else {
+                next_seq[from] = seq + 1;
+                reliable_delivered[from]++;
+            }
+        }
+        last = ticks;
+        reliable_time_ms = ticks;
+        node_api[n]->pop();
+    }
+}
+
+static void reliable(int senders, uint32_t count) {
+    bench_count = count;
+    config.reliable = true;
+    run_nodes(program_send_reliable, program_receive_reliable, senders > 1 ? program_send_reliable : NULL, NULL);
+    config.reliable = false;
+    printf("reliable, %d sender%s, %u%% loss, %u%% bad CRC: %u packets in %ums\n", senders, senders > 1 ? "s" : "",
+        loss_percent, corrupt_percent, count * senders, reliable_time_ms);
+    for (int n = 0; n < 3; n += 2) {
+        if (n == 0 || senders > 1) {
+            printf("    node %d: %u/%u acknowledged, %u delivered, %u retries, %u failed\n",
+                n, reliable_acked[n], count, reliable_delivered[n],
+                node_api[n]->stats->tx_retries, node_api[n]->stats->tx_failed);
+            check(reliable_acked[n] + node_api[n]->stats->tx_failed == count, "every packet acknowledged or failed");
+            check(reliable_delivered[n] >= reliable_acked[n], "every acknowledged packet delivered");
+            if (loss_percent == 0 && corrupt_percent == 0) {
+                check(reliable_acked[n] == count, "no packets failed");
+            }
+        }
+    }
+    check(reliable_out_of_order == 0, "no repeated or out of order packets");
+}
+
+// Node 1 listens to three groups, and nodes 0 and 2 send to one of them and
+// to another group.
+static const uint8_t listen_groups[] = {5, 9, 200};
+static uint32_t group_received[RADIO_MAX_ADDRESSES];
+
+static void program_send_group(int n) {
+    radio_state_t state = config;
+    state.prefix[0] = n == 0 ? 9 : 7;
+    start_radio_with(n, &state);
+    for (uint32_t i = 0; i < bench_count; i++) {
+        // take turns, so that the packets don't collide
+        while (ticks < 2 * i + 1 + n / 2) {
+            sim_step();
+        }
+        uint8_t packet[4] = {n, i};
+        node_api[n]->send(packet, sizeof(packet), NULL, 0);
+    }
+    node_api[n]->flush_tx();
+}
+
+static void program_receive_groups(int n) {
+    radio_state_t state = config;
+    memcpy(state.prefix, listen_groups, sizeof(listen_groups));
+    state.num_addresses = sizeof(listen_groups);
+    start_radio_with(n, &state);
+    memset(group_received, 0, sizeof(group_received));
+    while (ticks < 2 * bench_count + 50) {
+        sim_step();
+        radio_packet_t *packet = node_api[n]->peek();
+        if (packet != NULL) {
+            group_received[packet->match]++;
+            node_api[n]->pop();
+        }
+    }
+}
+
+static void addresses(uint32_t count) {
+    bench_count = count;
+    run_nodes(program_send_group, program_receive_groups, program_send_group, NULL);
+    printf("addresses: node 1 listening to groups 5, 9 and 200 received %u, %u and %u packets\n",
+        group_received[0], group_received[1], group_received[2]);
+    print_stats(0);
+    print_stats(1);
+    print_stats(2);
+    check(group_received[1] == count && group_received[0] == 0 && group_received[2] == 0,
+        "packets for group 9 received");
+    // group 7 is rejected by the radio, and never reaches the driver
+    check(node_api[1]->stats->received + node_api[1]->stats->crc_errors == count, "other groups ignored");
+}
+
+// Node 0 sends packets starting with every possible byte to node 1, which has
+// large messages and reliable mode on, and gets them all as they were sent.
+static uint32_t passed_through;
+
+static void program_send_any(int n) {
+    start_radio(n);
+    for (uint32_t i = 0; i < 256; i++) {
+        while (ticks < i + 1) {
+            sim_step();
+        }
+        uint8_t packet[RADIO_RELIABLE_HEADER_LEN] = {i, 1, 0x11, 1, 1, 1, 1, 1};
+        node_api[n]->send(packet, sizeof(packet), NULL, 0);
+    }
+    node_api[n]->flush_tx();
+}
+
+static void program_receive_any(int n) {
+    radio_state_t state = config;
+    state.reliable = true;
+    state.large_len = 1000;
+    start_radio_with(n, &state);
+    passed_through = 0;
+    while (ticks < 256 + 50) {
+        sim_step();
+        radio_packet_t *packet = node_api[n]->peek();
+        if (packet != NULL) {
+            if (packet->len == RADIO_RELIABLE_HEADER_LEN && packet->data[0] == passed_through) {
+                passed_through++;
+            }
+            node_api[n]->pop();
+        }
+    }
+}
+
+static void passthrough(void) {
+    run_pair(program_send_any, program_receive_any);
+    printf("passthrough: %u/256 packets received unchanged\n", passed_through);
+    print_stats(1);
+    check(passed_through == 256, "other packets passed through");
+}
+
+// All four nodes send to each other as fast as they can, with node 0 as the
+// TDMA coordinator, or without TDMA for comparison.
+static uint32_t mesh_received[SIM_MAX_NODES][SIM_MAX_NODES];
+static uint32_t mesh_time_ms;
+
+static void program_mesh(int n) {
+    radio_state_t state = config;
+    state.tdma_slot = n;
+    start_radio_with(n, &state);
+    const sim_radio_api_t *api = node_api[n];
+    memset(mesh_received[n], 0, sizeof(mesh_received[n]));
+    uint32_t sent = 0;
+    uint32_t last = 0;
+    while (sent < bench_count || ticks - last < 300) {
+        sim_step();
+        // sending may wait for our slot, so catch up with everything received
+        radio_packet_t *packet;
+        while ((packet = api->peek()) != NULL) {
+            if (packet->len == 4 && packet->data[0] < SIM_MAX_NODES) {
+                mesh_received[n][packet->data[0]]++;
+            }
+            api->pop();
+        }
+        if (sent < bench_count && ticks > (uint32_t)n && api->tdma_synced()) {
+            uint8_t data[4] = {n, sent, sent >> 8};
+            api->send(data, sizeof(data), NULL, 0);
+            if (++sent == bench_count) {
+                api->flush_tx();
+                if (ticks > mesh_time_ms) {
+                    mesh_time_ms = ticks;
+                }
+                last = ticks;
+            }
+        }
+    }
+}
+
+static void mesh(uint8_t tdma_slots, uint32_t count) {
+    bench_count = count;
+    radio_state_t saved = config;
+    config.queue_len = 200;
+    config.tx_queue_len = 8;
+    config.data_rate = RADIO_MODE_MODE_Nrf_1Mbit;
+    config.tdma_slots = tdma_slots;
+    config.slot_ticks = 3;
+    config.hops = 4;
+    mesh_time_ms = 0;
+    memset(channel_used, 0, sizeof(channel_used));
+    run_nodes(program_mesh, program_mesh, program_mesh, program_mesh);
+    config = saved;
+
+    uint32_t delivered = 0;
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        for (int m = 0; m < SIM_MAX_NODES; m++) {
+            delivered += mesh_received[n][m];
+        }
+    }
+    int channels = 0;
+    for (int i = 0; i <= 100; i++) {
+        channels += channel_used[i];
+    }
+    uint32_t expected = count * SIM_MAX_NODES * (SIM_MAX_NODES - 1);
+    printf("mesh of %d, %s, %u%% loss, %u%% bad CRC: %u/%u packets delivered in %ums on %d channel%s\n",
+        SIM_MAX_NODES, tdma_slots ? "TDMA" : "no TDMA", loss_percent, corrupt_percent,
+        delivered, expected, mesh_time_ms, channels, channels > 1 ? "s" : "");
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        print_stats(n);
+    }
+    if (tdma_slots == 0) {
+        return;
+    }
+    check(channels == 4, "hopped between 4 channels");
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        const radio_stats_t *s = node_api[n]->stats;
+        check(s->sent == count, "all packets sent");
+        check(s->beacons > 0, "beacons sent and received");
+        check(s->tx_dropped == 0, "never lost sync");
+        if (loss_percent == 0 && corrupt_percent == 0) {
+            check(s->crc_errors == 0 && s->rx_lost == 0 && s->rx_dropped == 0, "no collisions");
+        }
+    }
+    if (loss_percent == 0 && corrupt_percent == 0) {
+        check(delivered == expected, "all packets delivered");
+    }
+}
+
+int main(void) {
+    for (int n = 0; n < SIM_MAX_NODES; n++) {
+        buffers[n] = mmap(NULL, 64 * 1024, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+        if (buffers[n] == MAP_FAILED) {
+            perror("mmap");
+            return 1;
+        }
+    }
+
+    config.max_payload = 32;
+    config.queue_len = 3;
+    config.tx_queue_len = 2;
+    config.channel = 7;
+    config.power_dbm = 0;
+    config.base0 = 0x75626974;
+    config.num_addresses = 1;
+
+    ping(RADIO_MODE_MODE_Nrf_1Mbit, 200);
+    ping(RADIO_MODE_MODE_Nrf_2Mbit, 200);
+    ping(RADIO_MODE_MODE_Nrf_250Kbit, 200);
+    flood(RADIO_MODE_MODE_Nrf_1Mbit, 1000);
+    flood(RADIO_MODE_MODE_Nrf_2Mbit, 1000);
+    flood(RADIO_MODE_MODE_Nrf_250Kbit, 1000);
+    large(RADIO_MODE_MODE_Nrf_1Mbit);
+    large(RADIO_MODE_MODE_Nrf_2Mbit);
+    reliable(1, 500);
+    reliable(2, 500);
+    addresses(100);
+    passthrough();
+    mesh(0, 300);
+    mesh(SIM_MAX_NODES, 300);
+
+    loss_percent = 10;
+    corrupt_percent = 5;
+    ping(RADIO_MODE_MODE_Nrf_1Mbit, 200);
+    flood(RADIO_MODE_MODE_Nrf_1Mbit, 1000);
+    large(RADIO_MODE_MODE_Nrf_1Mbit);
+    reliable(1, 500);
+    reliable(2, 500);
+    mesh(SIM_MAX_NODES, 300);
+
+    loss_percent = 30;
+    corrupt_percent = 10;
+    reliable(2, 200);
+
+    printf("%s\n", failures ? "FAIL" : "OK");
+    return failures != 0;
+}
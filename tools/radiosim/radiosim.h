@@ -0,0 +1,123 @@
+/*
+ * A model of several nRF51 RADIO peripherals sharing the air, used to run the
+ * radio driver in source/lib/radio.c on the host. See radiosim.c.
+ */
+#ifndef RADIOSIM_H
+#define RADIOSIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "lib/radio.h"
+
+#define SIM_MAX_NODES 4
+
+#define RADIO_MODE_MODE_Nrf_1Mbit           (0)
+#define RADIO_MODE_MODE_Nrf_2Mbit           (1)
+#define RADIO_MODE_MODE_Nrf_250Kbit         (2)
+
+#define RADIO_SHORTS_READY_START_Msk        (1 << 0)
+#define RADIO_SHORTS_END_DISABLE_Msk        (1 << 1)
+#define RADIO_SHORTS_DISABLED_TXEN_Msk      (1 << 2)
+#define RADIO_SHORTS_DISABLED_RXEN_Msk      (1 << 3)
+#define RADIO_SHORTS_ADDRESS_RSSISTART_Msk  (1 << 4)
+#define RADIO_SHORTS_END_START_Msk          (1 << 5)
+
+#define RADIO_INTENSET_READY_Msk            (1 << 0)
+#define RADIO_INTENSET_ADDRESS_Msk          (1 << 1)
+#define RADIO_INTENSET_PAYLOAD_Msk          (1 << 2)
+#define RADIO_INTENSET_END_Msk              (1 << 3)
+#define RADIO_INTENSET_DISABLED_Msk         (1 << 4)
+
+#define RADIO_CRCCNF_LEN_Two                (2)
+
+typedef struct {
+    volatile uint32_t TASKS_TXEN;
+    volatile uint32_t TASKS_RXEN;
+    volatile uint32_t TASKS_START;
+    volatile uint32_t TASKS_STOP;
+    volatile uint32_t TASKS_DISABLE;
+    volatile uint32_t TASKS_RSSISTART;
+    volatile uint32_t TASKS_RSSISTOP;
+    volatile uint32_t EVENTS_READY;
+    volatile uint32_t EVENTS_ADDRESS;
+    volatile uint32_t EVENTS_PAYLOAD;
+    volatile uint32_t EVENTS_END;
+    volatile uint32_t EVENTS_DISABLED;
+    volatile uint32_t EVENTS_RSSIEND;
+    volatile uint32_t SHORTS;
+    volatile uint32_t INTENSET;
+    volatile uint32_t INTENCLR;
+    volatile uint32_t CRCSTATUS;
+    volatile uint32_t RXMATCH;
+    volatile uint32_t PACKETPTR;
+    volatile uint32_t FREQUENCY;
+    volatile uint32_t TXPOWER;
+    volatile uint32_t MODE;
+    volatile uint32_t PCNF0;
+    volatile uint32_t PCNF1;
+    volatile uint32_t BASE0;
+    volatile uint32_t BASE1;
+    volatile uint32_t PREFIX0;
+    volatile uint32_t PREFIX1;
+    volatile uint32_t TXADDRESS;
+    volatile uint32_t RXADDRESSES;
+    volatile uint32_t CRCCNF;
+    volatile uint32_t CRCPOLY;
+    volatile uint32_t CRCINIT;
+    volatile uint32_t RSSISAMPLE;
+    volatile uint32_t DATAWHITEIV;
+} NRF_RADIO_Type;
+
+typedef struct {
+    volatile uint32_t TASKS_HFCLKSTART;
+    volatile uint32_t EVENTS_HFCLKSTARTED;
+} NRF_CLOCK_Type;
+
+typedef struct {
+    volatile uint32_t TASKS_START;
+    volatile uint32_t TASKS_STOP;
+    volatile uint32_t EVENTS_VALRDY;
+    volatile uint32_t VALUE;
+} NRF_RNG_Type;
+
+// The driver's external symbols, which node.c renames for each node.
+typedef struct {
+    size_t (*buffer_size)(const radio_state_t *state);
+    void (*init)(const radio_state_t *state, uint8_t *buf);
+    void (*deinit)(void);
+    void (*set_config)(const radio_state_t *state);
+    void (*send)(const void *buf, size_t len, const void *buf2, size_t len2);
+    void (*flush_tx)(void);
+    radio_packet_t *(*peek)(void);
+    void (*pop)(void);
+    void (*send_large)(const void *buf, size_t len);
+    const uint8_t *(*peek_large)(size_t *len);
+    void (*pop_large)(void);
+    bool (*send_reliable)(uint16_t to, const void *buf, size_t len);
+    void (*tdma_tick)(void);
+    bool (*tdma_synced)(void);
+    void (*bench_flood)(uint32_t count, uint8_t len, radio_bench_result_t *result, bool (*poll)(void));
+    void (*bench_sink)(uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void));
+    void (*bench_ping)(uint32_t count, uint8_t len, uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void));
+    void (*bench_echo)(uint32_t timeout_ms, radio_bench_result_t *result, bool (*poll)(void));
+    void (*irq_handler)(void);
+    radio_stats_t *stats;
+} sim_radio_api_t;
+
+typedef struct {
+    NRF_RADIO_Type radio;
+    NRF_CLOCK_Type clock;
+    NRF_RNG_Type rng;
+    bool irq_enabled;
+} sim_node_t;
+
+extern sim_node_t sim_nodes[SIM_MAX_NODES];
+
+// The simulated time in milliseconds, shared by all the nodes.
+extern uint32_t ticks;
+
+// Let simulated time pass: called wherever the driver would wait.
+void sim_step(void);
+
+#endif // RADIOSIM_H
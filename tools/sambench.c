@@ -0,0 +1,134 @@
+/*
+ * Host benchmark for the SAM speech renderer in source/lib/sam.
+ *
+ * Checks that the renderer's output is bit-for-bit identical to that of the
+ * original renderer, and that no SAMRender() step outputs more than
+ * SAM_RENDER_STEP_MAX positions ahead, then measures how many output samples it produces per
+ * second. Build and run on the host with:
+ *
+ *   cc -O2 -Isource/lib/sam tools/sambench.c source/lib/sam/sam.c \
+ *      source/lib/sam/render.c source/lib/sam/reciter.c source/lib/sam/debug.c \
+ *      -o sambench && ./sambench
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "sam.h"
+#include "reciter.h"
+
+int debug = 0;
+
+static unsigned long sample_count;
+static unsigned int output_hash;
+static unsigned int output_pos;
+static unsigned int long_steps;
+
+/* Hash every (position, value) pair that SAM outputs. */
+void SamOutputByte(unsigned int pos, unsigned char b) {
+    sample_count++;
+    output_pos = pos;
+    output_hash = (output_hash ^ pos) * 16777619u;
+    output_hash = (output_hash ^ b) * 16777619u;
+}
+
+typedef struct _reference_t {
+    const char *text;
+    int sing;
+    unsigned long count;
+    unsigned int hash;
+} reference_t;
+
+/* Output of the original renderer. The renderer carries timing state from one
+ * utterance to the next, so these must be rendered in this order. */
+static const reference_t references[] = {
+    { "hello world", 0, 6440, 0xe2605a13 },
+    { "hello world", 1, 6440, 0xe41e0eb3 },
+    { "I am a little robot", 0, 10120, 0x206f42e5 },
+    { "I am a little robot", 1, 10120, 0x3efd0ea5 },
+    { "the quick brown fox jumps over the lazy dog", 0, 26432, 0xd6ee47bd },
+    { "the quick brown fox jumps over the lazy dog", 1, 26576, 0x861b5435 },
+    { "micro bit", 0, 5816, 0x4081376b },
+    { "micro bit", 1, 5816, 0x21c4eacb },
+    { "one two three four five six seven eight nine ten", 0, 30824, 0x98152f15 },
+    { "one two three four five six seven eight nine ten", 1, 30888, 0xa8ce9942 },
+};
+
+#define REFERENCE_COUNT (sizeof(references)/sizeof(references[0]))
+#define BENCHMARK_REPEATS 200
+
+static sam_memory sam;
+static reciter_memory reciter;
+
+static unsigned int translate(const char *text) {
+    size_t len = strlen(text);
+    memset(&reciter, 0, sizeof(reciter));
+    memcpy(reciter.input, text, len);
+    reciter.input[len] = '[';
+    TextToPhonemes(&reciter);
+    unsigned int n = 0;
+    while (n < 255 && (unsigned char)reciter.input[n] != 155) {
+        n++;
+    }
+    return n;
+}
+
+static int speak(const char *phonemes, unsigned int len, int sing) {
+    memset(&sam, 0, sizeof(sam));
+    sam.common.singmode = sing;
+    sam.common.pitch = DEFAULT_PITCH;
+    sam.common.speed = DEFAULT_SPEED;
+    sam.common.mouth = DEFAULT_MOUTH;
+    sam.common.throat = DEFAULT_THROAT;
+    SetInput(&sam, phonemes, len);
+    if (!SAMPrepare(&sam)) {
+        return 0;
+    }
+    output_pos = 0;
+    for (;;) {
+        unsigned int start = output_pos;
+        if (!SAMRender(&sam)) {
+            return 1;
+        }
+        if (output_pos - start > SAM_RENDER_STEP_MAX) {
+            long_steps++;
+        }
+    }
+}
+
+int main(void) {
+    int failures = 0;
+    for (unsigned int i = 0; i < REFERENCE_COUNT; i++) {
+        const reference_t *ref = &references[i];
+        unsigned int len = translate(ref->text);
+        sample_count = 0;
+        output_hash = 2166136261u;
+        if (!speak(reciter.input, len, ref->sing) ||
+            sample_count != ref->count || output_hash != ref->hash) {
+            printf("FAIL: \"%s\"%s: %lu samples, hash %08x\n", ref->text,
+                   ref->sing ? " (sing)" : "", sample_count, output_hash);
+            failures++;
+        }
+    }
+    printf("%s: output matches reference for %u of %u utterances\n",
+           failures ? "FAIL" : "OK", (unsigned)REFERENCE_COUNT - failures, (unsigned)REFERENCE_COUNT);
+    if (long_steps) {
+        printf("FAIL: %u render steps longer than SAM_RENDER_STEP_MAX\n", long_steps);
+        failures++;
+    }
+
+    unsigned long total = 0;
+    clock_t start = clock();
+    for (int r = 0; r < BENCHMARK_REPEATS; r++) {
+        for (unsigned int i = 0; i < REFERENCE_COUNT; i += 2) {
+            unsigned int len = translate(references[i].text);
+            sample_count = 0;
+            speak(reciter.input, len, 0);
+            total += sample_count;
+        }
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%lu samples in %.3fs: %.0f samples per second\n", total, seconds, total / seconds);
+    return failures != 0;
+}
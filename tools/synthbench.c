@@ -0,0 +1,159 @@
+/*
+ * Host benchmark for the music synthesizer in source/lib/synth.c.
+ *
+ * Plays four of the built-in tunes together as a four voice Synth. It first
+ * checks the output against a simple sample-at-a-time renderer (using square
+ * waves, which are easy to compute), then measures how long each AudioFrame
+ * (32 samples, 4.096ms of audio) takes to render. Build and run on the host
+ * with:
+ *
+ *   cc -O2 -Iinc tools/synthbench.c source/lib/synth.c -o synthbench && ./synthbench
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "lib/synth.h"
+
+#define MUSIC_TUNE(name, ...) \
+    static const synth_event_t tune_ ## name[] = {__VA_ARGS__};
+#include "genhdr/musictunes.generated.h"
+#undef MUSIC_TUNE
+
+#define FRAME_SIZE 32
+#define MS_PER_TICK 125 // the default tempo
+#define BENCHMARK_REPEATS 200
+
+typedef struct _tune_t {
+    const synth_event_t *events;
+    unsigned int len;
+} tune_t;
+
+#define TUNE(name) { tune_ ## name, sizeof(tune_ ## name)/sizeof(synth_event_t) }
+
+static const tune_t tunes[SYNTH_MAX_VOICES] = {
+    TUNE(nyan), TUNE(prelude), TUNE(entertainer), TUNE(ode),
+};
+
+static const uint8_t volumes[SYNTH_MAX_VOICES] = { 255, 200, 100, 60 };
+
+static synth_voice_t voices[SYNTH_MAX_VOICES];
+
+static void start(int mixed_waveforms) {
+    for (int i = 0; i < SYNTH_MAX_VOICES; i++) {
+        synth_voice_start(&voices[i], tunes[i].events, tunes[i].len);
+        voices[i].waveform = mixed_waveforms ? i % SYNTH_WAVE_COUNT : SYNTH_WAVE_SQUARE;
+        voices[i].volume = volumes[i];
+    }
+}
+
+/* The reference renderer produces one sample at a time, from square and
+ * sawtooth waves that are simple to compute from the phase. */
+typedef struct _reference_voice_t {
+    unsigned int index;
+    unsigned long remaining;
+    int articulate;
+    int finished;
+    uint32_t phase;
+    uint32_t phase_inc;
+} reference_voice_t;
+
+static reference_voice_t reference[SYNTH_MAX_VOICES];
+
+static int reference_wave(int waveform, uint32_t phase) {
+    if (waveform == SYNTH_WAVE_SQUARE) {
+        return phase < 0x80000000u ? 127 : -127;
+    }
+    return -128 + 8 * (int)(phase >> 27);
+}
+
+static int reference_voice_sample(int v) {
+    reference_voice_t *voice = &reference[v];
+    while (voice->remaining == 0) {
+        if (voice->articulate) {
+            voice->articulate = 0;
+            voice->phase_inc = 0;
+            voice->remaining = SYNTH_ARTICULATION_MS * 125 / 16;
+        } else if (voice->index < tunes[v].len) {
+            const synth_event_t *event = &tunes[v].events[voice->index++];
+            long gap_ms = (long)MS_PER_TICK * event->ticks - SYNTH_ARTICULATION_MS;
+            if (gap_ms < SYNTH_ARTICULATION_MS) {
+                gap_ms = SYNTH_ARTICULATION_MS;
+            }
+            voice->remaining = gap_ms * 125 / 16;
+            voice->articulate = 1;
+            // 2**32 / (period_us * 1e-6 * 7812.5)
+            voice->phase_inc = event->period_us < 256 ? 0 : (uint32_t)((1ull << 39) / event->period_us) & ~0xffu;
+        } else {
+            voice->finished = 1;
+            return 0;
+        }
+    }
+    voice->remaining--;
+    if (voice->phase_inc == 0) {
+        return 0;
+    }
+    int sample = reference_wave(voices[v].waveform, voice->phase) * volumes[v];
+    voice->phase += voice->phase_inc;
+    return sample;
+}
+
+static int check_reference(void) {
+    uint8_t frame[FRAME_SIZE];
+    unsigned long frames = 0;
+    unsigned int playing;
+    start(0);
+    for (int v = 0; v < SYNTH_MAX_VOICES; v++) {
+        reference[v] = (reference_voice_t){0};
+        voices[v].waveform = v & 1 ? SYNTH_WAVE_SAWTOOTH : SYNTH_WAVE_SQUARE;
+    }
+    do {
+        playing = synth_render(voices, SYNTH_MAX_VOICES, MS_PER_TICK, frame, FRAME_SIZE);
+        for (int i = 0; i < FRAME_SIZE; i++) {
+            int mix = 0;
+            for (int v = 0; v < SYNTH_MAX_VOICES; v++) {
+                mix += reference_voice_sample(v);
+            }
+            mix = 128 + (mix >> 9);
+            mix = mix < 0 ? 0 : mix > 255 ? 255 : mix;
+            if (frame[i] != mix) {
+                printf("FAIL: sample %lu is %d, expected %d\n", frames * FRAME_SIZE + i, frame[i], mix);
+                return 1;
+            }
+        }
+        frames++;
+    } while (playing);
+    for (int v = 0; v < SYNTH_MAX_VOICES; v++) {
+        if (!reference[v].finished) {
+            printf("FAIL: voice %d finished early\n", v);
+            return 1;
+        }
+    }
+    printf("OK: %lu frames match the reference\n", frames);
+    return 0;
+}
+
+/* Render until every voice has finished, returning the number of frames. */
+static unsigned long play(void) {
+    uint8_t frame[FRAME_SIZE];
+    unsigned long frames = 0;
+    start(1);
+    while (synth_render(voices, SYNTH_MAX_VOICES, MS_PER_TICK, frame, FRAME_SIZE)) {
+        frames++;
+    }
+    return frames + 1;
+}
+
+int main(void) {
+    int failed = check_reference();
+
+    unsigned long total = 0;
+    clock_t start_time = clock();
+    for (int r = 0; r < BENCHMARK_REPEATS; r++) {
+        total += play();
+    }
+    double seconds = (double)(clock() - start_time) / CLOCKS_PER_SEC;
+    printf("%lu frames of %d voices in %.3fs: %.0fns per frame (each frame is 4096000ns of audio)\n",
+           total, SYNTH_MAX_VOICES, seconds, seconds * 1e9 / total);
+    return failed;
+}